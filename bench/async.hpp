@@ -0,0 +1,48 @@
+#ifndef BENCH_ASYNC_HPP
+#define BENCH_ASYNC_HPP
+
+#include "../include/async.hpp"
+#include "common.hpp"
+
+// Four independent products and the sum of their results, one after the other on the calling thread.
+template <typename T> void BM_Async_products_sequential(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    T total{};
+    for(int i{}; i < 4; ++i)
+    {
+      total += (mat * mat).sum();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  setCounters(state, static_cast<double>(4 * n * n * sizeof(T)), 8.0 * static_cast<double>(n * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Async_products_sequential, float)->RangeMultiplier(2)->Range(128, 512)->UseRealTime();
+
+// The same graph on the shared pool: the products overlap, the latency is one product plus one sum.
+template <typename T> void BM_Async_products_graph(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    std::vector<tinyTools::task<T>> sums{};
+    for(int i{}; i < 4; ++i)
+    {
+      sums.push_back(tinyTools::asyncSum(tinyTools::asyncMultiply(std::cref(mat), std::cref(mat))));
+    }
+    T total{};
+    for(auto const& sum : sums)
+    {
+      total += sum.get();
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  setCounters(state, static_cast<double>(4 * n * n * sizeof(T)), 8.0 * static_cast<double>(n * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Async_products_graph, float)->RangeMultiplier(2)->Range(128, 512)->UseRealTime();
+
+#endif /* BENCH_ASYNC_HPP */
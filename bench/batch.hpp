@@ -0,0 +1,64 @@
+#ifndef BENCH_BATCH_HPP
+#define BENCH_BATCH_HPP
+
+#include "../include/matrix_batch.hpp"
+#include "common.hpp"
+
+// 2^16 products of n x n matrices, one batch per layout and a loop over separate matrices as the baseline.
+template <typename T> auto makeBatch(std::size_t count, std::size_t n, tinyTools::BatchLayout layout) -> tinyTools::matrix_batch<T>
+{
+  tinyTools::matrix_batch<T> ret{count, n, n, layout};
+  for(std::size_t b{}; b < count; ++b)
+  {
+    ret.set(b, makeMatrix<T>(n, n));
+  }
+  return ret;
+}
+
+template <typename T, tinyTools::BatchLayout layout> void BM_Batch_multiply(benchmark::State& state)
+{
+  constexpr std::size_t count{1U << 16U};
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const batch = makeBatch<T>(count, n, layout);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(batch * batch);
+  }
+  setCounters(state, static_cast<double>(3 * count * n * n * sizeof(T)), 2.0 * static_cast<double>(count * n * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Batch_multiply, float, tinyTools::BatchLayout::INTERLEAVED)->DenseRange(2, 8, 2);
+BENCHMARK_TEMPLATE(BM_Batch_multiply, float, tinyTools::BatchLayout::STRIDED)->DenseRange(2, 8, 2);
+
+template <typename T> void BM_Batch_multiply_separate(benchmark::State& state)
+{
+  constexpr std::size_t count{1U << 16U};
+  auto const n = static_cast<std::size_t>(state.range(0));
+  std::vector<tinyTools::matrix<T>> const matrices(count, makeMatrix<T>(n, n));
+  std::vector<tinyTools::matrix<T>> results(count, tinyTools::matrix<T>{n, n, T{}});
+  for(auto _ : state)
+  {
+    for(std::size_t b{}; b < count; ++b)
+    {
+      results[ b ] = matrices[ b ] * matrices[ b ];
+    }
+    benchmark::DoNotOptimize(results.data());
+  }
+  setCounters(state, static_cast<double>(3 * count * n * n * sizeof(T)), 2.0 * static_cast<double>(count * n * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Batch_multiply_separate, float)->DenseRange(2, 8, 2);
+
+template <typename T, tinyTools::BatchLayout layout> void BM_Batch_sum(benchmark::State& state)
+{
+  constexpr std::size_t count{1U << 16U};
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const batch = makeBatch<T>(count, n, layout);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(batch.sum(tinyTools::Direction::COLUMNS));
+  }
+  setCounters(state, static_cast<double>((count * n * n + count * n) * sizeof(T)), static_cast<double>(count * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Batch_sum, float, tinyTools::BatchLayout::INTERLEAVED)->DenseRange(2, 8, 2);
+BENCHMARK_TEMPLATE(BM_Batch_sum, float, tinyTools::BatchLayout::STRIDED)->DenseRange(2, 8, 2);
+
+#endif /* BENCH_BATCH_HPP */
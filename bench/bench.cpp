@@ -0,0 +1,45 @@
+#include "benchmark/benchmark.h"
+
+// Run: ./bench --benchmark_out=bench.json --benchmark_out_format=json (or the bench-json target).
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Ctors.
+#include "ctors.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Operators.
+#include "operators.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Methods.
+#include "methods.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// I/O.
+#include "io.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Sparse matrices.
+#include "sparse.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Linear algebra.
+#include "linalg.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Storage order.
+#include "layout.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Asynchronous operations.
+#include "async.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Batched small matrices.
+#include "batch.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Strassen-Winograd products.
+#include "strassen.hpp"
+
+BENCHMARK_MAIN();
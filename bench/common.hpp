@@ -0,0 +1,41 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "../include/matrix.hpp"
+
+// Deterministic, small values so integer products never overflow.
+template <typename T> auto makeMatrix(std::size_t rows, std::size_t cols) -> tinyTools::matrix<T>
+{
+  std::vector<T> data(rows * cols);
+  for(std::size_t i{}; i < data.size(); ++i)
+  {
+    data[ i ] = static_cast<T>((i * 7 + 3) % 13);
+  }
+  return tinyTools::matrix<T>{rows, cols, std::move(data)};
+}
+
+// Reports bytes/s (read + written) and FLOP/s for the whole run.
+inline void setCounters(benchmark::State& state, double bytesPerIter, double flopsPerIter)
+{
+  auto const iterations = static_cast<double>(state.iterations());
+  state.counters[ "bytes/s" ] = benchmark::Counter(bytesPerIter * iterations, benchmark::Counter::kIsRate, benchmark::Counter::kIs1024);
+  if(flopsPerIter > 0)
+  {
+    state.counters[ "FLOP/s" ] = benchmark::Counter(flopsPerIter * iterations, benchmark::Counter::kIsRate);
+  }
+}
+
+// Square sizes for element-wise operations and smaller ones for O(n^3) kernels.
+#define ELEMENTWISE_SIZES RangeMultiplier(4)->Range(64, 4096)
+#define GEMM_SIZES RangeMultiplier(2)->Range(64, 1024)
+
+#define BENCH_ALL_TYPES(func, sizes) \
+  BENCHMARK_TEMPLATE(func, int)->sizes; \
+  BENCHMARK_TEMPLATE(func, float)->sizes; \
+  BENCHMARK_TEMPLATE(func, double)->sizes
+
+#endif /* BENCH_COMMON_HPP */
@@ -0,0 +1,71 @@
+#ifndef BENCH_CTORS_HPP
+#define BENCH_CTORS_HPP
+
+#include "common.hpp"
+
+template <typename T> void BM_Ctor_Init_Val(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for(auto _ : state)
+  {
+    tinyTools::matrix<T> mat{n, n, T{1}};
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Ctor_Init_Val, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Ctor_Copy(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const src = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto copy{src};
+    benchmark::DoNotOptimize(copy);
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Ctor_Copy, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Ctor_Identity(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for(auto _ : state)
+  {
+    auto iden = tinyTools::matrix<T>::identity(n);
+    benchmark::DoNotOptimize(iden);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Ctor_Identity, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Random(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::matrix<T>::random(n);
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Random, ELEMENTWISE_SIZES);
+BENCHMARK_TEMPLATE(BM_Random, std::int64_t)->ELEMENTWISE_SIZES;
+
+// Same-shape temporaries in a loop: system allocator vs. the aligned allocator vs. the thread-local pool.
+template <typename T, typename Allocator> void BM_Ctor_Temporaries(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::matrix<T, Allocator>::ones(n) + T{1};
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), 0);
+}
+BENCHMARK_TEMPLATE(BM_Ctor_Temporaries, float, std::allocator<float>)->ELEMENTWISE_SIZES;
+BENCHMARK_TEMPLATE(BM_Ctor_Temporaries, float, tinyTools::aligned_allocator<float>)->ELEMENTWISE_SIZES;
+BENCHMARK_TEMPLATE(BM_Ctor_Temporaries, float, tinyTools::pool_allocator<float>)->ELEMENTWISE_SIZES;
+
+#endif /* BENCH_CTORS_HPP */
@@ -0,0 +1,56 @@
+#ifndef BENCH_IO_HPP
+#define BENCH_IO_HPP
+
+#include <sstream>
+
+#include "../include/text_io.hpp"
+#include "common.hpp"
+
+template <typename T> void BM_IO_ostream(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    std::ostringstream os{};
+    os << mat;
+    benchmark::DoNotOptimize(os.str().data());
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCHMARK_TEMPLATE(BM_IO_ostream, int)->Arg(256)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_IO_ostream, double)->Arg(256)->Arg(1024);
+
+template <typename T> void BM_IO_writeText(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    std::ostringstream os{};
+    tinyTools::writeText(os, mat);
+    benchmark::DoNotOptimize(os.str().data());
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCHMARK_TEMPLATE(BM_IO_writeText, int)->Arg(256)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_IO_writeText, double)->Arg(256)->Arg(1024);
+
+template <typename T> void BM_IO_readText(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  std::ostringstream os{};
+  tinyTools::writeText(os, makeMatrix<T>(n, n));
+  auto const text = os.str();
+  for(auto _ : state)
+  {
+    std::istringstream is{text};
+    auto mat = tinyTools::readText<T>(is);
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(text.size()), 0);
+}
+BENCHMARK_TEMPLATE(BM_IO_readText, int)->Arg(256)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_IO_readText, double)->Arg(256)->Arg(1024);
+
+#endif /* BENCH_IO_HPP */
@@ -0,0 +1,58 @@
+#ifndef BENCH_LAYOUT_HPP
+#define BENCH_LAYOUT_HPP
+
+#include "common.hpp"
+
+template <typename T> using col_major = tinyTools::matrix<T, std::allocator<T>, tinyTools::Layout::COL_MAJOR>;
+
+template <typename T> auto makeColMajor(std::size_t rows, std::size_t cols) -> col_major<T>
+{
+  auto const mat = makeMatrix<T>(rows, cols);
+  return col_major<T>{rows, cols, std::vector<T>{mat.begin(), mat.end()}};
+}
+
+// Column sums of column-major storage: one contiguous fold per column.
+template <typename T> void BM_Layout_sum_cols(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeColMajor<T>(n, n);
+  for(auto _ : state)
+  {
+    auto sum = mat.sum(tinyTools::Direction::COLUMNS);
+    benchmark::DoNotOptimize(sum);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Layout_sum_cols, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Layout_multiply(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const lhm = makeColMajor<T>(n, n);
+  auto const rhm = makeColMajor<T>(n, n);
+  for(auto _ : state)
+  {
+    auto res = lhm * rhm;
+    benchmark::DoNotOptimize(res);
+  }
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), 2.0 * static_cast<double>(n * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Layout_multiply, float)->GEMM_SIZES;
+BENCHMARK_TEMPLATE(BM_Layout_multiply, double)->GEMM_SIZES;
+
+// Element-wise expression on column-major operands, evaluated column by column.
+template <typename T> void BM_Layout_expression(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const lhm = makeColMajor<T>(n, n);
+  auto const rhm = makeColMajor<T>(n, n);
+  for(auto _ : state)
+  {
+    col_major<T> res = lhm + rhm * T{2};
+    benchmark::DoNotOptimize(res);
+  }
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), 2.0 * static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Layout_expression, ELEMENTWISE_SIZES);
+
+#endif /* BENCH_LAYOUT_HPP */
@@ -0,0 +1,61 @@
+#ifndef BENCH_LINALG_HPP
+#define BENCH_LINALG_HPP
+
+#include "../include/linalg.hpp"
+#include "../include/random.hpp"
+#include "common.hpp"
+
+// n x n system with one right-hand side: LU (2/3 n^3) plus the two triangular solves.
+template <typename T> void BM_Linalg_solve(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  tinyTools::rng gen{1};
+  auto const mat = tinyTools::matrix<T>::randn(n, n, gen);
+  auto const rhs = tinyTools::matrix<T>::randn(n, 1, gen);
+  for(auto _ : state)
+  {
+    auto res = tinyTools::solve(mat, rhs);
+    benchmark::DoNotOptimize(res);
+  }
+  auto const size = static_cast<double>(n);
+  setCounters(state, size * size * sizeof(T), 2.0 / 3.0 * size * size * size);
+}
+BENCHMARK_TEMPLATE(BM_Linalg_solve, float)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Linalg_solve, double)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+
+template <typename T> void BM_Linalg_chol(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  tinyTools::rng gen{2};
+  auto spd = tinyTools::matrix<T>::randn(n, n, gen);
+  spd = tinyTools::matrix<T>{spd.t()} * spd;
+  for(std::size_t i{}; i < n; ++i)
+  {
+    spd(i, i) += static_cast<T>(n);
+  }
+  for(auto _ : state)
+  {
+    auto res = tinyTools::chol(spd);
+    benchmark::DoNotOptimize(res);
+  }
+  auto const size = static_cast<double>(n);
+  setCounters(state, size * size * sizeof(T), size * size * size / 3.0);
+}
+BENCHMARK_TEMPLATE(BM_Linalg_chol, double)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+
+template <typename T> void BM_Linalg_qr(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  tinyTools::rng gen{3};
+  auto const mat = tinyTools::matrix<T>::randn(n, n, gen);
+  for(auto _ : state)
+  {
+    auto res = tinyTools::qr(mat);
+    benchmark::DoNotOptimize(res);
+  }
+  auto const size = static_cast<double>(n);
+  setCounters(state, size * size * sizeof(T), 4.0 / 3.0 * size * size * size);
+}
+BENCHMARK_TEMPLATE(BM_Linalg_qr, double)->RangeMultiplier(2)->Range(512, 2048)->Unit(benchmark::kMillisecond);
+
+#endif /* BENCH_LINALG_HPP */
@@ -0,0 +1,159 @@
+#ifndef BENCH_METHODS_HPP
+#define BENCH_METHODS_HPP
+
+#include "common.hpp"
+
+template <typename T> void BM_Method_sum_cols(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto sum = mat.sum(tinyTools::Direction::COLUMNS);
+    benchmark::DoNotOptimize(sum);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Method_sum_cols, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_sum_rows(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto sum = mat.sum(tinyTools::Direction::ROWS);
+    benchmark::DoNotOptimize(sum);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Method_sum_rows, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_sum_all(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto sum = mat.sum();
+    benchmark::DoNotOptimize(sum);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Method_sum_all, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_max_cols(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto max = mat.max(tinyTools::Direction::COLUMNS);
+    benchmark::DoNotOptimize(max);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Method_max_cols, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_transpose(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n + 1);
+  for(auto _ : state)
+  {
+    auto matT = mat.transpose();
+    benchmark::DoNotOptimize(matT);
+  }
+  setCounters(state, static_cast<double>(2 * n * (n + 1) * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Method_transpose, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_transpose_inplace(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    mat.transposeInPlace();
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Method_transpose_inplace, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_cat(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const matA = makeMatrix<T>(n, n);
+  auto const matB = makeMatrix<T>(n, n);
+  auto const matC = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::cat(tinyTools::Direction::ROWS, matA, matB, matC);
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(6 * n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Method_cat, RangeMultiplier(4)->Range(64, 1024));
+
+// Many narrow blocks side by side, each output row gathers one row run per block.
+template <typename T> void BM_Method_cat_blocks(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  std::vector<tinyTools::matrix<T>> blocks{};
+  for(std::size_t i{}; i < 16; ++i)
+  {
+    blocks.push_back(makeMatrix<T>(n, n / 16));
+  }
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::cat(tinyTools::Direction::COLUMNS, blocks);
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Method_cat_blocks, RangeMultiplier(4)->Range(64, 1024));
+
+template <typename T> void BM_Method_random_legacy(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::matrix<T>::random(n, n, T{100});
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCHMARK_TEMPLATE(BM_Method_random_legacy, int)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Method_random_legacy, float)->Arg(1024)->Arg(4096);
+
+template <typename T> void BM_Method_random_uniform(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  tinyTools::rng gen{42};
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::matrix<T>::random(n, n, T{}, T{100}, gen);
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCHMARK_TEMPLATE(BM_Method_random_uniform, int)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Method_random_uniform, float)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Method_random_uniform, double)->Arg(1024)->Arg(4096);
+
+template <typename T> void BM_Method_randn(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  tinyTools::rng gen{42};
+  for(auto _ : state)
+  {
+    auto mat = tinyTools::matrix<T>::randn(n, n, gen);
+    benchmark::DoNotOptimize(mat);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCHMARK_TEMPLATE(BM_Method_randn, float)->Arg(1024)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Method_randn, double)->Arg(1024)->Arg(4096);
+
+#endif /* BENCH_METHODS_HPP */
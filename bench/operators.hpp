@@ -0,0 +1,197 @@
+#ifndef BENCH_OPERATORS_HPP
+#define BENCH_OPERATORS_HPP
+
+#include <sstream>
+#include <thread>
+
+#include "common.hpp"
+
+template <typename T> void BM_Op_multiply(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const matA = makeMatrix<T>(n, n);
+  auto const matB = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto matC = matA * matB;
+    benchmark::DoNotOptimize(matC);
+  }
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), 2.0 * static_cast<double>(n * n * n));
+}
+BENCH_ALL_TYPES(BM_Op_multiply, GEMM_SIZES);
+
+// Scaling curve: same product on 1, 2, 4, ... threads up to the hardware thread count (compare FLOP/s per row).
+template <typename T> void BM_Op_multiply_threads(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const threads = static_cast<std::size_t>(state.range(1));
+  auto const matA = makeMatrix<T>(n, n);
+  auto const matB = makeMatrix<T>(n, n);
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setThreadCount(threads);
+  for(auto _ : state)
+  {
+    auto matC = matA * matB;
+    benchmark::DoNotOptimize(matC);
+  }
+  tinyTools::setThreadCount(0);
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  state.counters[ "threads" ] = static_cast<double>(threads);
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), 2.0 * static_cast<double>(n * n * n));
+}
+
+inline void threadScalingArgs(benchmark::internal::Benchmark* bench)
+{
+  auto const hardware = std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+  for(std::int64_t const n : {1024, 2048})
+  {
+    for(std::int64_t threads{1}; threads < hardware; threads *= 2)
+    {
+      bench->Args({n, threads});
+    }
+    bench->Args({n, hardware});
+  }
+  bench->UseRealTime();
+}
+BENCHMARK_TEMPLATE(BM_Op_multiply_threads, float)->Apply(threadScalingArgs);
+BENCHMARK_TEMPLATE(BM_Op_multiply_threads, double)->Apply(threadScalingArgs);
+
+template <typename T> void BM_Op_plus_eq_mat(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto mat = makeMatrix<T>(n, n);
+  auto const mat2 = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    mat += mat2;
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Op_plus_eq_mat, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_minus_eq_scalar(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    mat -= T{1};
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Op_minus_eq_scalar, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_expression(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const matA = makeMatrix<T>(n, n);
+  auto const matB = makeMatrix<T>(n, n);
+  auto const matC = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    tinyTools::matrix<T> matD = matA + matB - matC * T{2};
+    benchmark::DoNotOptimize(matD);
+  }
+  setCounters(state, static_cast<double>(4 * n * n * sizeof(T)), static_cast<double>(3 * n * n));
+}
+BENCH_ALL_TYPES(BM_Op_expression, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_multiply_inplace(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto mat = makeMatrix<T>(n, n);
+  auto const mat2 = tinyTools::matrix<T>::ones(n);
+  for(auto _ : state)
+  {
+    mat.multiply(mat2);
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Method_multiply_inplace, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_less(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const matA = makeMatrix<T>(n, n);
+  tinyTools::matrix<T> const matB = makeMatrix<T>(n, n) + T{1};
+  for(auto _ : state)
+  {
+    auto mask = matA < matB;
+    benchmark::DoNotOptimize(mask);
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Op_less, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_lt_mask(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const matA = makeMatrix<T>(n, n);
+  tinyTools::matrix<T> const matB = makeMatrix<T>(n, n) + T{1};
+  for(auto _ : state)
+  {
+    auto mask = matA.lt(matB);
+    benchmark::DoNotOptimize(mask);
+  }
+  setCounters(state, static_cast<double>(2 * n * n * sizeof(T)), static_cast<double>(n * n));
+}
+BENCH_ALL_TYPES(BM_Op_lt_mask, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_submatrix(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    auto sub = mat(n / 4, n / 4, n / 2, n / 2);
+    benchmark::DoNotOptimize(sub);
+  }
+}
+BENCH_ALL_TYPES(BM_Op_submatrix, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_submatrix_copy(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    tinyTools::matrix<T> sub = mat(n / 4, n / 4, n / 2, n / 2);
+    benchmark::DoNotOptimize(sub);
+  }
+  setCounters(state, static_cast<double>(2 * (n / 2) * (n / 2) * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Op_submatrix_copy, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Method_getRow_getCol(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    tinyTools::matrix<T> row = mat.getRow(n / 2);
+    tinyTools::matrix<T> col = mat.getCol(n / 2);
+    benchmark::DoNotOptimize(row);
+    benchmark::DoNotOptimize(col);
+  }
+  setCounters(state, static_cast<double>(4 * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Method_getRow_getCol, ELEMENTWISE_SIZES);
+
+template <typename T> void BM_Op_ostream(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeMatrix<T>(n, n);
+  for(auto _ : state)
+  {
+    std::ostringstream os{};
+    os << mat;
+    benchmark::DoNotOptimize(os);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 0);
+}
+BENCH_ALL_TYPES(BM_Op_ostream, RangeMultiplier(4)->Range(64, 1024));
+
+#endif /* BENCH_OPERATORS_HPP */
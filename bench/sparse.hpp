@@ -0,0 +1,81 @@
+#ifndef BENCH_SPARSE_HPP
+#define BENCH_SPARSE_HPP
+
+#include "../include/sparse_matrix.hpp"
+#include "common.hpp"
+
+// n x n with about 1% nonzeros at deterministic positions.
+template <typename T> auto makeSparse(std::size_t n, tinyTools::SparseFormat format) -> tinyTools::sparse_matrix<T>
+{
+  std::vector<tinyTools::sparse_entry<T>> entries{};
+  for(std::size_t i{}; i < n * n / 100; ++i)
+  {
+    entries.push_back({(i * 7919) % n, (i * 104729 + i / n) % n, static_cast<T>(i % 13 + 1)});
+  }
+  return tinyTools::sparse_matrix<T>::fromTriplets(n, n, entries, format);
+}
+
+// Dense product of the same 1% matrix, the baseline the sparse kernels replace.
+template <typename T> void BM_Sparse_dense_matvec(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeSparse<T>(n, tinyTools::SparseFormat::CSR).toMatrix();
+  auto const vec = makeMatrix<T>(n, 1);
+  for(auto _ : state)
+  {
+    auto res = mat * vec;
+    benchmark::DoNotOptimize(res);
+  }
+  setCounters(state, static_cast<double>(n * n * sizeof(T)), 2.0 * static_cast<double>(n * n));
+}
+BENCHMARK_TEMPLATE(BM_Sparse_dense_matvec, float)->RangeMultiplier(4)->Range(1024, 4096);
+BENCHMARK_TEMPLATE(BM_Sparse_dense_matvec, double)->RangeMultiplier(4)->Range(1024, 4096);
+
+template <typename T, tinyTools::SparseFormat format> void BM_Sparse_matvec(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeSparse<T>(n, format);
+  auto const vec = makeMatrix<T>(n, 1);
+  std::vector<T> res(n);
+  for(auto _ : state)
+  {
+    mat.multiply(vec.span(), res);
+    benchmark::ClobberMemory();
+  }
+  auto const nnz = static_cast<double>(mat.nonZeros());
+  setCounters(state, nnz * static_cast<double>(sizeof(T) + sizeof(std::uint32_t)), 2.0 * nnz);
+}
+BENCHMARK_TEMPLATE(BM_Sparse_matvec, float, tinyTools::SparseFormat::CSR)->RangeMultiplier(4)->Range(1024, 16384);
+BENCHMARK_TEMPLATE(BM_Sparse_matvec, float, tinyTools::SparseFormat::CSC)->RangeMultiplier(4)->Range(1024, 16384);
+BENCHMARK_TEMPLATE(BM_Sparse_matvec, double, tinyTools::SparseFormat::CSR)->RangeMultiplier(4)->Range(1024, 16384);
+
+template <typename T> void BM_Sparse_matmul(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const mat = makeSparse<T>(n, tinyTools::SparseFormat::CSR);
+  auto const rhs = makeMatrix<T>(n, 64);
+  for(auto _ : state)
+  {
+    auto res = mat * rhs;
+    benchmark::DoNotOptimize(res);
+  }
+  setCounters(state, static_cast<double>(n * 64 * sizeof(T)), 2.0 * 64 * static_cast<double>(mat.nonZeros()));
+}
+BENCHMARK_TEMPLATE(BM_Sparse_matmul, float)->RangeMultiplier(4)->Range(1024, 4096);
+BENCHMARK_TEMPLATE(BM_Sparse_matmul, double)->RangeMultiplier(4)->Range(1024, 4096);
+
+template <typename T> void BM_Sparse_add(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const matA = makeSparse<T>(n, tinyTools::SparseFormat::CSR);
+  auto const matB = matA.t();
+  for(auto _ : state)
+  {
+    auto res = matA + matB;
+    benchmark::DoNotOptimize(res);
+  }
+  setCounters(state, 2.0 * static_cast<double>(matA.nonZeros() * (sizeof(T) + sizeof(std::uint32_t))), 0);
+}
+BENCHMARK_TEMPLATE(BM_Sparse_add, float)->RangeMultiplier(4)->Range(1024, 4096);
+
+#endif /* BENCH_SPARSE_HPP */
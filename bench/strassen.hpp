@@ -0,0 +1,26 @@
+#ifndef BENCH_STRASSEN_HPP
+#define BENCH_STRASSEN_HPP
+
+#include "common.hpp"
+
+// Large square products with the blocked GEMM and with Strassen-Winograd (default cutoff). FLOP/s counts 2 n^3 for
+// both, so the Strassen rate is the effective one.
+template <typename T, tinyTools::MultiplyAlgorithm algorithm> void BM_Strassen_multiply(benchmark::State& state)
+{
+  auto const n = static_cast<std::size_t>(state.range(0));
+  auto const lhm = makeMatrix<T>(n, n);
+  auto const rhm = makeMatrix<T>(n, n);
+  tinyTools::setMultiplyAlgorithm(algorithm);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(lhm * rhm);
+  }
+  tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::CLASSIC);
+  setCounters(state, static_cast<double>(3 * n * n * sizeof(T)), 2.0 * static_cast<double>(n * n * n));
+}
+BENCHMARK_TEMPLATE(BM_Strassen_multiply, double, tinyTools::MultiplyAlgorithm::CLASSIC)->RangeMultiplier(2)->Range(1024, 2048)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Strassen_multiply, double, tinyTools::MultiplyAlgorithm::STRASSEN)->RangeMultiplier(2)->Range(1024, 2048)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Strassen_multiply, float, tinyTools::MultiplyAlgorithm::CLASSIC)->RangeMultiplier(2)->Range(1024, 2048)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Strassen_multiply, float, tinyTools::MultiplyAlgorithm::STRASSEN)->RangeMultiplier(2)->Range(1024, 2048)->UseRealTime();
+
+#endif /* BENCH_STRASSEN_HPP */
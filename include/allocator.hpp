@@ -0,0 +1,245 @@
+#ifndef MATRIX_ALLOCATOR_HPP
+#define MATRIX_ALLOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+// Storage allocators for matrix buffers (matrix<T, Allocator>).
+//   aligned_allocator: every buffer starts on an Alignment boundary (one cache line / one AVX-512 register by default).
+//   pool_allocator:    64-byte aligned, freed buffers are cached in a thread-local size-class pool and handed back to
+//                      the next allocation of the same class, so same-shape temporaries in a loop stop calling malloc.
+//   using fast = tinyTools::matrix<float, tinyTools::pool_allocator<float>>;
+namespace tinyTools
+{
+    namespace detail
+    {
+        inline constexpr std::size_t cacheLine{64};
+
+        [[nodiscard]] inline auto alignedAllocate(std::size_t bytes, std::size_t alignment) -> void * { return ::operator new(bytes, std::align_val_t{alignment}); }
+        inline auto alignedDeallocate(void *ptr, std::size_t alignment) noexcept -> void { ::operator delete(ptr, std::align_val_t{alignment}); }
+    } // namespace detail
+
+    template <typename T, std::size_t Alignment = detail::cacheLine>
+        requires(std::has_single_bit(Alignment) && Alignment >= alignof(T))
+    struct aligned_allocator
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        inline constexpr aligned_allocator() noexcept = default;
+        template <typename U>
+        inline constexpr aligned_allocator(aligned_allocator<U, Alignment> const &) noexcept
+        {
+        }
+
+        [[nodiscard]] inline auto allocate(size_type n) -> T *
+        {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(detail::alignedAllocate(n * sizeof(T), Alignment));
+        }
+        inline auto deallocate(T *ptr, size_type) noexcept -> void { detail::alignedDeallocate(ptr, Alignment); }
+
+        template <typename U>
+        [[nodiscard]] inline constexpr auto operator==(aligned_allocator<U, Alignment> const &) const noexcept -> bool { return true; }
+    };
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Pool.
+    namespace detail
+    {
+        inline std::atomic<std::size_t> g_poolCacheLimit{std::size_t{1} << 28U};
+
+        // Size classes: 64 bytes, then four classes per power of two (80, 96, 112, 128, 160, ...), so rounding wastes at most 25%.
+        // Blocks bigger than maxPooledBytes go straight to the system allocator.
+        struct size_class
+        {
+            static constexpr std::size_t minShift{6};
+            static constexpr std::size_t maxShift{28};
+            static constexpr std::size_t count{1 + (maxShift - minShift) * 4};
+            static constexpr std::size_t maxPooledBytes{std::size_t{1} << maxShift};
+
+            [[nodiscard]] static inline constexpr auto index(std::size_t bytes) noexcept -> std::size_t
+            {
+                if (bytes <= (std::size_t{1} << minShift))
+                {
+                    return 0;
+                }
+                auto const shift = std::bit_width(bytes - 1) - 1;                           // 2^shift < bytes <= 2^(shift + 1).
+                auto const step = std::size_t{1} << (shift - 2);
+                auto const sub = (bytes - (std::size_t{1} << shift) + step - 1) / step;     // 1..4.
+                return 1 + (shift - minShift) * 4 + (sub - 1);
+            }
+
+            [[nodiscard]] static inline constexpr auto bytes(std::size_t index) noexcept -> std::size_t
+            {
+                if (index == 0)
+                {
+                    return std::size_t{1} << minShift;
+                }
+                auto const shift = minShift + (index - 1) / 4;
+                auto const sub = (index - 1) % 4 + 1;
+                return (std::size_t{1} << shift) + sub * (std::size_t{1} << (shift - 2));
+            }
+        };
+
+        // Per-thread cache of freed blocks, one intrusive free list per size class (the link lives in the free block).
+        // A block freed on another thread simply joins that thread's cache, every block comes from the same aligned operator new.
+        struct thread_pool
+        {
+            struct free_block
+            {
+                free_block *next{};
+            };
+
+            std::array<free_block *, size_class::count> freeLists{};
+            std::size_t cachedBytes{};
+
+            thread_pool() noexcept = default;
+            thread_pool(thread_pool const &) = delete;
+            auto operator=(thread_pool const &) -> thread_pool & = delete;
+
+            ~thread_pool()
+            {
+                release();
+                alive() = false;
+            }
+
+            // Trivially destructible flag, still readable while other thread_local objects release their buffers.
+            [[nodiscard]] static inline auto alive() noexcept -> bool &
+            {
+                thread_local bool flag{true};
+                return flag;
+            }
+
+            [[nodiscard]] static inline auto local() noexcept -> thread_pool *
+            {
+                if (!alive())
+                {
+                    return nullptr;
+                }
+                thread_local thread_pool pool{};
+                return &pool;
+            }
+
+            [[nodiscard]] inline auto allocate(std::size_t index) -> void *
+            {
+                if (auto *const block = freeLists[index]; block != nullptr)
+                {
+                    freeLists[index] = block->next;
+                    cachedBytes -= size_class::bytes(index);
+                    return block;
+                }
+                return alignedAllocate(size_class::bytes(index), cacheLine);
+            }
+
+            inline auto deallocate(void *ptr, std::size_t index) noexcept -> void
+            {
+                auto const bytes = size_class::bytes(index);
+                if (cachedBytes + bytes > g_poolCacheLimit.load(std::memory_order_relaxed))
+                {
+                    alignedDeallocate(ptr, cacheLine);
+                    return;
+                }
+                freeLists[index] = ::new (ptr) free_block{freeLists[index]};
+                cachedBytes += bytes;
+            }
+
+            inline auto release() noexcept -> void
+            {
+                for (auto &head : freeLists)
+                {
+                    while (head != nullptr)
+                    {
+                        auto *const next = head->next;
+                        alignedDeallocate(head, cacheLine);
+                        head = next;
+                    }
+                }
+                cachedBytes = 0;
+            }
+        };
+
+        [[nodiscard]] inline auto poolAllocate(std::size_t bytes) -> void *
+        {
+            auto *const pool = thread_pool::local();
+            if (bytes > size_class::maxPooledBytes || pool == nullptr)
+            {
+                return alignedAllocate(bytes, cacheLine);
+            }
+            return pool->allocate(size_class::index(bytes));
+        }
+
+        inline auto poolDeallocate(void *ptr, std::size_t bytes) noexcept -> void
+        {
+            auto *const pool = thread_pool::local();
+            if (bytes > size_class::maxPooledBytes || pool == nullptr)
+            {
+                alignedDeallocate(ptr, cacheLine);
+                return;
+            }
+            pool->deallocate(ptr, size_class::index(bytes));
+        }
+    } // namespace detail
+
+    // Maximum amount of bytes each thread keeps cached, blocks freed over the limit go back to the system allocator.
+    inline auto setPoolCacheLimit(std::size_t bytes) noexcept -> void { detail::g_poolCacheLimit.store(bytes, std::memory_order_relaxed); }
+    [[nodiscard]] inline auto poolCacheLimit() noexcept -> std::size_t { return detail::g_poolCacheLimit.load(std::memory_order_relaxed); }
+
+    // Bytes cached by the calling thread, and a way to give them back to the system.
+    [[nodiscard]] inline auto poolCachedBytes() noexcept -> std::size_t
+    {
+        auto const *const pool = detail::thread_pool::local();
+        return pool == nullptr ? 0 : pool->cachedBytes;
+    }
+    inline auto releasePoolMemory() noexcept -> void
+    {
+        if (auto *const pool = detail::thread_pool::local(); pool != nullptr)
+        {
+            pool->release();
+        }
+    }
+
+    template <typename T>
+        requires(alignof(T) <= detail::cacheLine)
+    struct pool_allocator
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using is_always_equal = std::true_type;
+
+        inline constexpr pool_allocator() noexcept = default;
+        template <typename U>
+        inline constexpr pool_allocator(pool_allocator<U> const &) noexcept
+        {
+        }
+
+        [[nodiscard]] inline auto allocate(size_type n) -> T *
+        {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(detail::poolAllocate(n * sizeof(T)));
+        }
+        inline auto deallocate(T *ptr, size_type n) noexcept -> void { detail::poolDeallocate(ptr, n * sizeof(T)); }
+
+        template <typename U>
+        [[nodiscard]] inline constexpr auto operator==(pool_allocator<U> const &) const noexcept -> bool { return true; }
+    };
+} // namespace tinyTools
+
+#endif /* MATRIX_ALLOCATOR_HPP */
@@ -0,0 +1,340 @@
+#ifndef MATRIX_ASYNC_HPP
+#define MATRIX_ASYNC_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+// Asynchronous operations on a bounded thread pool. Every call returns a task at once, tasks passed as arguments are
+// dependencies: the operation is queued when the last of them finishes, so no worker ever blocks on another task and
+// independent branches of the graph overlap (the latency is the critical path, not the sum of the steps).
+//   auto const ab = tinyTools::asyncMultiply(std::cref(A), std::cref(B));
+//   auto const cd = tinyTools::asyncMultiply(std::cref(C), std::cref(D));  // Runs next to A * B.
+//   auto const total = tinyTools::asyncSum(tinyTools::async([](auto const &x, auto const &y) { return eval(x + y); }, ab, cd));
+//   total.get();                                                              // Or co_await total.
+// Arguments are stored by value (move them in), std::cref passes a reference that must outlive the task. Errors are
+// stored and rethrown by get() and by every task depending on them. A task must not get() another one (it would hold a
+// worker while waiting), pass it as an argument instead.
+namespace tinyTools
+{
+    // Fixed amount of workers over one FIFO queue. The destructor runs the queued jobs and joins the workers.
+    struct thread_pool
+    {
+        inline explicit thread_pool(std::size_t const threads = threadCount())
+        {
+            workers_.reserve(std::max<std::size_t>(threads, 1));
+            for (std::size_t i{}; i < std::max<std::size_t>(threads, 1); ++i)
+            {
+                workers_.emplace_back([this] { run(); });
+            }
+        }
+
+        thread_pool(thread_pool const &) = delete;
+        auto operator=(thread_pool const &) -> thread_pool & = delete;
+
+        inline ~thread_pool()
+        {
+            {
+                std::scoped_lock const lock{mutex_};
+                stopping_ = true;
+            }
+            ready_.notify_all();
+            workers_.clear();
+        }
+
+        [[nodiscard]] inline auto size() const noexcept -> std::size_t { return workers_.size(); }
+
+        // job must not throw.
+        inline auto submit(std::function<void()> job) -> void
+        {
+            {
+                std::scoped_lock const lock{mutex_};
+                jobs_.push_back(std::move(job));
+            }
+            ready_.notify_one();
+        }
+
+        // Pool used when none is given, threadCount() workers created on first use.
+        [[nodiscard]] static inline auto shared() -> thread_pool &
+        {
+            static thread_pool pool{};
+            return pool;
+        }
+
+    private:
+        std::mutex mutex_{};
+        std::condition_variable ready_{};
+        std::deque<std::function<void()>> jobs_{};
+        bool stopping_{false};
+        std::vector<std::jthread> workers_{};
+
+        inline auto run() -> void
+        {
+            for (;;)
+            {
+                std::function<void()> job{};
+                {
+                    std::unique_lock lock{mutex_};
+                    ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                    if (jobs_.empty())
+                    {
+                        return;
+                    }
+                    job = std::move(jobs_.front());
+                    jobs_.pop_front();
+                }
+                job();
+            }
+        }
+    };
+
+    template <typename T>
+    struct task;
+
+    namespace detail
+    {
+        // Completion flag plus the continuations waiting for it.
+        struct task_state_base
+        {
+            std::mutex mutex{};
+            std::condition_variable finished{};
+            bool done{false};
+            std::exception_ptr error{};
+            std::vector<std::function<void()>> continuations{};
+
+            // Queues func for the completion, false (func not queued) when the task already finished.
+            inline auto then(std::function<void()> func) -> bool
+            {
+                std::scoped_lock const lock{mutex};
+                if (done)
+                {
+                    return false;
+                }
+                continuations.push_back(std::move(func));
+                return true;
+            }
+
+            inline auto finish() -> void
+            {
+                std::vector<std::function<void()>> pending{};
+                {
+                    std::scoped_lock const lock{mutex};
+                    done = true;
+                    pending.swap(continuations);
+                }
+                finished.notify_all();
+                for (auto &func : pending)
+                {
+                    func();
+                }
+            }
+
+            inline auto wait() -> void
+            {
+                std::unique_lock lock{mutex};
+                finished.wait(lock, [this] { return done; });
+            }
+
+            [[nodiscard]] inline auto ready() -> bool
+            {
+                std::scoped_lock const lock{mutex};
+                return done;
+            }
+        };
+
+        template <typename T>
+        struct task_state : task_state_base
+        {
+            std::optional<T> value{};
+        };
+
+        template <typename T>
+        inline constexpr bool is_task_v{false};
+
+        template <typename T>
+        inline constexpr bool is_task_v<task<T>>{true};
+
+        // Argument as the operation sees it: the value of a task, the referenced object or the stored value.
+        template <typename T>
+        [[nodiscard]] inline auto resolve(T const &arg) -> decltype(auto)
+        {
+            if constexpr (is_task_v<T>)
+            {
+                return arg.get();
+            }
+            else if constexpr (!std::is_same_v<std::unwrap_reference_t<T>, T>)
+            {
+                return static_cast<std::remove_reference_t<std::unwrap_reference_t<T>> const &>(arg.get());
+            }
+            else
+            {
+                return arg;
+            }
+        }
+
+        template <typename T>
+        using resolved_t = decltype(resolve(std::declval<T const &>()));
+
+        struct task_access
+        {
+            template <typename T>
+            [[nodiscard]] static inline auto state(task<T> const &t) noexcept -> task_state_base & { return *t.state_; }
+
+            template <typename T>
+            [[nodiscard]] static inline auto make(std::shared_ptr<task_state<T>> state) noexcept -> task<T> { return task<T>{std::move(state)}; }
+        };
+
+        // Calls arrive once a task operand finishes (right away when it already has), other operands are no dependency.
+        template <typename T, typename arrive_t>
+        inline auto watchDependency(T const &operand, arrive_t const &arrive) -> void
+        {
+            if constexpr (is_task_v<T>)
+            {
+                if (!task_access::state(operand).then(arrive))
+                {
+                    arrive();
+                }
+            }
+        }
+    } // namespace detail
+
+    // Handle to the result of an asynchronous operation, copies share it.
+    template <typename T>
+    struct task
+    {
+        using value_type = T;
+
+        [[nodiscard]] inline auto ready() const -> bool { return state_->ready(); }
+        inline auto wait() const -> void { state_->wait(); }
+
+        // Waits for the result, rethrows the error of the operation (or of one of its dependencies).
+        [[nodiscard]] inline auto get() const -> T const &
+        {
+            state_->wait();
+            if (state_->error)
+            {
+                std::rethrow_exception(state_->error);
+            }
+            return *state_->value;
+        }
+
+        // co_await resumes the coroutine on the thread that finishes the task (a pool worker), or does not suspend at all
+        // when the task is already done.
+        struct awaiter
+        {
+            std::shared_ptr<detail::task_state<T>> state{};
+
+            [[nodiscard]] inline auto await_ready() const -> bool { return state->ready(); }
+            [[nodiscard]] inline auto await_suspend(std::coroutine_handle<> handle) const -> bool
+            {
+                return state->then([handle] { handle.resume(); });
+            }
+            [[nodiscard]] inline auto await_resume() const -> T const & { return task{state}.get(); }
+        };
+
+        [[nodiscard]] inline auto operator co_await() const noexcept -> awaiter { return awaiter{state_}; }
+
+    private:
+        friend struct detail::task_access;
+
+        inline explicit task(std::shared_ptr<detail::task_state<T>> state) noexcept
+            : state_{std::move(state)}
+        {
+        }
+
+        std::shared_ptr<detail::task_state<T>> state_;
+    };
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // func(args...) on pool once every task in args is done. (Generic async, see the header comment for the arguments.)
+    template <typename func_t, typename... args_t>
+    [[nodiscard]] inline auto async(thread_pool &pool, func_t &&func, args_t &&...args)
+    {
+        using result_t = std::remove_cvref_t<std::invoke_result_t<std::decay_t<func_t> &, detail::resolved_t<std::decay_t<args_t>>...>>;
+        static_assert(!std::is_void_v<result_t>, "An asynchronous operation must return a value.");
+
+        auto state = std::make_shared<detail::task_state<result_t>>();
+        auto job = std::make_shared<std::tuple<std::decay_t<func_t>, std::decay_t<args_t>...>>(std::forward<func_t>(func), std::forward<args_t>(args)...);
+        auto launch = [&pool, state, job]
+        {
+            pool.submit([state, job]
+                        {
+                            try
+                            {
+                                state->value.emplace(std::apply([](auto &op, auto const &...operands) { return std::invoke(op, detail::resolve(operands)...); }, *job));
+                            }
+                            catch (...)
+                            {
+                                state->error = std::current_exception();
+                            }
+                            state->finish();
+                        });
+        };
+
+        // One count per dependency plus one for this call, the last arrival queues the job.
+        constexpr auto dependencies = (std::size_t{} + ... + std::size_t{detail::is_task_v<std::decay_t<args_t>>});
+        auto pending = std::make_shared<std::atomic<std::size_t>>(dependencies + 1);
+        auto arrive = [pending, launch]
+        {
+            if (pending->fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                launch();
+            }
+        };
+        std::apply([&arrive](auto const &, auto const &...operands) { (detail::watchDependency(operands, arrive), ...); }, *job);
+        arrive();
+        return detail::task_access::make(std::move(state));
+    }
+
+    template <typename func_t, typename... args_t>
+        requires(!std::is_same_v<std::remove_cvref_t<func_t>, thread_pool> && !detail::is_expression_v<func_t>)
+    [[nodiscard]] inline auto async(func_t &&func, args_t &&...args)
+    {
+        return async(thread_pool::shared(), std::forward<func_t>(func), std::forward<args_t>(args)...);
+    }
+
+    // Evaluates a lazy expression (A + B * 2, ...) into a matrix. Matrices the expression refers to must outlive the task.
+    template <typename E>
+        requires detail::is_expression_v<E>
+    [[nodiscard]] inline auto async(E &&expr, thread_pool &pool = thread_pool::shared())
+    {
+        return async(pool, [](auto const &e) { return eval(e); }, std::forward<E>(expr));
+    }
+
+    // Matrix product, each side a matrix, a std::cref to one or a task.
+    template <typename L, typename R>
+    [[nodiscard]] inline auto asyncMultiply(L &&lhs, R &&rhs, thread_pool &pool = thread_pool::shared())
+    {
+        return async(pool, [](auto const &l, auto const &r) { return l * r; }, std::forward<L>(lhs), std::forward<R>(rhs));
+    }
+
+    // Sum along a direction (a matrix) or of every element (a scalar).
+    template <typename M>
+    [[nodiscard]] inline auto asyncSum(M &&mat, Direction dir, thread_pool &pool = thread_pool::shared())
+    {
+        return async(pool, [dir](auto const &m) { return m.sum(dir); }, std::forward<M>(mat));
+    }
+
+    template <typename M>
+    [[nodiscard]] inline auto asyncSum(M &&mat, thread_pool &pool = thread_pool::shared())
+    {
+        return async(pool, [](auto const &m) { return m.sum(); }, std::forward<M>(mat));
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_ASYNC_HPP */
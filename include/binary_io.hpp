@@ -0,0 +1,370 @@
+#ifndef MATRIX_BINARY_IO_HPP
+#define MATRIX_BINARY_IO_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "matrix.hpp"
+
+// Binary matrix files (.ttm):
+//   offset  size  field
+//        0     8  magic "TTMATRIX"
+//        8     2  version (1)
+//       10     1  dtype (Dtype)
+//       11     1  endianness of the data (0 little, 1 big)
+//       12     4  alignment of the data offset
+//       16     8  rows
+//       24     8  cols
+//       32     8  data offset (multiple of alignment)
+//       40    24  reserved (zero)
+// Header integers are always little-endian. The data is rows * cols elements in row-major order.
+// mapped_matrix maps the file read-only and views the data in place, several processes share the same page cache.
+namespace tinyTools
+{
+    enum struct Dtype : std::uint8_t
+    {
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT64,
+        UINT64,
+        FLOAT32,
+        FLOAT64
+    };
+
+    template <typename T>
+    concept binary_numerical = numerical<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double>;
+
+    struct binary_header
+    {
+        static constexpr std::array<char, 8> magic{'T', 'T', 'M', 'A', 'T', 'R', 'I', 'X'};
+        static constexpr std::uint16_t currentVersion{1};
+        static constexpr std::size_t size{64};
+
+        Dtype dtype{};
+        std::endian endianness{std::endian::native};
+        std::uint32_t alignment{};
+        std::uint64_t rows{};
+        std::uint64_t cols{};
+        std::uint64_t dataOffset{};
+    };
+
+    namespace detail
+    {
+        template <binary_numerical T>
+        [[nodiscard]] inline constexpr auto dtypeOf() noexcept -> Dtype
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                return sizeof(T) == 4 ? Dtype::FLOAT32 : Dtype::FLOAT64;
+            }
+            else
+            {
+                constexpr auto index = static_cast<std::uint8_t>(std::bit_width(sizeof(T)) - 1) * 2 + (std::is_signed_v<T> ? 0 : 1);
+                return static_cast<Dtype>(index);
+            }
+        }
+
+        [[nodiscard]] inline constexpr auto dtypeSize(Dtype dtype) noexcept -> std::uint64_t
+        {
+            constexpr std::array<std::uint64_t, 10> sizes{1, 1, 2, 2, 4, 4, 8, 8, 4, 8};
+            return sizes[static_cast<std::size_t>(dtype)];
+        }
+
+        template <typename T>
+        [[nodiscard]] inline constexpr auto byteswap(T value) noexcept -> T
+        {
+            auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+            std::reverse(bytes.begin(), bytes.end());
+            return std::bit_cast<T>(bytes);
+        }
+
+        template <typename T>
+        inline auto storeLittle(std::byte *dst, T value) noexcept -> void
+        {
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                value = byteswap(value);
+            }
+            std::memcpy(dst, &value, sizeof(T));
+        }
+
+        template <typename T>
+        [[nodiscard]] inline auto loadLittle(std::byte const *src) noexcept -> T
+        {
+            T value{};
+            std::memcpy(&value, src, sizeof(T));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                value = byteswap(value);
+            }
+            return value;
+        }
+
+        [[nodiscard]] inline auto encodeHeader(binary_header const &header) -> std::array<std::byte, binary_header::size>
+        {
+            std::array<std::byte, binary_header::size> bytes{};
+            std::memcpy(bytes.data(), binary_header::magic.data(), binary_header::magic.size());
+            storeLittle(bytes.data() + 8, binary_header::currentVersion);
+            bytes[10] = static_cast<std::byte>(header.dtype);
+            bytes[11] = static_cast<std::byte>(header.endianness == std::endian::big ? 1 : 0);
+            storeLittle(bytes.data() + 12, header.alignment);
+            storeLittle(bytes.data() + 16, header.rows);
+            storeLittle(bytes.data() + 24, header.cols);
+            storeLittle(bytes.data() + 32, header.dataOffset);
+            return bytes;
+        }
+
+        [[nodiscard]] inline auto decodeHeader(std::byte const *bytes, std::uint64_t fileSize) -> binary_header
+        {
+            if (fileSize < binary_header::size || std::memcmp(bytes, binary_header::magic.data(), binary_header::magic.size()) != 0)
+            {
+                throw std::invalid_argument("Not a tinyTools matrix file!\n");
+            }
+            if (loadLittle<std::uint16_t>(bytes + 8) != binary_header::currentVersion)
+            {
+                throw std::invalid_argument("Unsupported matrix file version!\n");
+            }
+
+            binary_header header{};
+            header.dtype = static_cast<Dtype>(bytes[10]);
+            header.endianness = bytes[11] == std::byte{1} ? std::endian::big : std::endian::little;
+            header.alignment = loadLittle<std::uint32_t>(bytes + 12);
+            header.rows = loadLittle<std::uint64_t>(bytes + 16);
+            header.cols = loadLittle<std::uint64_t>(bytes + 24);
+            header.dataOffset = loadLittle<std::uint64_t>(bytes + 32);
+
+            if (header.dtype > Dtype::FLOAT64)
+            {
+                throw std::invalid_argument("Unknown matrix file dtype!\n");
+            }
+            if (header.rows == 0 || header.cols == 0 || header.dataOffset < binary_header::size || header.dataOffset > fileSize ||
+                header.cols > (fileSize - header.dataOffset) / dtypeSize(header.dtype) / header.rows)
+            {
+                throw std::invalid_argument("Corrupted matrix file, the data does not fit in the file!\n");
+            }
+            return header;
+        }
+
+        template <binary_numerical T>
+        inline auto checkDtype(binary_header const &header) -> void
+        {
+            if (header.dtype != dtypeOf<T>())
+            {
+                throw std::invalid_argument("Matrix file dtype does not match the requested type!\n");
+            }
+        }
+
+        // error is the errno of the failed call, saved before any cleanup call can overwrite it.
+        [[noreturn]] inline auto throwSystemError(int error, std::filesystem::path const &path, char const *what) -> void
+        {
+            throw std::system_error(error, std::generic_category(), std::string{what} + path.string());
+        }
+    } // namespace detail
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Writer. The data starts at the first multiple of alignment after the header, so the mapped view is aligned too.
+    template <typename U>
+        requires binary_numerical<std::remove_const_t<U>>
+    inline auto writeBinary(std::filesystem::path const &path, matrix_view<U> const &rhv, std::uint32_t alignment = 64, std::endian endianness = std::endian::native) -> void
+    {
+        using T = std::remove_const_t<U>;
+        if (alignment == 0 || !std::has_single_bit(alignment) || alignment < alignof(T))
+        {
+            throw std::invalid_argument("Alignment must be a power of two, at least the element alignment!\n");
+        }
+
+        binary_header header{detail::dtypeOf<T>(), endianness, alignment, rhv.rows(), rhv.cols(), 0};
+        header.dataOffset = (binary_header::size + alignment - 1) / alignment * alignment;
+
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Can not open file for writing: "} + path.string());
+        }
+        auto const bytes = detail::encodeHeader(header);
+        file.write(reinterpret_cast<char const *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        std::vector<char> const padding(header.dataOffset - binary_header::size, 0);
+        file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        // Contiguous rows in native order are written straight from the storage, the rest goes through a row buffer.
+        auto const swap = endianness != std::endian::native && sizeof(T) > 1;
+        std::vector<T> row{};
+        for (std::size_t r{}; r < rhv.rows(); ++r)
+        {
+            T const *src = &rhv.unchecked(r, 0);
+            if (swap || rhv.colStride() != 1)
+            {
+                row.resize(rhv.cols());
+                for (std::size_t c{}; c < rhv.cols(); ++c)
+                {
+                    row[c] = swap ? detail::byteswap(rhv.unchecked(r, c)) : rhv.unchecked(r, c);
+                }
+                src = row.data();
+            }
+            file.write(reinterpret_cast<char const *>(src), static_cast<std::streamsize>(rhv.cols() * sizeof(T)));
+        }
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Error writing file: "} + path.string());
+        }
+    }
+
+    template <binary_numerical T, typename Allocator>
+    inline auto writeBinary(std::filesystem::path const &path, matrix<T, Allocator> const &rhm, std::uint32_t alignment = 64, std::endian endianness = std::endian::native) -> void
+    {
+        writeBinary(path, rhm.view(), alignment, endianness);
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Copying reader, converts foreign endianness.
+    template <binary_numerical T, typename Allocator = std::allocator<T>>
+    [[nodiscard]] inline auto readBinary(std::filesystem::path const &path) -> matrix<T, Allocator>
+    {
+        std::ifstream file{path, std::ios::binary};
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Can not open file for reading: "} + path.string());
+        }
+        auto const fileSize = std::filesystem::file_size(path);
+        std::array<std::byte, binary_header::size> bytes{};
+        file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(std::min<std::uint64_t>(fileSize, bytes.size())));
+        auto const header = detail::decodeHeader(bytes.data(), fileSize);
+        detail::checkDtype<T>(header);
+
+        matrix<T, Allocator> ret{header.rows, header.cols, T{}};
+        file.seekg(static_cast<std::streamoff>(header.dataOffset));
+        file.read(reinterpret_cast<char *>(ret.ptr()), static_cast<std::streamsize>(ret.totalSize() * sizeof(T)));
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Error reading file: "} + path.string());
+        }
+        if (header.endianness != std::endian::native)
+        {
+            std::transform(ret.begin(), ret.end(), ret.begin(), [](T value) { return detail::byteswap(value); });
+        }
+        return ret;
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Read-only memory map of a matrix file, view() reads the mapped pages in place (no copy, pages load on first touch).
+    // The data must be in native endianness (readBinary converts foreign files).
+    template <binary_numerical T>
+    struct mapped_matrix
+    {
+        using value = T;
+        using size_type = std::size_t;
+
+        inline explicit mapped_matrix(std::filesystem::path const &path)
+        {
+            auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                detail::throwSystemError(errno, path, "Can not open file for mapping: ");
+            }
+            struct stat info
+            {
+            };
+            if (::fstat(fd, &info) != 0)
+            {
+                auto const error = errno;
+                ::close(fd);
+                detail::throwSystemError(error, path, "Can not stat file: ");
+            }
+            size_ = static_cast<std::size_t>(info.st_size);
+            mapping_ = size_ == 0 ? MAP_FAILED : ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            auto const mapError = errno;
+            ::close(fd);
+            if (mapping_ == MAP_FAILED)
+            {
+                mapping_ = nullptr;
+                if (size_ == 0)
+                {
+                    throw std::invalid_argument("Not a tinyTools matrix file!\n");
+                }
+                detail::throwSystemError(mapError, path, "Can not map file: ");
+            }
+
+            try
+            {
+                auto const *const bytes = static_cast<std::byte const *>(mapping_);
+                auto const header = detail::decodeHeader(bytes, size_);
+                detail::checkDtype<T>(header);
+                if (header.endianness != std::endian::native)
+                {
+                    throw std::invalid_argument("Matrix file endianness is not native, use readBinary to convert it!\n");
+                }
+                if (header.dataOffset % alignof(T) != 0)
+                {
+                    throw std::invalid_argument("Matrix file data is not aligned for the element type!\n");
+                }
+                view_ = matrix_view<T const>{reinterpret_cast<T const *>(bytes + header.dataOffset), header.rows, header.cols};
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+        }
+
+        mapped_matrix(mapped_matrix const &) = delete;
+        auto operator=(mapped_matrix const &) -> mapped_matrix & = delete;
+
+        inline mapped_matrix(mapped_matrix &&rhm) noexcept
+            : mapping_{std::exchange(rhm.mapping_, nullptr)}, size_{std::exchange(rhm.size_, 0)}, view_{std::exchange(rhm.view_, {})}
+        {
+        }
+
+        inline auto operator=(mapped_matrix &&rhm) noexcept -> mapped_matrix &
+        {
+            std::swap(mapping_, rhm.mapping_);
+            std::swap(size_, rhm.size_);
+            std::swap(view_, rhm.view_);
+            return *this;
+        }
+
+        ~mapped_matrix() noexcept { unmap(); }
+
+        [[nodiscard]] inline auto view() const noexcept -> matrix_view<T const> { return view_; }
+        [[nodiscard]] inline auto rows() const noexcept -> size_type { return view_.rows(); }
+        [[nodiscard]] inline auto cols() const noexcept -> size_type { return view_.cols(); }
+        [[nodiscard]] inline auto totalSize() const noexcept -> size_type { return view_.totalSize(); }
+        [[nodiscard]] inline auto toMatrix() const -> matrix<T> { return matrix<T>{view_}; }
+
+    private:
+        void *mapping_{};
+        std::size_t size_{};
+        matrix_view<T const> view_{};
+
+        inline auto unmap() noexcept -> void
+        {
+            if (mapping_ != nullptr)
+            {
+                ::munmap(mapping_, size_);
+                mapping_ = nullptr;
+            }
+        }
+    };
+} // namespace tinyTools
+
+#endif /* MATRIX_BINARY_IO_HPP */
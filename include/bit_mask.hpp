@@ -0,0 +1,242 @@
+#ifndef MATRIX_BIT_MASK_HPP
+#define MATRIX_BIT_MASK_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "detail/bounds.hpp"
+#include "matrix_fwd.hpp"
+#include "parallel.hpp"
+
+namespace tinyTools
+{
+    // Packed boolean matrix (one bit per element, row-major), the result of the lt/le/gt/ge/eq/ne comparisons.
+    // Logical ops, count, any and all work on whole 64-bit words, find and the masked select/assign of matrix skip
+    // the empty words. Bits past totalSize() in the last word are always zero.
+    struct bit_mask
+    {
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        using word_type = std::uint64_t;
+        using size_type = std::size_t;
+
+        static constexpr size_type wordBits{64};
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Ctors.
+        inline explicit bit_mask(size_type const rows, size_type const cols, bool const value = false)
+            : rows_{rows}, cols_{cols}
+        {
+            if (rows == 0)
+            {
+                throw std::length_error("Rows can not be 0!\n");
+            }
+            if (cols == 0)
+            {
+                throw std::length_error("Cols can not be 0!\n");
+            }
+            words_.assign(wordCount(totalSize()), value ? ~word_type{} : word_type{});
+            clearTail();
+        }
+
+        template <typename Allocator>
+        inline explicit bit_mask(matrix<bool, Allocator> const &rhm)
+            : bit_mask(rhm.rows(), rhm.cols())
+        {
+            size_type i{};
+            for (auto const value : rhm)
+            {
+                words_[i / wordBits] |= word_type{value} << (i % wordBits);
+                ++i;
+            }
+        }
+
+        template <typename Allocator = std::allocator<bool>>
+        [[nodiscard]] inline auto toMatrix() const -> matrix<bool, Allocator>
+        {
+            typename matrix<bool, Allocator>::container_type data(totalSize());
+            for (size_type i{}; i < totalSize(); ++i)
+            {
+                data[i] = test(i);
+            }
+            return matrix<bool, Allocator>{rows_, cols_, std::move(data)};
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Getters.
+        [[nodiscard]] inline auto rows() const noexcept -> size_type { return rows_; }
+        [[nodiscard]] inline auto cols() const noexcept -> size_type { return cols_; }
+        [[nodiscard]] inline auto totalSize() const noexcept -> size_type { return rows_ * cols_; }
+        [[nodiscard]] inline auto words() const noexcept -> std::span<word_type const> { return words_; }
+        [[nodiscard]] inline auto words() noexcept -> std::span<word_type> { return words_; }
+
+        [[nodiscard]] static inline constexpr auto wordCount(size_type bits) noexcept -> size_type { return (bits + wordBits - 1) / wordBits; }
+
+        [[nodiscard]] inline auto operator()(size_type r, size_type c) const -> bool
+        {
+            detail::checkIndex<detail::checkPublicAccess>(r, c, rows_, cols_);
+            return test(r * cols_ + c);
+        }
+        [[nodiscard]] inline auto operator[](size_type idx) const -> bool
+        {
+            detail::checkIndex<detail::checkPublicAccess>(idx, totalSize());
+            return test(idx);
+        }
+
+        [[nodiscard]] inline auto test(size_type idx) const noexcept -> bool { return ((words_[idx / wordBits] >> (idx % wordBits)) & 1U) != 0; }
+
+        inline auto set(size_type r, size_type c, bool value = true) -> void
+        {
+            detail::checkIndex<detail::checkPublicAccess>(r, c, rows_, cols_);
+            setBit(r * cols_ + c, value);
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Logical operators, word by word.
+        [[nodiscard]] inline auto operator==(bit_mask const &rhm) const noexcept -> bool { return rows_ == rhm.rows_ && cols_ == rhm.cols_ && words_ == rhm.words_; }
+        [[nodiscard]] inline auto operator!=(bit_mask const &rhm) const noexcept -> bool { return !(operator==(rhm)); }
+
+        inline auto operator&=(bit_mask const &rhm) -> bit_mask & { return apply(rhm, [](word_type lhs, word_type rhs) { return lhs & rhs; }); }
+        inline auto operator|=(bit_mask const &rhm) -> bit_mask & { return apply(rhm, [](word_type lhs, word_type rhs) { return lhs | rhs; }); }
+        inline auto operator^=(bit_mask const &rhm) -> bit_mask & { return apply(rhm, [](word_type lhs, word_type rhs) { return lhs ^ rhs; }); }
+
+        [[nodiscard]] friend inline auto operator&(bit_mask lhm, bit_mask const &rhm) -> bit_mask { return lhm &= rhm; }
+        [[nodiscard]] friend inline auto operator|(bit_mask lhm, bit_mask const &rhm) -> bit_mask { return lhm |= rhm; }
+        [[nodiscard]] friend inline auto operator^(bit_mask lhm, bit_mask const &rhm) -> bit_mask { return lhm ^= rhm; }
+
+        // Logical not in place. (Matlab: ~)
+        inline auto flip() noexcept -> bit_mask &
+        {
+            for (auto &word : words_)
+            {
+                word = ~word;
+            }
+            clearTail();
+            return *this;
+        }
+        [[nodiscard]] inline auto operator~() const -> bit_mask
+        {
+            auto ret{*this};
+            return ret.flip();
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Methods.
+        // Amount of true elements. (Matlab: nnz)
+        [[nodiscard]] inline auto count() const noexcept -> size_type
+        {
+            size_type ret{};
+            for (auto const word : words_)
+            {
+                ret += static_cast<size_type>(std::popcount(word));
+            }
+            return ret;
+        }
+
+        [[nodiscard]] inline auto any() const noexcept -> bool
+        {
+            return std::any_of(words_.begin(), words_.end(), [](word_type word) { return word != 0; });
+        }
+
+        [[nodiscard]] inline auto all() const noexcept -> bool
+        {
+            auto const full = totalSize() / wordBits;
+            if (!std::all_of(words_.begin(), words_.begin() + static_cast<std::ptrdiff_t>(full), [](word_type word) { return word == ~word_type{}; }))
+            {
+                return false;
+            }
+            return full == words_.size() || words_.back() == tailMask();
+        }
+
+        [[nodiscard]] inline auto none() const noexcept -> bool { return !any(); }
+
+        // Index of the first true element at or after idx, totalSize() when there is none.
+        [[nodiscard]] inline auto findNext(size_type idx) const noexcept -> size_type
+        {
+            if (idx >= totalSize())
+            {
+                return totalSize();
+            }
+            auto w = idx / wordBits;
+            auto word = words_[w] & (~word_type{} << (idx % wordBits));
+            while (word == 0)
+            {
+                if (++w == words_.size())
+                {
+                    return totalSize();
+                }
+                word = words_[w];
+            }
+            return w * wordBits + static_cast<size_type>(std::countr_zero(word));
+        }
+
+        // Linear (row-major) indexes of the true elements. (Matlab: find)
+        [[nodiscard]] inline auto find() const -> std::vector<size_type>
+        {
+            std::vector<size_type> ret{};
+            ret.reserve(count());
+            forEachSet([&ret](size_type idx) { ret.push_back(idx); });
+            return ret;
+        }
+
+        // Calls func(idx) for every true element in increasing order.
+        template <typename func_t>
+        inline auto forEachSet(func_t &&func) const -> void
+        {
+            for (size_type w{}; w < words_.size(); ++w)
+            {
+                for (auto word = words_[w]; word != 0; word &= word - 1)
+                {
+                    func(w * wordBits + static_cast<size_type>(std::countr_zero(word)));
+                }
+            }
+        }
+
+        [[nodiscard]] inline auto sameSize(bit_mask const &rhm) const noexcept -> bool { return rows_ == rhm.rows_ && cols_ == rhm.cols_; }
+
+    private:
+        size_type rows_{};
+        size_type cols_{};
+        std::vector<word_type> words_{};
+
+        inline auto setBit(size_type idx, bool value) noexcept -> void
+        {
+            auto const bit = word_type{1} << (idx % wordBits);
+            auto &word = words_[idx / wordBits];
+            word = value ? word | bit : word & ~bit;
+        }
+
+        // Valid bits of the last word.
+        [[nodiscard]] inline auto tailMask() const noexcept -> word_type
+        {
+            auto const tail = totalSize() % wordBits;
+            return tail == 0 ? ~word_type{} : (word_type{1} << tail) - 1;
+        }
+
+        inline auto clearTail() noexcept -> void { words_.back() &= tailMask(); }
+
+        template <typename op_t>
+        inline auto apply(bit_mask const &rhm, op_t op) -> bit_mask &
+        {
+            if (!sameSize(rhm))
+            {
+                throw std::invalid_argument("Masks are not the same size!\n");
+            }
+            detail::for_each_chunk(words_.size(), wordBits, [this, &rhm, op](size_type begin, size_type end)
+                                   {
+                                       for (auto w{begin}; w < end; ++w)
+                                       {
+                                           words_[w] = op(words_[w], rhm.words_[w]);
+                                       }
+                                   });
+            return *this;
+        }
+    };
+} // namespace tinyTools
+
+#endif /* MATRIX_BIT_MASK_HPP */
@@ -0,0 +1,70 @@
+#ifndef MATRIX_DETAIL_BOUNDS_HPP
+#define MATRIX_DETAIL_BOUNDS_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// Bounds-check policy:
+//   0: no checks at all.
+//   1: public accessors (operator(), operator[]) check and throw std::out_of_range, internal kernels do not (release default).
+//   2: the internal unchecked() accessors check too (default when DEBUG_BUILD is defined, as the CMake Debug config does).
+#ifndef TINYTOOLS_BOUNDS_CHECK
+#ifdef DEBUG_BUILD
+#define TINYTOOLS_BOUNDS_CHECK 2
+#else
+#define TINYTOOLS_BOUNDS_CHECK 1
+#endif
+#endif
+
+namespace tinyTools::detail
+{
+    inline constexpr bool checkPublicAccess{TINYTOOLS_BOUNDS_CHECK >= 1};
+    inline constexpr bool checkInternalAccess{TINYTOOLS_BOUNDS_CHECK >= 2};
+
+    // Message building is kept out of line, so a checked access only costs a compare and a never-taken branch.
+    [[noreturn, gnu::cold, gnu::noinline]] inline auto throwRowsOutOfRange(std::size_t rows) -> void
+    {
+        throw std::out_of_range(std::string{"Rows out of range, max rows= " + std::to_string(rows) + '\n'});
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]] inline auto throwColsOutOfRange(std::size_t cols) -> void
+    {
+        throw std::out_of_range(std::string{"Cols out of range, max cols= " + std::to_string(cols) + '\n'});
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]] inline auto throwIndexOutOfRange(std::size_t size) -> void
+    {
+        throw std::out_of_range(std::string{"Index out of range, max= " + std::to_string(size) + '\n'});
+    }
+
+    template <bool checked>
+    inline constexpr auto checkIndex(std::size_t r, std::size_t c, std::size_t rows, std::size_t cols) -> void
+    {
+        if constexpr (checked)
+        {
+            if (r >= rows)
+            {
+                throwRowsOutOfRange(rows);
+            }
+            if (c >= cols)
+            {
+                throwColsOutOfRange(cols);
+            }
+        }
+    }
+
+    template <bool checked>
+    inline constexpr auto checkIndex(std::size_t idx, std::size_t size) -> void
+    {
+        if constexpr (checked)
+        {
+            if (idx >= size)
+            {
+                throwIndexOutOfRange(size);
+            }
+        }
+    }
+} // namespace tinyTools::detail
+
+#endif /* MATRIX_DETAIL_BOUNDS_HPP */
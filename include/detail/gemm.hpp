@@ -0,0 +1,264 @@
+#ifndef MATRIX_DETAIL_GEMM_HPP
+#define MATRIX_DETAIL_GEMM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../parallel.hpp"
+
+namespace tinyTools::detail
+{
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Blocking parameters (Goto/BLIS style).
+    //   - MR x NR: register tile computed by the micro-kernel.
+    //   - KC x NR: packed panel of B, should stay in L1.
+    //   - MC x KC: packed block of A, should stay in L2.
+    //   - KC x NC: packed block of B, should stay in L3.
+    template <typename T>
+    struct gemm_blocking
+    {
+        static constexpr std::size_t MR{4};
+        static constexpr std::size_t NR{sizeof(T) >= 8 ? 8 : 16};
+        static constexpr std::size_t KC{256};
+        static constexpr std::size_t MC{128};
+        static constexpr std::size_t NC{4096};
+    };
+
+    // Strided (row stride, col stride) access, so the same kernel works for row-major, col-major and transposed operands.
+    template <typename T>
+    struct gemm_operand
+    {
+        T *ptr{};
+        std::size_t rs{};
+        std::size_t cs{};
+
+        [[nodiscard]] inline constexpr auto operator()(std::size_t r, std::size_t c) const noexcept -> T & { return ptr[r * rs + c * cs]; }
+    };
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Packing.
+    // A (mc x kc) is stored as consecutive MR-row micro-panels, each one column-major: panel[p * MR + i].
+    template <typename T>
+    inline auto gemm_pack_a(std::size_t mc, std::size_t kc, gemm_operand<T const> a, T *buffer) noexcept -> void
+    {
+        constexpr auto MR = gemm_blocking<T>::MR;
+        for (std::size_t ir{}; ir < mc; ir += MR)
+        {
+            auto const mr = std::min(MR, mc - ir);
+            for (std::size_t p{}; p < kc; ++p)
+            {
+                for (std::size_t i{}; i < MR; ++i)
+                {
+                    *buffer++ = i < mr ? a(ir + i, p) : T{};
+                }
+            }
+        }
+    }
+
+    // B (kc x nc) is stored as consecutive NR-col micro-panels, each one row-major: panel[p * NR + j].
+    template <typename T>
+    inline auto gemm_pack_b(std::size_t kc, std::size_t nc, gemm_operand<T const> b, T *buffer) noexcept -> void
+    {
+        constexpr auto NR = gemm_blocking<T>::NR;
+        for (std::size_t jr{}; jr < nc; jr += NR)
+        {
+            auto const nr = std::min(NR, nc - jr);
+            for (std::size_t p{}; p < kc; ++p)
+            {
+                for (std::size_t j{}; j < NR; ++j)
+                {
+                    *buffer++ = j < nr ? b(p, jr + j) : T{};
+                }
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Micro-kernel: C(mr x nr) = alpha * A_panel * B_panel + beta * C.
+    // The accumulator tile has compile-time shape so the compiler keeps it in vector registers.
+    template <typename T>
+    inline auto gemm_micro_kernel(std::size_t kc, T alpha, T const *__restrict a, T const *__restrict b, T beta, gemm_operand<T> c, std::size_t mr, std::size_t nr) noexcept -> void
+    {
+        constexpr auto MR = gemm_blocking<T>::MR;
+        constexpr auto NR = gemm_blocking<T>::NR;
+
+        T acc[MR][NR]{};
+        for (std::size_t p{}; p < kc; ++p)
+        {
+            for (std::size_t i{}; i < MR; ++i)
+            {
+                auto const a_ip = a[i];
+                for (std::size_t j{}; j < NR; ++j)
+                {
+                    acc[i][j] = static_cast<T>(acc[i][j] + a_ip * b[j]);
+                }
+            }
+            a += MR;
+            b += NR;
+        }
+
+        // Beta == 0 must not read C (it may hold garbage or NaN).
+        for (std::size_t i{}; i < mr; ++i)
+        {
+            for (std::size_t j{}; j < nr; ++j)
+            {
+                auto &dst = c(i, j);
+                auto const value = alpha == T{1} ? acc[i][j] : static_cast<T>(alpha * acc[i][j]);
+                if (beta == T{})
+                {
+                    dst = value;
+                }
+                else if (beta == T{1})
+                {
+                    dst = static_cast<T>(dst + value);
+                }
+                else
+                {
+                    dst = static_cast<T>(beta * dst + value);
+                }
+            }
+        }
+    }
+
+    // Macro-kernel: walks the packed MC x KC block of A against the packed KC x NC block of B.
+    template <typename T>
+    inline auto gemm_macro_kernel(std::size_t mc, std::size_t nc, std::size_t kc, T alpha, T const *a_packed, T const *b_packed, T beta, gemm_operand<T> c) noexcept -> void
+    {
+        constexpr auto MR = gemm_blocking<T>::MR;
+        constexpr auto NR = gemm_blocking<T>::NR;
+
+        for (std::size_t jr{}; jr < nc; jr += NR)
+        {
+            auto const nr = std::min(NR, nc - jr);
+            for (std::size_t ir{}; ir < mc; ir += MR)
+            {
+                auto const mr = std::min(MR, mc - ir);
+                gemm_micro_kernel(kc, alpha, a_packed + ir * kc, b_packed + jr * kc, beta,
+                                  gemm_operand<T>{&c(ir, jr), c.rs, c.cs}, mr, nr);
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // C(m x n) = alpha * A(m x k) * B(k x n) + beta * C on the calling thread.
+    template <typename T>
+    inline auto gemm_blocked(std::size_t m, std::size_t n, std::size_t k, T alpha, gemm_operand<T const> a, gemm_operand<T const> b, T beta, gemm_operand<T> c) -> void
+    {
+        using blocking = gemm_blocking<T>;
+
+        if (m == 0 || n == 0)
+        {
+            return;
+        }
+        if (k == 0)
+        {
+            for (std::size_t i{}; i < m; ++i)
+            {
+                for (std::size_t j{}; j < n; ++j)
+                {
+                    c(i, j) = beta == T{} ? T{} : static_cast<T>(beta * c(i, j));
+                }
+            }
+            return;
+        }
+
+        // Packing buffers are reused between calls on the same thread.
+        thread_local std::vector<T> a_buffer{};
+        thread_local std::vector<T> b_buffer{};
+        a_buffer.resize(blocking::MC * blocking::KC);
+        b_buffer.resize(blocking::KC * ((std::min(blocking::NC, n) + blocking::NR - 1) / blocking::NR * blocking::NR));
+
+        for (std::size_t jc{}; jc < n; jc += blocking::NC)
+        {
+            auto const nc = std::min(blocking::NC, n - jc);
+            for (std::size_t pc{}; pc < k; pc += blocking::KC)
+            {
+                auto const kc = std::min(blocking::KC, k - pc);
+                gemm_pack_b(kc, nc, gemm_operand<T const>{&b(pc, jc), b.rs, b.cs}, b_buffer.data());
+
+                // Only the first K block applies the caller's beta, the rest accumulate.
+                auto const beta_pc = pc == 0 ? beta : T{1};
+                for (std::size_t ic{}; ic < m; ic += blocking::MC)
+                {
+                    auto const mc = std::min(blocking::MC, m - ic);
+                    gemm_pack_a(mc, kc, gemm_operand<T const>{&a(ic, pc), a.rs, a.cs}, a_buffer.data());
+                    gemm_macro_kernel(mc, nc, kc, alpha, a_buffer.data(), b_buffer.data(), beta_pc,
+                                      gemm_operand<T>{&c(ic, jc), c.rs, c.cs});
+                }
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Parallel driver: C is cut in MC-row x tileN-col tiles that run gemm_blocked independently (no shared writes, no
+    // reduction over K). tileN is halved from NC until every worker gets a few tiles, so the work stealing of the
+    // parallel algorithms can balance uneven tiles. Each tile packs its own A and B blocks, which costs 1/MC and 1/tileN
+    // of the arithmetic.
+    struct gemm_tile
+    {
+        std::size_t row{};
+        std::size_t col{};
+        std::size_t rows{};
+        std::size_t cols{};
+    };
+
+    template <typename T>
+    [[nodiscard]] inline auto gemm_tiles(std::size_t m, std::size_t n, std::size_t workers) -> std::vector<gemm_tile>
+    {
+        using blocking = gemm_blocking<T>;
+
+        auto const tilesM = (m + blocking::MC - 1) / blocking::MC;
+        auto tileN = (std::min(blocking::NC, n) + blocking::NR - 1) / blocking::NR * blocking::NR;
+        while (tilesM * ((n + tileN - 1) / tileN) < workers * 4 && tileN > blocking::NR * 4)
+        {
+            tileN = (tileN / 2 + blocking::NR - 1) / blocking::NR * blocking::NR;
+        }
+
+        std::vector<gemm_tile> tiles{};
+        tiles.reserve(tilesM * ((n + tileN - 1) / tileN));
+        for (std::size_t ic{}; ic < m; ic += blocking::MC)
+        {
+            for (std::size_t jc{}; jc < n; jc += tileN)
+            {
+                tiles.push_back({ic, jc, std::min(blocking::MC, m - ic), std::min(tileN, n - jc)});
+            }
+        }
+        return tiles;
+    }
+
+    // C(m x n) = alpha * A(m x k) * B(k x n) + beta * C.
+    // Goes parallel under Execution::PARALLEL when m * n * ceil(k / KC) reaches parallelThreshold() (one unit is one C
+    // element updated by one packed K block).
+    template <typename T>
+    inline auto gemm(std::size_t m, std::size_t n, std::size_t k, T alpha, gemm_operand<T const> a, gemm_operand<T const> b, T beta, gemm_operand<T> c) -> void
+    {
+        using blocking = gemm_blocking<T>;
+
+        auto const workers = threadCount();
+        if (workers < 2 || m == 0 || n == 0 || k == 0 || !runParallel(m * n * ((k + blocking::KC - 1) / blocking::KC)))
+        {
+            gemm_blocked(m, n, k, alpha, a, b, beta, c);
+            return;
+        }
+
+        auto const tiles = gemm_tiles<T>(m, n, workers);
+        if (tiles.size() < 2)
+        {
+            gemm_blocked(m, n, k, alpha, a, b, beta, c);
+            return;
+        }
+
+        // par (not par_unseq): the tiles resize the thread_local packing buffers.
+        with_workers([&]
+                     { std::for_each(std::execution::par, tiles.begin(), tiles.end(),
+                                     [=](gemm_tile const &tile)
+                                     {
+                                         gemm_blocked(tile.rows, tile.cols, k, alpha, gemm_operand<T const>{&a(tile.row, 0), a.rs, a.cs},
+                                                      gemm_operand<T const>{&b(0, tile.col), b.rs, b.cs}, beta,
+                                                      gemm_operand<T>{&c(tile.row, tile.col), c.rs, c.cs});
+                                     }); });
+    }
+} // namespace tinyTools::detail
+
+#endif /* MATRIX_DETAIL_GEMM_HPP */
@@ -0,0 +1,238 @@
+#ifndef MATRIX_DETAIL_REDUCE_HPP
+#define MATRIX_DETAIL_REDUCE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../parallel.hpp"
+#include "simd.hpp"
+
+// Reduction engine behind sum, prod, min, max, mean, any and all.
+// Operands are strided row-major blocks: element (r, c) is ptr[r * rowStride + c * colStride].
+//   ROWS:    every row is folded in place (pairwise for floating sums), rows are split over the workers.
+//   COLUMNS: one pass row by row, every row is combined with a vector of column accumulators (Kahan for floating sums),
+//            row chunks produce partial accumulators that are combined in chunk order (same result on every run).
+//   total:   the whole block as one sequence, chunks fold in parallel and the partials are combined in order.
+namespace tinyTools::detail
+{
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Operations: identity element plus an associative op. compensated marks the floating sums that use Kahan/pairwise.
+    struct reduce_sum
+    {
+        static constexpr bool compensated{true};
+        template <typename T>
+        [[nodiscard]] static inline constexpr auto identity() noexcept -> T { return T{}; }
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs + rhs); }
+    };
+
+    struct reduce_prod
+    {
+        static constexpr bool compensated{false};
+        template <typename T>
+        [[nodiscard]] static inline constexpr auto identity() noexcept -> T { return T{1}; }
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs * rhs); }
+    };
+
+    struct reduce_min
+    {
+        static constexpr bool compensated{false};
+        template <typename T>
+        [[nodiscard]] static inline constexpr auto identity() noexcept -> T
+        {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+        }
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return rhs < lhs ? rhs : lhs; }
+    };
+
+    struct reduce_max
+    {
+        static constexpr bool compensated{false};
+        template <typename T>
+        [[nodiscard]] static inline constexpr auto identity() noexcept -> T
+        {
+            return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+        }
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return lhs < rhs ? rhs : lhs; }
+    };
+
+    // any/all accumulate 0/1 in T, so they run through the same kernels as the arithmetic reductions.
+    struct reduce_any
+    {
+        static constexpr bool compensated{false};
+        template <typename T>
+        [[nodiscard]] static inline constexpr auto identity() noexcept -> T { return T{}; }
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs != T{} || rhs != T{}); }
+    };
+
+    struct reduce_all
+    {
+        static constexpr bool compensated{false};
+        template <typename T>
+        [[nodiscard]] static inline constexpr auto identity() noexcept -> T { return T{1}; }
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs != T{} && rhs != T{}); }
+    };
+
+    template <typename op_t, typename T>
+    inline constexpr bool is_compensated_v = op_t::compensated && std::is_floating_point_v<T>;
+
+    // Integer means are computed in double (Matlab returns the rounded integer, we keep the fraction).
+    template <typename T>
+    using mean_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Engine.
+    inline constexpr std::size_t pairwiseBlock{256};
+
+    // Folds n elements spaced by stride into an acc_t. Compensated ops split in halves down to pairwiseBlock (error grows
+    // with log n). Strided or converted (acc_t != T) leafs are gathered into a local block first, so the SIMD fold always
+    // reads contiguous acc_t.
+    template <typename acc_t, typename op_t, typename T>
+    [[nodiscard]] inline auto reduce_strided(T const *src, std::size_t n, std::size_t stride, op_t op) noexcept -> acc_t
+    {
+        constexpr bool same{std::is_same_v<acc_t, T>};
+        if (n > pairwiseBlock && (is_compensated_v<op_t, acc_t> || stride != 1 || !same))
+        {
+            auto const half = (n / 2 + pairwiseBlock - 1) / pairwiseBlock * pairwiseBlock;
+            return op(reduce_strided<acc_t>(src, half, stride, op), reduce_strided<acc_t>(src + half * stride, n - half, stride, op));
+        }
+
+        acc_t ret{};
+        if constexpr (same)
+        {
+            if (stride == 1)
+            {
+                simd::fold(&ret, src, n, op);
+                return ret;
+            }
+        }
+        std::array<acc_t, pairwiseBlock> block{};
+        for (std::size_t i{}; i < n; ++i)
+        {
+            block[i] = static_cast<acc_t>(src[i * stride]);
+        }
+        simd::fold(&ret, block.data(), n, op);
+        return ret;
+    }
+
+    // out[r] = fold of row r.
+    template <typename acc_t, typename op_t, typename T, typename R>
+    inline auto reduce_rows(T const *ptr, std::size_t rows, std::size_t cols, std::size_t rowStride, std::size_t colStride, R *out, op_t op) -> void
+    {
+        for_each_chunk(rows, cols, [=](std::size_t begin, std::size_t end)
+                       {
+                           for (auto r{begin}; r < end; ++r)
+                           {
+                               out[r] = static_cast<R>(reduce_strided<acc_t>(ptr + r * rowStride, cols, colStride, op));
+                           }
+                       });
+    }
+
+    // Column accumulators of a chunk of rows, comp is only used by the compensated sums.
+    template <typename T>
+    struct column_partial
+    {
+        std::vector<T> acc{};
+        std::vector<T> comp{};
+    };
+
+    // out[c] = fold of column c, walking the rows in storage order.
+    template <typename acc_t, typename op_t, typename T, typename R>
+    inline auto reduce_cols(T const *ptr, std::size_t rows, std::size_t cols, std::size_t rowStride, std::size_t colStride, R *out, op_t op) -> void
+    {
+        constexpr bool compensated{is_compensated_v<op_t, acc_t>};
+        auto partials = map_chunks(rows, cols, [=](std::size_t begin, std::size_t end)
+                                         {
+                                             column_partial<acc_t> partial{std::vector<acc_t>(cols, op_t::template identity<acc_t>()), {}};
+                                             if constexpr (compensated)
+                                             {
+                                                 partial.comp.resize(cols);
+                                             }
+                                             std::vector<acc_t> gathered{};
+                                             for (auto r{begin}; r < end; ++r)
+                                             {
+                                                 acc_t const *row{};
+                                                 if constexpr (std::is_same_v<acc_t, T>)
+                                                 {
+                                                     row = ptr + r * rowStride;
+                                                 }
+                                                 if (colStride != 1 || !std::is_same_v<acc_t, T>)
+                                                 {
+                                                     gathered.resize(cols);
+                                                     for (std::size_t c{}; c < cols; ++c)
+                                                     {
+                                                         gathered[c] = static_cast<acc_t>(ptr[r * rowStride + c * colStride]);
+                                                     }
+                                                     row = gathered.data();
+                                                 }
+                                                 if constexpr (compensated)
+                                                 {
+                                                     simd::kahan(partial.acc.data(), partial.comp.data(), row, cols);
+                                                 }
+                                                 else
+                                                 {
+                                                     simd::binary(partial.acc.data(), partial.acc.data(), row, cols, op);
+                                                 }
+                                             }
+                                             if constexpr (compensated)
+                                             {
+                                                 // Fold the compensation back, the partial is now a plain value.
+                                                 simd::binary(partial.acc.data(), partial.acc.data(), partial.comp.data(), cols, simd::sub{});
+                                             }
+                                             return partial;
+                                         });
+
+        auto total = std::move(partials.front().acc);
+        if constexpr (compensated)
+        {
+            std::vector<acc_t> comp(cols);
+            for (std::size_t p{1}; p < partials.size(); ++p)
+            {
+                simd::kahan(total.data(), comp.data(), partials[p].acc.data(), cols);
+            }
+            simd::binary(total.data(), total.data(), comp.data(), cols, simd::sub{});
+        }
+        else
+        {
+            for (std::size_t p{1}; p < partials.size(); ++p)
+            {
+                simd::binary(total.data(), total.data(), partials[p].acc.data(), cols, op);
+            }
+        }
+        std::transform(total.begin(), total.end(), out, [](acc_t value) { return static_cast<R>(value); });
+    }
+
+    // Fold of every element.
+    template <typename acc_t, typename op_t, typename T>
+    [[nodiscard]] inline auto reduce_total(T const *ptr, std::size_t rows, std::size_t cols, std::size_t rowStride, std::size_t colStride, op_t op) -> acc_t
+    {
+        // Contiguous storage is one long sequence, otherwise each row is folded first.
+        auto const contiguous = colStride == 1 && (rowStride == cols || rows == 1);
+        auto const size = contiguous ? rows * cols : rows;
+        auto const partials = map_chunks(size, contiguous ? 1 : cols, [=](std::size_t begin, std::size_t end)
+                                         {
+                                             if (contiguous)
+                                             {
+                                                 return reduce_strided<acc_t>(ptr + begin, end - begin, 1, op);
+                                             }
+                                             std::vector<acc_t> perRow(end - begin);
+                                             for (auto r{begin}; r < end; ++r)
+                                             {
+                                                 perRow[r - begin] = reduce_strided<acc_t>(ptr + r * rowStride, cols, colStride, op);
+                                             }
+                                             return reduce_strided<acc_t>(perRow.data(), perRow.size(), 1, op);
+                                         });
+        return reduce_strided<acc_t>(partials.data(), partials.size(), 1, op);
+    }
+} // namespace tinyTools::detail
+
+#endif /* MATRIX_DETAIL_REDUCE_HPP */
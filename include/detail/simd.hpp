@@ -0,0 +1,374 @@
+#ifndef MATRIX_DETAIL_SIMD_HPP
+#define MATRIX_DETAIL_SIMD_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Element-wise kernels over contiguous buffers with runtime ISA dispatch.
+// Every ISA variant is the same plain loop compiled with a different target attribute, so the compiler
+// emits the widest vector code it can (including the widening/narrowing needed by char and short) while the
+// binary still runs on CPUs without AVX.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TINYTOOLS_SIMD_X86 1
+#endif
+
+namespace tinyTools::detail::simd
+{
+    enum struct Isa : std::uint8_t
+    {
+        GENERIC,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+
+    [[nodiscard]] inline auto detectedIsa() noexcept -> Isa
+    {
+        static auto const isa = []() noexcept
+        {
+#ifdef TINYTOOLS_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            {
+                return Isa::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return Isa::AVX2;
+            }
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return Isa::SSE2;
+            }
+#endif
+            return Isa::GENERIC;
+        }();
+        return isa;
+    }
+
+    // Upper bound for the dispatch, lowering it forces the narrower kernels (used by tests and benchmarks).
+    inline std::atomic<Isa> g_isaLimit{Isa::AVX512};
+    inline auto setIsaLimit(Isa limit) noexcept -> void { g_isaLimit.store(limit, std::memory_order_relaxed); }
+    [[nodiscard]] inline auto activeIsa() noexcept -> Isa { return std::min(detectedIsa(), g_isaLimit.load(std::memory_order_relaxed)); }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Operations. The cast back to T keeps integer promotion from blocking narrow (char, short) vectorization: those lanes
+    // compute in T and wrap like the promoted result truncated back, nothing is widened.
+    struct add
+    {
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs + rhs); }
+    };
+
+    struct sub
+    {
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs - rhs); }
+    };
+
+    struct mul
+    {
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs * rhs); }
+    };
+
+    struct div
+    {
+        template <typename T>
+        [[nodiscard]] inline constexpr auto operator()(T lhs, T rhs) const noexcept -> T { return static_cast<T>(lhs / rhs); }
+    };
+
+    // Scalar right hand side of compare_mask, reads the same value at every index.
+    template <typename T>
+    struct broadcast
+    {
+        T value{};
+        [[nodiscard]] inline constexpr auto operator[](std::size_t) const noexcept -> T { return value; }
+    };
+
+    // 64 bools (0/1 bytes) into one word, bit j = block[j]. Every 8 bytes collapse to one with a multiply.
+    [[nodiscard]] inline auto packBits(bool const *block) noexcept -> std::uint64_t
+    {
+        std::uint64_t word{};
+        for (std::size_t k{}; k < 8; ++k)
+        {
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::uint64_t bytes{};
+                std::memcpy(&bytes, block + k * 8, 8);
+                word |= ((bytes * 0x0102040810204080ULL) >> 56U) << (k * 8);
+            }
+            else
+            {
+                for (std::size_t j{}; j < 8; ++j)
+                {
+                    word |= std::uint64_t{block[k * 8 + j]} << (k * 8 + j);
+                }
+            }
+        }
+        return word;
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Kernels.
+    //   binary:        dst[i] = op(lhs[i], rhs[i])
+    //   binary_scalar: dst[i] = op(lhs[i], scalar)
+    //   compare:       dst[i] = cmp(lhs[i], rhs[i])
+    //   compare_mask:  bit i of dst = cmp(lhs[i], rhs[i]), 64 compares per word (rhs is a pointer or a broadcast)
+    //   generate:      dst[i] = reader[i] (fused expression rows, the reader is inlined into each ISA variant)
+    //   fold:          *dst = op(src[0], ..., src[n - 1]), two registers of independent accumulators combined as a tree
+    //   kahan:         sum[i] += src[i] with the running compensation in comp[i] (column sums, one row at a time)
+    //   batch_gemm:    lanes independent m x k by k x n products, element e of lane l at [e * stride + l] (interleaved
+    //                  batches), accumulated in registers one vector of lanes at a time
+    // dst may alias lhs (in-place operators).
+#define TINYTOOLS_SIMD_KERNELS(suffix, target)                                                                          \
+    template <typename T, typename op_t>                                                                                \
+    target inline auto binary_##suffix(T *dst, T const *lhs, T const *rhs, std::size_t n, op_t op) noexcept -> void     \
+    {                                                                                                                   \
+        for (std::size_t i{}; i < n; ++i)                                                                               \
+        {                                                                                                               \
+            dst[i] = op(lhs[i], rhs[i]);                                                                                \
+        }                                                                                                               \
+    }                                                                                                                   \
+    template <typename T, typename op_t>                                                                                \
+    target inline auto binary_scalar_##suffix(T *dst, T const *lhs, T scalar, std::size_t n, op_t op) noexcept -> void \
+    {                                                                                                                   \
+        for (std::size_t i{}; i < n; ++i)                                                                               \
+        {                                                                                                               \
+            dst[i] = op(lhs[i], scalar);                                                                                \
+        }                                                                                                               \
+    }                                                                                                                   \
+    template <typename T, typename compare_t>                                                                           \
+    target inline auto compare_##suffix(bool *dst, T const *lhs, T const *rhs, std::size_t n, compare_t cmp) noexcept  \
+        -> void                                                                                                         \
+    {                                                                                                                   \
+        for (std::size_t i{}; i < n; ++i)                                                                               \
+        {                                                                                                               \
+            dst[i] = cmp(lhs[i], rhs[i]);                                                                               \
+        }                                                                                                               \
+    }                                                                                                                   \
+    template <typename T, typename rhs_t, typename compare_t>                                                           \
+    target inline auto compare_mask_##suffix(std::uint64_t *dst, T const *lhs, rhs_t rhs, std::size_t n, compare_t cmp) \
+        noexcept -> void                                                                                                \
+    {                                                                                                                   \
+        bool block[64]{};                                                                                               \
+        std::size_t i{};                                                                                                \
+        for (; i + 64 <= n; i += 64)                                                                                    \
+        {                                                                                                               \
+            for (std::size_t j{}; j < 64; ++j)                                                                          \
+            {                                                                                                           \
+                block[j] = cmp(lhs[i + j], rhs[i + j]);                                                                 \
+            }                                                                                                           \
+            *dst++ = packBits(block);                                                                                   \
+        }                                                                                                               \
+        if (i < n)                                                                                                      \
+        {                                                                                                               \
+            for (std::size_t j{}; j < 64; ++j)                                                                          \
+            {                                                                                                           \
+                block[j] = i + j < n && cmp(lhs[i + j], rhs[i + j]);                                                    \
+            }                                                                                                           \
+            *dst = packBits(block);                                                                                     \
+        }                                                                                                               \
+    }                                                                                                                   \
+    template <typename T, typename reader_t>                                                                            \
+    target inline auto generate_##suffix(T *dst, std::size_t n, reader_t reader) noexcept -> void                       \
+    {                                                                                                                   \
+        for (std::size_t i{}; i < n; ++i)                                                                               \
+        {                                                                                                               \
+            dst[i] = reader[i];                                                                                         \
+        }                                                                                                               \
+    }                                                                                                                   \
+    template <typename T, typename op_t>                                                                                \
+    target inline auto fold_##suffix(T *dst, T const *src, std::size_t n, op_t op) noexcept -> void                    \
+    {                                                                                                                   \
+        constexpr std::size_t lanes{std::max<std::size_t>(128 / sizeof(T), 4)};                                        \
+        std::array<T, lanes> acc{};                                                                                     \
+        acc.fill(op_t::template identity<T>());                                                                         \
+        std::size_t i{};                                                                                                \
+        for (; i < n / lanes * lanes; i += lanes)                                                                       \
+        {                                                                                                               \
+            for (std::size_t j{}; j < lanes; ++j)                                                                       \
+            {                                                                                                           \
+                acc[j] = op(acc[j], src[i + j]);                                                                        \
+            }                                                                                                           \
+        }                                                                                                               \
+        for (; i < n; ++i)                                                                                              \
+        {                                                                                                               \
+            acc[0] = op(acc[0], src[i]);                                                                                \
+        }                                                                                                               \
+        for (std::size_t width{lanes / 2}; width > 0; width /= 2)                                                       \
+        {                                                                                                               \
+            for (std::size_t j{}; j < width; ++j)                                                                       \
+            {                                                                                                           \
+                acc[j] = op(acc[j], acc[j + width]);                                                                    \
+            }                                                                                                           \
+        }                                                                                                               \
+        *dst = acc[0];                                                                                                  \
+    }                                                                                                                   \
+    template <typename T>                                                                                               \
+    target inline auto kahan_##suffix(T *sum, T *comp, T const *src, std::size_t n) noexcept -> void                    \
+    {                                                                                                                   \
+        for (std::size_t i{}; i < n; ++i)                                                                               \
+        {                                                                                                               \
+            auto const y = src[i] - comp[i];                                                                            \
+            auto const t = sum[i] + y;                                                                                  \
+            comp[i] = (t - sum[i]) - y;                                                                                 \
+            sum[i] = t;                                                                                                 \
+        }                                                                                                               \
+    }                                                                                                                   \
+    template <typename T>                                                                                               \
+    target inline auto batch_gemm_##suffix(T *c, T const *a, T const *b, std::size_t m, std::size_t n, std::size_t k,   \
+                                           std::size_t stride, std::size_t lanes) noexcept -> void                      \
+    {                                                                                                                   \
+        constexpr std::size_t width{64 / sizeof(T)};                                                                    \
+        constexpr std::size_t cols{4};                                                                                  \
+        std::size_t first{};                                                                                            \
+        for (; first + width <= lanes; first += width)                                                                  \
+        {                                                                                                               \
+            for (std::size_t i{}; i < m; ++i)                                                                           \
+            {                                                                                                           \
+                std::size_t j{};                                                                                        \
+                for (; j + cols <= n; j += cols)                                                                        \
+                {                                                                                                       \
+                    std::array<std::array<T, width>, cols> acc{};                                                       \
+                    auto const *lhs = a + i * k * stride + first;                                                       \
+                    auto const *rhs = b + j * stride + first;                                                           \
+                    for (std::size_t p{}; p < k; ++p, lhs += stride, rhs += n * stride)                                 \
+                    {                                                                                                   \
+                        for (std::size_t q{}; q < cols; ++q)                                                            \
+                        {                                                                                               \
+                            for (std::size_t l{}; l < width; ++l)                                                       \
+                            {                                                                                           \
+                                acc[q][l] = static_cast<T>(acc[q][l] + lhs[l] * rhs[q * stride + l]);                   \
+                            }                                                                                           \
+                        }                                                                                               \
+                    }                                                                                                   \
+                    for (std::size_t q{}; q < cols; ++q)                                                                \
+                    {                                                                                                   \
+                        std::copy_n(acc[q].data(), width, c + (i * n + j + q) * stride + first);                        \
+                    }                                                                                                   \
+                }                                                                                                       \
+                for (; j < n; ++j)                                                                                      \
+                {                                                                                                       \
+                    std::array<T, width> acc{};                                                                         \
+                    auto const *lhs = a + i * k * stride + first;                                                       \
+                    auto const *rhs = b + j * stride + first;                                                           \
+                    for (std::size_t p{}; p < k; ++p, lhs += stride, rhs += n * stride)                                 \
+                    {                                                                                                   \
+                        for (std::size_t l{}; l < width; ++l)                                                           \
+                        {                                                                                               \
+                            acc[l] = static_cast<T>(acc[l] + lhs[l] * rhs[l]);                                          \
+                        }                                                                                               \
+                    }                                                                                                   \
+                    std::copy_n(acc.data(), width, c + (i * n + j) * stride + first);                                   \
+                }                                                                                                       \
+            }                                                                                                           \
+        }                                                                                                               \
+        for (std::size_t e{}; e < m * n && first < lanes; ++e)                                                          \
+        {                                                                                                               \
+            auto *const out = c + e * stride;                                                                           \
+            for (std::size_t l{first}; l < lanes; ++l)                                                                  \
+            {                                                                                                           \
+                out[l] = T{};                                                                                           \
+            }                                                                                                           \
+            for (std::size_t p{}; p < k; ++p)                                                                           \
+            {                                                                                                           \
+                auto const *const lhs = a + ((e / n) * k + p) * stride;                                                 \
+                auto const *const rhs = b + (p * n + e % n) * stride;                                                   \
+                for (std::size_t l{first}; l < lanes; ++l)                                                              \
+                {                                                                                                       \
+                    out[l] = static_cast<T>(out[l] + lhs[l] * rhs[l]);                                                  \
+                }                                                                                                       \
+            }                                                                                                           \
+        }                                                                                                               \
+    }
+
+    TINYTOOLS_SIMD_KERNELS(generic, )
+#ifdef TINYTOOLS_SIMD_X86
+    TINYTOOLS_SIMD_KERNELS(sse2, __attribute__((target("sse2"))))
+    TINYTOOLS_SIMD_KERNELS(avx2, __attribute__((target("avx2"))))
+    TINYTOOLS_SIMD_KERNELS(avx512, __attribute__((target("avx512f,avx512bw,prefer-vector-width=512"))))
+#endif
+
+#undef TINYTOOLS_SIMD_KERNELS
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Dispatchers.
+#ifdef TINYTOOLS_SIMD_X86
+#define TINYTOOLS_SIMD_DISPATCH(kernel, ...)        \
+    switch (activeIsa())                            \
+    {                                               \
+    case Isa::AVX512:                               \
+        kernel##_avx512(__VA_ARGS__);               \
+        return;                                     \
+    case Isa::AVX2:                                 \
+        kernel##_avx2(__VA_ARGS__);                 \
+        return;                                     \
+    case Isa::SSE2:                                 \
+        kernel##_sse2(__VA_ARGS__);                 \
+        return;                                     \
+    case Isa::GENERIC:                              \
+        break;                                      \
+    }                                               \
+    kernel##_generic(__VA_ARGS__);
+#else
+#define TINYTOOLS_SIMD_DISPATCH(kernel, ...) kernel##_generic(__VA_ARGS__);
+#endif
+
+    template <typename T, typename op_t>
+    inline auto binary(T *dst, T const *lhs, T const *rhs, std::size_t n, op_t op) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(binary, dst, lhs, rhs, n, op)
+    }
+
+    template <typename T, typename op_t>
+    inline auto binary_scalar(T *dst, T const *lhs, T scalar, std::size_t n, op_t op) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(binary_scalar, dst, lhs, scalar, n, op)
+    }
+
+    template <typename T, typename compare_t>
+    inline auto compare(bool *dst, T const *lhs, T const *rhs, std::size_t n, compare_t cmp) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(compare, dst, lhs, rhs, n, cmp)
+    }
+
+    template <typename T, typename rhs_t, typename compare_t>
+    inline auto compare_mask(std::uint64_t *dst, T const *lhs, rhs_t rhs, std::size_t n, compare_t cmp) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(compare_mask, dst, lhs, rhs, n, cmp)
+    }
+
+    template <typename T, typename reader_t>
+    inline auto generate(T *dst, std::size_t n, reader_t reader) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(generate, dst, n, reader)
+    }
+
+    template <typename T, typename op_t>
+    inline auto fold(T *dst, T const *src, std::size_t n, op_t op) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(fold, dst, src, n, op)
+    }
+
+    template <typename T>
+    inline auto kahan(T *sum, T *comp, T const *src, std::size_t n) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(kahan, sum, comp, src, n)
+    }
+
+    template <typename T>
+    inline auto batch_gemm(T *c, T const *a, T const *b, std::size_t m, std::size_t n, std::size_t k, std::size_t stride, std::size_t lanes) noexcept -> void
+    {
+        TINYTOOLS_SIMD_DISPATCH(batch_gemm, c, a, b, m, n, k, stride, lanes)
+    }
+
+#undef TINYTOOLS_SIMD_DISPATCH
+} // namespace tinyTools::detail::simd
+
+#endif /* MATRIX_DETAIL_SIMD_HPP */
@@ -0,0 +1,328 @@
+#ifndef MATRIX_DETAIL_STRASSEN_HPP
+#define MATRIX_DETAIL_STRASSEN_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <memory>
+#include <type_traits>
+
+#include "../parallel.hpp"
+#include "gemm.hpp"
+#include "simd.hpp"
+
+// Strassen-Winograd product: 7 half-size products and 15 additions per level instead of 8 products, O(n^2.81).
+// matrix::operator* uses it for floating point operands once setMultiplyAlgorithm(MultiplyAlgorithm::STRASSEN) is set.
+//   - Recurses while every dimension is above strassenCutoff(), the blocked GEMM runs below it.
+//   - Odd dimensions are peeled: the even leading part recurses, the last row, column and k term are GEMM fix-ups.
+//   - Scratch is allocated once per product for the whole recursion: about 2/3 of the result for the sequential
+//     schedule (two temporaries per level, Boyer et al. 2009). Under Execution::PARALLEL the seven products of the top
+//     level run concurrently, each with its own operands, which takes about 4x the result instead.
+//   - The error bound is norm-wise (not element-wise like the classic product) and grows with the depth, so it is
+//     opt-in and not available for integers (whose intermediate sums can also overflow).
+//   tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::STRASSEN);
+//   auto const c = a * b; // 8192 x 8192: 5 levels with the default cutoff, leaves of 256.
+namespace tinyTools
+{
+    enum struct MultiplyAlgorithm : std::uint8_t
+    {
+        CLASSIC, // Blocked GEMM (default).
+        STRASSEN // Strassen-Winograd above the cutoff, floating point only.
+    };
+
+    namespace detail
+    {
+        inline std::atomic<MultiplyAlgorithm> g_multiplyAlgorithm{MultiplyAlgorithm::CLASSIC};
+        inline std::atomic<std::size_t> g_strassenCutoff{256};
+    } // namespace detail
+
+    inline auto setMultiplyAlgorithm(MultiplyAlgorithm algorithm) noexcept -> void { detail::g_multiplyAlgorithm.store(algorithm, std::memory_order_relaxed); }
+    [[nodiscard]] inline auto multiplyAlgorithm() noexcept -> MultiplyAlgorithm { return detail::g_multiplyAlgorithm.load(std::memory_order_relaxed); }
+
+    // Dimension at or below which the recursion stops. Lower cutoffs trade GEMM time for memory-bound additions.
+    inline auto setStrassenCutoff(std::size_t cutoff) noexcept -> void { detail::g_strassenCutoff.store(std::max<std::size_t>(cutoff, 16), std::memory_order_relaxed); }
+    [[nodiscard]] inline auto strassenCutoff() noexcept -> std::size_t { return detail::g_strassenCutoff.load(std::memory_order_relaxed); }
+} // namespace tinyTools
+
+namespace tinyTools::detail
+{
+    [[nodiscard]] inline auto strassenRecurses(std::size_t m, std::size_t n, std::size_t k, std::size_t cutoff) noexcept -> bool
+    {
+        return std::min({m, n, k}) > cutoff;
+    }
+
+    // Scratch of the sequential schedule: X (m/2 x max(k/2, n/2)) and Y (k/2 x n/2) at every level.
+    [[nodiscard]] inline auto strassenScratch(std::size_t m, std::size_t n, std::size_t k, std::size_t cutoff) noexcept -> std::size_t
+    {
+        std::size_t total{};
+        for (; strassenRecurses(m, n, k, cutoff); m /= 2, n /= 2, k /= 2)
+        {
+            total += m / 2 * std::max(k / 2, n / 2) + k / 2 * n / 2;
+        }
+        return total;
+    }
+
+    // Scratch of the parallel top level: P1, P2 and P4, the eight operand sums and one sequential scratch per product.
+    [[nodiscard]] inline auto strassenParallelScratch(std::size_t m, std::size_t n, std::size_t k, std::size_t cutoff) noexcept -> std::size_t
+    {
+        auto const m2 = m / 2;
+        auto const n2 = n / 2;
+        auto const k2 = k / 2;
+        return 3 * m2 * n2 + 4 * m2 * k2 + 4 * k2 * n2 + 7 * strassenScratch(m2, n2, k2, cutoff);
+    }
+
+    template <typename T>
+    [[nodiscard]] inline auto readOnly(gemm_operand<T> op) noexcept -> gemm_operand<T const>
+    {
+        return {op.ptr, op.rs, op.cs};
+    }
+
+    // Block (i, j) of an operand cut in rows x cols blocks.
+    template <typename T>
+    [[nodiscard]] inline auto quadrant(gemm_operand<T> op, std::size_t i, std::size_t j, std::size_t rows, std::size_t cols) noexcept -> gemm_operand<T>
+    {
+        return {&op(i * rows, j * cols), op.rs, op.cs};
+    }
+
+    // dst = op(lhs, rhs), dst may alias either side.
+    template <typename T, typename op_t>
+    inline auto strassenCombine(std::size_t rows, std::size_t cols, gemm_operand<T> dst, gemm_operand<T const> lhs, gemm_operand<T const> rhs, op_t op) noexcept -> void
+    {
+        for (std::size_t r{}; r < rows; ++r)
+        {
+            if (dst.cs == 1 && lhs.cs == 1 && rhs.cs == 1)
+            {
+                simd::binary(&dst(r, 0), &lhs(r, 0), &rhs(r, 0), cols, op);
+                continue;
+            }
+            for (std::size_t c{}; c < cols; ++c)
+            {
+                dst(r, c) = op(lhs(r, c), rhs(r, c));
+            }
+        }
+    }
+
+    // C holds P3 (C11), P6 (C12), P7 (C21) and P5 (C22), the last seven additions of Winograd's form:
+    //   C11 = P1 + P2, C12 = P1 + P6 + P5 + P3, C21 = P1 + P6 + P7 - P4, C22 = P1 + P6 + P7 + P5.
+    template <typename T>
+    inline auto strassenFinish(std::size_t m2, std::size_t n2, gemm_operand<T> c, gemm_operand<T const> p1, gemm_operand<T const> p2, gemm_operand<T const> p4) noexcept -> void
+    {
+        auto const c11 = quadrant(c, 0, 0, m2, n2);
+        auto const c12 = quadrant(c, 0, 1, m2, n2);
+        auto const c21 = quadrant(c, 1, 0, m2, n2);
+        auto const c22 = quadrant(c, 1, 1, m2, n2);
+        strassenCombine(m2, n2, c12, p1, readOnly(c12), simd::add{});            // U2 = P1 + P6
+        strassenCombine(m2, n2, c21, readOnly(c12), readOnly(c21), simd::add{}); // U3 = U2 + P7
+        strassenCombine(m2, n2, c12, readOnly(c12), readOnly(c22), simd::add{}); // U4 = U2 + P5
+        strassenCombine(m2, n2, c22, readOnly(c21), readOnly(c22), simd::add{}); // U7 = U3 + P5
+        strassenCombine(m2, n2, c12, readOnly(c12), readOnly(c11), simd::add{}); // U5 = U4 + P3
+        strassenCombine(m2, n2, c21, readOnly(c21), p4, simd::sub{});            // U6 = U3 - P4
+        strassenCombine(m2, n2, c11, p1, p2, simd::add{});                       // U1 = P1 + P2
+    }
+
+    template <typename T>
+    inline auto strassenPeeled(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c, T *scratch,
+                               std::size_t cutoff, bool parallel) -> void;
+
+    // C(m x n) = A(m x k) * B(k x n), recursing while the shape is above the cutoff.
+    template <typename T>
+    inline auto strassenProduct(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c, T *scratch,
+                                std::size_t cutoff) -> void
+    {
+        if (!strassenRecurses(m, n, k, cutoff))
+        {
+            gemm<T>(m, n, k, T{1}, a, b, T{}, c);
+            return;
+        }
+        strassenPeeled(m, n, k, a, b, c, scratch, cutoff, false);
+    }
+
+    // One level on even dimensions, sequential schedule with two temporaries: X holds the A sums and then P1, Y the B
+    // sums, every other product goes straight to a quadrant of C.
+    template <typename T>
+    inline auto strassenLevel(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c, T *scratch,
+                              std::size_t cutoff) -> void
+    {
+        auto const m2 = m / 2;
+        auto const n2 = n / 2;
+        auto const k2 = k / 2;
+        auto const a11 = quadrant(a, 0, 0, m2, k2);
+        auto const a12 = quadrant(a, 0, 1, m2, k2);
+        auto const a21 = quadrant(a, 1, 0, m2, k2);
+        auto const a22 = quadrant(a, 1, 1, m2, k2);
+        auto const b11 = quadrant(b, 0, 0, k2, n2);
+        auto const b12 = quadrant(b, 0, 1, k2, n2);
+        auto const b21 = quadrant(b, 1, 0, k2, n2);
+        auto const b22 = quadrant(b, 1, 1, k2, n2);
+        auto const c11 = quadrant(c, 0, 0, m2, n2);
+        auto const c12 = quadrant(c, 0, 1, m2, n2);
+        auto const c21 = quadrant(c, 1, 0, m2, n2);
+        auto const c22 = quadrant(c, 1, 1, m2, n2);
+
+        gemm_operand<T> const xs{scratch, k2, 1};
+        gemm_operand<T> const xp{scratch, n2, 1};
+        gemm_operand<T> const y{scratch + m2 * std::max(k2, n2), n2, 1};
+        auto *const child = y.ptr + k2 * n2;
+
+        strassenCombine(m2, k2, xs, a11, a21, simd::sub{});                         // S3 = A11 - A21
+        strassenCombine(k2, n2, y, b22, b12, simd::sub{});                          // T3 = B22 - B12
+        strassenProduct(m2, n2, k2, readOnly(xs), readOnly(y), c21, child, cutoff); // P7 = S3 * T3
+        strassenCombine(m2, k2, xs, a21, a22, simd::add{});                         // S1 = A21 + A22
+        strassenCombine(k2, n2, y, b12, b11, simd::sub{});                          // T1 = B12 - B11
+        strassenProduct(m2, n2, k2, readOnly(xs), readOnly(y), c22, child, cutoff); // P5 = S1 * T1
+        strassenCombine(m2, k2, xs, readOnly(xs), a11, simd::sub{});                // S2 = S1 - A11
+        strassenCombine(k2, n2, y, b22, readOnly(y), simd::sub{});                  // T2 = B22 - T1
+        strassenProduct(m2, n2, k2, readOnly(xs), readOnly(y), c12, child, cutoff); // P6 = S2 * T2
+        strassenCombine(m2, k2, xs, a12, readOnly(xs), simd::sub{});                // S4 = A12 - S2
+        strassenProduct(m2, n2, k2, readOnly(xs), b22, c11, child, cutoff);         // P3 = S4 * B22
+        strassenProduct(m2, n2, k2, a11, b11, xp, child, cutoff);                   // P1 = A11 * B11
+        strassenCombine(m2, n2, c12, readOnly(xp), readOnly(c12), simd::add{});     // U2 = P1 + P6
+        strassenCombine(m2, n2, c21, readOnly(c12), readOnly(c21), simd::add{});    // U3 = U2 + P7
+        strassenCombine(m2, n2, c12, readOnly(c12), readOnly(c22), simd::add{});    // U4 = U2 + P5
+        strassenCombine(m2, n2, c22, readOnly(c21), readOnly(c22), simd::add{});    // U7 = U3 + P5
+        strassenCombine(m2, n2, c12, readOnly(c12), readOnly(c11), simd::add{});    // U5 = U4 + P3
+        strassenCombine(k2, n2, y, readOnly(y), b21, simd::sub{});                  // T4 = T2 - B21
+        strassenProduct(m2, n2, k2, a22, readOnly(y), c11, child, cutoff);          // P4 = A22 * T4
+        strassenCombine(m2, n2, c21, readOnly(c21), readOnly(c11), simd::sub{});    // U6 = U3 - P4
+        strassenProduct(m2, n2, k2, a12, b21, c11, child, cutoff);                  // P2 = A12 * B21
+        strassenCombine(m2, n2, c11, readOnly(xp), readOnly(c11), simd::add{});     // U1 = P1 + P2
+    }
+
+    // One level on even dimensions with the seven products running concurrently, each on its own operands.
+    template <typename T>
+    inline auto strassenParallelLevel(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c,
+                                      T *scratch, std::size_t cutoff) -> void
+    {
+        auto const m2 = m / 2;
+        auto const n2 = n / 2;
+        auto const k2 = k / 2;
+        auto const a11 = quadrant(a, 0, 0, m2, k2);
+        auto const a12 = quadrant(a, 0, 1, m2, k2);
+        auto const a21 = quadrant(a, 1, 0, m2, k2);
+        auto const a22 = quadrant(a, 1, 1, m2, k2);
+        auto const b11 = quadrant(b, 0, 0, k2, n2);
+        auto const b12 = quadrant(b, 0, 1, k2, n2);
+        auto const b21 = quadrant(b, 1, 0, k2, n2);
+        auto const b22 = quadrant(b, 1, 1, k2, n2);
+
+        auto *next = scratch;
+        auto take = [&next](std::size_t rows, std::size_t cols)
+        {
+            gemm_operand<T> const ret{next, cols, 1};
+            next += rows * cols;
+            return ret;
+        };
+        auto const p1 = take(m2, n2);
+        auto const p2 = take(m2, n2);
+        auto const p4 = take(m2, n2);
+        auto const s1 = take(m2, k2);
+        auto const s2 = take(m2, k2);
+        auto const s3 = take(m2, k2);
+        auto const s4 = take(m2, k2);
+        auto const t1 = take(k2, n2);
+        auto const t2 = take(k2, n2);
+        auto const t3 = take(k2, n2);
+        auto const t4 = take(k2, n2);
+
+        strassenCombine(m2, k2, s1, a21, a22, simd::add{});
+        strassenCombine(m2, k2, s2, readOnly(s1), a11, simd::sub{});
+        strassenCombine(m2, k2, s3, a11, a21, simd::sub{});
+        strassenCombine(m2, k2, s4, a12, readOnly(s2), simd::sub{});
+        strassenCombine(k2, n2, t1, b12, b11, simd::sub{});
+        strassenCombine(k2, n2, t2, b22, readOnly(t1), simd::sub{});
+        strassenCombine(k2, n2, t3, b22, b12, simd::sub{});
+        strassenCombine(k2, n2, t4, readOnly(t2), b21, simd::sub{});
+
+        struct product
+        {
+            gemm_operand<T const> lhs;
+            gemm_operand<T const> rhs;
+            gemm_operand<T> out;
+        };
+        std::array<product, 7> const products{{{a11, b11, p1},
+                                               {a12, b21, p2},
+                                               {readOnly(s4), b22, quadrant(c, 0, 0, m2, n2)},
+                                               {a22, readOnly(t4), p4},
+                                               {readOnly(s1), readOnly(t1), quadrant(c, 1, 1, m2, n2)},
+                                               {readOnly(s2), readOnly(t2), quadrant(c, 0, 1, m2, n2)},
+                                               {readOnly(s3), readOnly(t3), quadrant(c, 1, 0, m2, n2)}}};
+        auto const childScratch = strassenScratch(m2, n2, k2, cutoff);
+        // par (not par_unseq): the leaf GEMMs resize their thread_local packing buffers.
+        with_workers([&]
+                     { std::for_each(std::execution::par, products.begin(), products.end(),
+                                     [&](product const &p)
+                                     {
+                                         auto const i = static_cast<std::size_t>(&p - products.data());
+                                         strassenProduct(m2, n2, k2, p.lhs, p.rhs, p.out, next + i * childScratch, cutoff);
+                                     }); });
+
+        strassenFinish(m2, n2, c, readOnly(p1), readOnly(p2), readOnly(p4));
+    }
+
+    template <typename T>
+    inline auto strassenPeeled(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c, T *scratch,
+                               std::size_t cutoff, bool parallel) -> void
+    {
+        auto const me = m / 2 * 2;
+        auto const ne = n / 2 * 2;
+        auto const ke = k / 2 * 2;
+        if (parallel)
+        {
+            strassenParallelLevel(me, ne, ke, a, b, c, scratch, cutoff);
+        }
+        else
+        {
+            strassenLevel(me, ne, ke, a, b, c, scratch, cutoff);
+        }
+        if (ke != k)
+        {
+            // Last k term: rank-1 update of the even block.
+            gemm<T>(me, ne, 1, T{1}, {&a(0, ke), a.rs, a.cs}, {&b(ke, 0), b.rs, b.cs}, T{1}, c);
+        }
+        if (ne != n)
+        {
+            gemm<T>(m, 1, k, T{1}, a, {&b(0, ne), b.rs, b.cs}, T{}, {&c(0, ne), c.rs, c.cs});
+        }
+        if (me != m)
+        {
+            gemm<T>(1, ne, k, T{1}, {&a(me, 0), a.rs, a.cs}, b, T{}, {&c(me, 0), c.rs, c.cs});
+        }
+    }
+
+    // C(m x n) = A(m x k) * B(k x n) with Strassen-Winograd above strassenCutoff().
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    inline auto strassen(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c) -> void
+    {
+        auto const cutoff = strassenCutoff();
+        if (!strassenRecurses(m, n, k, cutoff))
+        {
+            gemm<T>(m, n, k, T{1}, a, b, T{}, c);
+            return;
+        }
+        auto const parallel = threadCount() > 1 && runParallel(m * n);
+        // Uninitialized: every scratch element is written before it is read.
+        auto const scratch = std::make_unique_for_overwrite<T[]>(parallel ? strassenParallelScratch(m, n, k, cutoff) : strassenScratch(m, n, k, cutoff));
+        strassenPeeled(m, n, k, a, b, c, scratch.get(), cutoff, parallel);
+    }
+
+    // C = A * B with the algorithm of setMultiplyAlgorithm(), every matrix and view product goes through here.
+    template <typename T>
+    inline auto multiply(std::size_t m, std::size_t n, std::size_t k, gemm_operand<T const> a, gemm_operand<T const> b, gemm_operand<T> c) -> void
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (multiplyAlgorithm() == MultiplyAlgorithm::STRASSEN)
+            {
+                strassen<T>(m, n, k, a, b, c);
+                return;
+            }
+        }
+        gemm<T>(m, n, k, T{1}, a, b, T{}, c);
+    }
+} // namespace tinyTools::detail
+
+#endif /* MATRIX_DETAIL_STRASSEN_HPP */
@@ -0,0 +1,218 @@
+#ifndef MATRIX_DETAIL_TEXT_HPP
+#define MATRIX_DETAIL_TEXT_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <ios>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Text formatting and parsing primitives: values are formatted with std::to_chars into a large buffer that reaches the
+// stream in a few big writes, and parsed back with std::from_chars (no locale, no allocation per value).
+namespace tinyTools::detail
+{
+    inline constexpr std::size_t textBufferSize{std::size_t{1} << 16U};
+
+    // Character types print as characters through operator<<, the text I/O writes every integral type as a number.
+    template <typename T>
+    inline constexpr bool is_character_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+                                           std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t> ||
+                                           std::is_same_v<T, char32_t>;
+
+    // Floating point format, precision < 0 is the shortest text that reads back to the same value.
+    struct float_format
+    {
+        std::chars_format format{std::chars_format::general};
+        int precision{-1};
+    };
+
+    // Same text as std::ostream for the stream state, or false when the stream uses flags to_chars can not reproduce.
+    [[nodiscard]] inline auto streamFloatFormat(std::ostream const &os, float_format &format) noexcept -> bool
+    {
+        auto const flags = os.flags();
+        if (os.width() != 0 || (flags & (std::ios::showpos | std::ios::showpoint | std::ios::uppercase | std::ios::showbase | std::ios::boolalpha)) ||
+            ((flags & std::ios::basefield) != std::ios::dec && (flags & std::ios::basefield) != std::ios::fmtflags{}))
+        {
+            return false;
+        }
+        auto const floatfield = flags & std::ios::floatfield;
+        if (floatfield == std::ios::floatfield)
+        {
+            return false; // hexfloat prints a 0x prefix.
+        }
+        format.format = floatfield == std::ios::fixed ? std::chars_format::fixed : floatfield == std::ios::scientific ? std::chars_format::scientific : std::chars_format::general;
+        format.precision = static_cast<int>(os.precision());
+        return true;
+    }
+
+    // Buffered writer, flush() hands the buffer to the stream.
+    struct text_writer
+    {
+        explicit text_writer(std::ostream &os)
+            : os_{os}
+        {
+            buffer_.resize(textBufferSize);
+        }
+
+        text_writer(text_writer const &) = delete;
+        auto operator=(text_writer const &) -> text_writer & = delete;
+
+        inline auto put(char c) -> void
+        {
+            if (used_ == buffer_.size())
+            {
+                flush();
+            }
+            buffer_[used_++] = c;
+        }
+
+        // False when the value does not fit in an empty buffer (huge fixed precision), the caller falls back to the stream.
+        template <typename T>
+        [[nodiscard]] inline auto put(T value, float_format const &format) -> bool
+        {
+            for (auto retry{0}; retry < 2; ++retry)
+            {
+                auto *const first = buffer_.data() + used_;
+                auto *const last = buffer_.data() + buffer_.size();
+                std::to_chars_result result{};
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    result = std::to_chars(first, last, static_cast<int>(value));
+                }
+                else if constexpr (std::is_integral_v<T>)
+                {
+                    using wide_t = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+                    result = std::to_chars(first, last, static_cast<wide_t>(value));
+                }
+                else if (format.precision < 0)
+                {
+                    result = std::to_chars(first, last, value);
+                }
+                else
+                {
+                    result = std::to_chars(first, last, value, format.format, format.precision);
+                }
+                if (result.ec == std::errc{})
+                {
+                    used_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+                    return true;
+                }
+                flush();
+            }
+            return false;
+        }
+
+        inline auto flush() -> void
+        {
+            os_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+            used_ = 0;
+        }
+
+    private:
+        std::ostream &os_;
+        std::string buffer_{};
+        std::size_t used_{};
+    };
+
+    // Writes rows x cols values of a strided view: separator between columns, newline after every row.
+    template <typename view_t>
+    inline auto writeRows(std::ostream &os, view_t const &rhv, char separator, float_format const &format) -> void
+    {
+        text_writer writer{os};
+        for (std::size_t r{}; r < rhv.rows(); ++r)
+        {
+            for (std::size_t c{}; c < rhv.cols(); ++c)
+            {
+                if (!writer.put(rhv.unchecked(r, c), format))
+                {
+                    os << rhv.unchecked(r, c);
+                }
+                writer.put(c + 1 == rhv.cols() ? '\n' : separator);
+            }
+        }
+        writer.flush();
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Parsing.
+    [[nodiscard]] inline constexpr auto isTextSeparator(char c) noexcept -> bool { return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r'; }
+
+    [[noreturn]] inline auto throwParseError(std::string_view token, std::size_t line, std::errc ec) -> void
+    {
+        auto const message = "\"" + std::string{token} + "\" at line " + std::to_string(line);
+        if (ec == std::errc::result_out_of_range)
+        {
+            throw std::out_of_range("Value out of range: " + message + "!\n");
+        }
+        throw std::invalid_argument("Can not parse value: " + message + "!\n");
+    }
+
+    // Parses the token [first, last) completely into value.
+    template <typename T>
+    inline auto parseValue(char const *first, char const *last, T &value, std::size_t line) -> void
+    {
+        std::string_view const token{first, static_cast<std::size_t>(last - first)};
+        if (first != last && *first == '+')
+        {
+            ++first; // from_chars does not take the sign.
+        }
+
+        std::from_chars_result result{};
+        if constexpr (std::is_integral_v<T>)
+        {
+            using wide_t = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+            wide_t wide{};
+            result = std::from_chars(first, last, wide);
+            if (result.ec == std::errc{} && (std::is_same_v<T, bool> ? wide > 1
+                                                                            : (wide < static_cast<wide_t>(std::numeric_limits<T>::lowest()) ||
+                                                                               wide > static_cast<wide_t>(std::numeric_limits<T>::max()))))
+            {
+                result.ec = std::errc::result_out_of_range;
+            }
+            value = static_cast<T>(wide);
+        }
+        else
+        {
+            result = std::from_chars(first, last, value);
+        }
+        if (result.ec != std::errc{} || result.ptr != last)
+        {
+            throwParseError(token, line, result.ec);
+        }
+    }
+
+    // Calls func(value) for every value of a line, returns the amount of values.
+    template <typename T, typename func_t>
+    inline auto parseLine(std::string_view text, std::size_t line, func_t func) -> std::size_t
+    {
+        std::size_t count{};
+        auto const *ptr = text.data();
+        auto const *const end = ptr + text.size();
+        while (ptr != end)
+        {
+            if (isTextSeparator(*ptr))
+            {
+                ++ptr;
+                continue;
+            }
+            auto const *tokenEnd = ptr;
+            while (tokenEnd != end && !isTextSeparator(*tokenEnd))
+            {
+                ++tokenEnd;
+            }
+            T value{};
+            parseValue(ptr, tokenEnd, value, line);
+            func(value);
+            ++count;
+            ptr = tokenEnd;
+        }
+        return count;
+    }
+} // namespace tinyTools::detail
+
+#endif /* MATRIX_DETAIL_TEXT_HPP */
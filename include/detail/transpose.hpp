@@ -0,0 +1,147 @@
+#ifndef MATRIX_DETAIL_TRANSPOSE_HPP
+#define MATRIX_DETAIL_TRANSPOSE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../parallel.hpp"
+
+// Transpose kernels over row-major storage.
+//   transpose:          out-of-place, tiled so both the reads and the writes stay inside a few cache lines per tile.
+//   transpose_square:   in place, tile (i, j) is swapped with tile (j, i), every pair belongs to one chunk.
+//   transpose_inplace:  in place for any shape, follows the permutation cycles k -> k * rows mod (n - 1).
+namespace tinyTools::detail
+{
+    // 32 x 32 tile: 4 KiB of floats, the tile lines of both sides stay in L1.
+    inline constexpr std::size_t transposeTile{32};
+
+    // The in-place swap stages its two tiles in contiguous local buffers: swapping element by element walks both tiles
+    // column-wise, through the buffers both sides of the matrix are read and written row by row.
+    template <typename T>
+    using transpose_buffer = std::array<T, transposeTile * transposeTile>;
+
+    // buffer(c, r) = src(r0 + r, c0 + c), h x w tile.
+    template <typename T>
+    inline auto load_tile_transposed(T const *src, std::size_t lds, std::size_t h, std::size_t w, transpose_buffer<T> &buffer) noexcept -> void
+    {
+        for (std::size_t r{}; r < h; ++r)
+        {
+            for (std::size_t c{}; c < w; ++c)
+            {
+                buffer[c * transposeTile + r] = src[r * lds + c];
+            }
+        }
+    }
+
+    // dst(r, c) = buffer(r, c), rows of the buffer are h wide.
+    template <typename T>
+    inline auto store_tile(T *dst, std::size_t ldd, std::size_t w, std::size_t h, transpose_buffer<T> const &buffer) noexcept -> void
+    {
+        for (std::size_t r{}; r < w; ++r)
+        {
+            std::copy_n(buffer.data() + r * transposeTile, h, dst + r * ldd);
+        }
+    }
+
+    // dst(c, r) = src(r, c), src is rows x cols with leading dimension lds, dst is cols x rows with leading dimension ldd.
+    // Direct tile copy, the inner loop writes dst rows contiguously and reads a tile column (the tile lines stay in L1).
+    template <typename T>
+    inline auto transpose(T const *src, std::size_t rows, std::size_t cols, std::size_t lds, T *dst, std::size_t ldd) -> void
+    {
+        auto const tileRows = (rows + transposeTile - 1) / transposeTile;
+        for_each_chunk(tileRows, transposeTile * cols, [=](std::size_t begin, std::size_t end)
+                       {
+                           for (auto ti{begin}; ti < end; ++ti)
+                           {
+                               auto const r0 = ti * transposeTile;
+                               auto const r1 = std::min(r0 + transposeTile, rows);
+                               for (std::size_t c0{}; c0 < cols; c0 += transposeTile)
+                               {
+                                   auto const c1 = std::min(c0 + transposeTile, cols);
+                                   for (auto c{c0}; c < c1; ++c)
+                                   {
+                                       for (auto r{r0}; r < r1; ++r)
+                                       {
+                                           dst[c * ldd + r] = src[r * lds + c];
+                                       }
+                                   }
+                               }
+                           }
+                       });
+    }
+
+    // Square n x n block with leading dimension ld.
+    template <typename T>
+    inline auto transpose_square(T *data, std::size_t n, std::size_t ld) -> void
+    {
+        auto const tiles = (n + transposeTile - 1) / transposeTile;
+        for_each_chunk(tiles, transposeTile * n / 2, [=](std::size_t begin, std::size_t end)
+                       {
+                           transpose_buffer<T> upper{};
+                           transpose_buffer<T> lower{};
+                           for (auto ti{begin}; ti < end; ++ti)
+                           {
+                               auto const r0 = ti * transposeTile;
+                               auto const h = std::min(transposeTile, n - r0);
+                               // Diagonal tile: swap the upper triangle with the lower one.
+                               for (auto r{r0}; r < r0 + h; ++r)
+                               {
+                                   for (auto c{r + 1}; c < r0 + h; ++c)
+                                   {
+                                       std::swap(data[r * ld + c], data[c * ld + r]);
+                                   }
+                               }
+                               // Off diagonal tiles right of the diagonal, swapped with their mirror below it.
+                               for (auto c0{r0 + transposeTile}; c0 < n; c0 += transposeTile)
+                               {
+                                   auto const w = std::min(transposeTile, n - c0);
+                                   load_tile_transposed(data + r0 * ld + c0, ld, h, w, upper);
+                                   load_tile_transposed(data + c0 * ld + r0, ld, w, h, lower);
+                                   store_tile(data + r0 * ld + c0, ld, h, w, lower);
+                                   store_tile(data + c0 * ld + r0, ld, w, h, upper);
+                               }
+                           }
+                       });
+    }
+
+    // rows x cols (contiguous) becomes cols x rows in the same buffer. Square shapes take the tiled swap, the rest follow
+    // the cycles of the permutation with one visited bit per element.
+    template <typename T>
+    inline auto transpose_inplace(T *data, std::size_t rows, std::size_t cols) -> void
+    {
+        if (rows == cols)
+        {
+            transpose_square(data, rows, cols);
+            return;
+        }
+        if (rows == 1 || cols == 1)
+        {
+            return;
+        }
+
+        // Element k = r * cols + c goes to c * rows + r = k * rows mod (n - 1), the first and last ones stay.
+        auto const last = rows * cols - 1;
+        std::vector<bool> visited(last + 1);
+        for (std::size_t start{1}; start < last; ++start)
+        {
+            if (visited[start])
+            {
+                continue;
+            }
+            auto k = start;
+            auto carry = std::move(data[start]);
+            do
+            {
+                auto const next = k * rows % last;
+                std::swap(carry, data[next]);
+                visited[next] = true;
+                k = next;
+            } while (k != start);
+        }
+    }
+} // namespace tinyTools::detail
+
+#endif /* MATRIX_DETAIL_TRANSPOSE_HPP */
@@ -0,0 +1,236 @@
+#ifndef FIXED_MATRIX_HPP
+#define FIXED_MATRIX_HPP
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "matrix.hpp"
+
+namespace tinyTools
+{
+    // Compile-time shaped matrix for small transforms (2x2, 3x3, 4x4, ...).
+    // Storage is an inline std::array (no heap), every operation is constexpr and the products are unrolled.
+    // Shapes are part of the type, so a product with mismatched inner dimensions does not compile.
+    // Interop with the dynamic API goes through view() (matrix_view) and toMatrix().
+    template <numerical T, std::size_t Rows, std::size_t Cols>
+        requires(Rows > 0 && Cols > 0)
+    struct fixed_matrix
+    {
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        using value = T;
+        using reference = value &;
+        using const_reference = value const &;
+        using size_type = std::size_t;
+        using container_type = std::array<T, Rows * Cols>;
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Ctors.
+        inline constexpr fixed_matrix() noexcept = default;
+
+        inline explicit constexpr fixed_matrix(T const &initialValue) noexcept { data_.fill(initialValue); }
+
+        inline explicit constexpr fixed_matrix(container_type const &data) noexcept
+            : data_{data}
+        {
+        }
+
+        // Row-major values, the amount of values must match the shape.
+        template <typename... args_t>
+            requires(sizeof...(args_t) == Rows * Cols && (std::is_convertible_v<args_t, T> && ...))
+        inline constexpr fixed_matrix(args_t... values) noexcept
+            : data_{static_cast<T>(values)...}
+        {
+        }
+
+        template <typename Allocator>
+        inline explicit constexpr fixed_matrix(matrix<T, Allocator> const &rhm)
+        {
+            if (rhm.rows() != Rows || rhm.cols() != Cols)
+            {
+                throw std::invalid_argument(std::string{"Matrix must be " + std::to_string(Rows) + "x" + std::to_string(Cols) + "!\n"});
+            }
+            for (size_type i{}; i < Rows * Cols; ++i)
+            {
+                data_[i] = rhm.unchecked(i);
+            }
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Getters.
+        [[nodiscard]] inline constexpr auto data() const noexcept -> container_type const & { return data_; }
+        [[nodiscard]] inline static constexpr auto rows() noexcept -> size_type { return Rows; }
+        [[nodiscard]] inline static constexpr auto cols() noexcept -> size_type { return Cols; }
+        [[nodiscard]] inline static constexpr auto totalSize() noexcept -> size_type { return Rows * Cols; }
+
+        [[nodiscard]] inline constexpr auto view() const noexcept -> matrix_view<T const> { return matrix_view<T const>{data_.data(), Rows, Cols}; }
+        [[nodiscard]] inline constexpr auto view() noexcept -> matrix_view<T> { return matrix_view<T>{data_.data(), Rows, Cols}; }
+        [[nodiscard]] inline auto toMatrix() const -> matrix<T> { return matrix<T>{view()}; }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Operators.
+        [[nodiscard]] inline constexpr auto operator()(size_type r, size_type c) const -> const_reference { return op_parenthesis(*this, r, c); }
+        inline constexpr auto operator()(size_type r, size_type c) -> reference { return op_parenthesis(*this, r, c); }
+
+        inline constexpr auto operator[](size_type idx) const -> const_reference { return op_sqBracket(*this, idx); }
+        [[nodiscard]] inline constexpr auto operator[](size_type idx) -> reference { return op_sqBracket(*this, idx); }
+
+        // Compile-time checked access.
+        template <size_type R, size_type C>
+            requires(R < Rows && C < Cols)
+        [[nodiscard]] inline constexpr auto get() const noexcept -> const_reference { return data_[R * Cols + C]; }
+        template <size_type R, size_type C>
+            requires(R < Rows && C < Cols)
+        [[nodiscard]] inline constexpr auto get() noexcept -> reference { return data_[R * Cols + C]; }
+
+        [[nodiscard]] inline constexpr auto operator==(fixed_matrix const &rhm) const noexcept -> bool { return data_ == rhm.data_; }
+        [[nodiscard]] inline constexpr auto operator!=(fixed_matrix const &rhm) const noexcept -> bool { return !(operator==(rhm)); }
+
+        inline constexpr auto operator+=(fixed_matrix const &rhm) noexcept -> fixed_matrix & { return apply(rhm, detail::simd::add{}); }
+        [[nodiscard]] friend constexpr auto operator+(fixed_matrix lhm, fixed_matrix const &rhm) noexcept -> fixed_matrix { return lhm += rhm; }
+
+        inline constexpr auto operator+=(T const &scalar) noexcept -> fixed_matrix & { return apply(scalar, detail::simd::add{}); }
+        [[nodiscard]] friend constexpr auto operator+(fixed_matrix lhm, T const &scalar) noexcept -> fixed_matrix { return lhm += scalar; }
+
+        inline constexpr auto operator-=(fixed_matrix const &rhm) noexcept -> fixed_matrix & { return apply(rhm, detail::simd::sub{}); }
+        [[nodiscard]] friend constexpr auto operator-(fixed_matrix lhm, fixed_matrix const &rhm) noexcept -> fixed_matrix { return lhm -= rhm; }
+
+        inline constexpr auto operator-=(T const &scalar) noexcept -> fixed_matrix & { return apply(scalar, detail::simd::sub{}); }
+        [[nodiscard]] friend constexpr auto operator-(fixed_matrix lhm, T const &scalar) noexcept -> fixed_matrix { return lhm -= scalar; }
+
+        inline constexpr auto operator*=(T const &scalar) noexcept -> fixed_matrix & { return apply(scalar, detail::simd::mul{}); }
+        [[nodiscard]] friend constexpr auto operator*(fixed_matrix lhm, T const &scalar) noexcept -> fixed_matrix { return lhm *= scalar; }
+        [[nodiscard]] friend constexpr auto operator*(T const &scalar, fixed_matrix rhm) noexcept -> fixed_matrix { return rhm *= scalar; }
+
+        // Matrix product, the inner dimension is checked by the type system.
+        template <size_type OtherCols>
+        [[nodiscard]] inline constexpr auto operator*(fixed_matrix<T, Cols, OtherCols> const &rhm) const noexcept -> fixed_matrix<T, Rows, OtherCols>
+        {
+            fixed_matrix<T, Rows, OtherCols> ret{};
+            for (size_type r{}; r < Rows; ++r)
+            {
+                for (size_type c{}; c < OtherCols; ++c)
+                {
+                    ret.data_[r * OtherCols + c] = dot(r, rhm, c, std::make_index_sequence<Cols>{});
+                }
+            }
+            return ret;
+        }
+
+        // Mixed products with the dynamic matrix (runtime shape check).
+        [[nodiscard]] friend inline auto operator*(fixed_matrix const &lhm, matrix<T> const &rhm) -> matrix<T> { return lhm.view() * rhm; }
+        [[nodiscard]] friend inline auto operator*(matrix<T> const &lhm, fixed_matrix const &rhm) -> matrix<T> { return lhm * rhm.view(); }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Methods.
+        [[nodiscard]] inline static constexpr auto identity() noexcept -> fixed_matrix
+            requires(Rows == Cols)
+        {
+            fixed_matrix ret{};
+            for (size_type i{}; i < Rows; ++i)
+            {
+                ret.data_[i * Cols + i] = T{1};
+            }
+            return ret;
+        }
+
+        [[nodiscard]] inline constexpr auto transpose() const noexcept -> fixed_matrix<T, Cols, Rows>
+        {
+            fixed_matrix<T, Cols, Rows> ret{};
+            for (size_type r{}; r < Rows; ++r)
+            {
+                for (size_type c{}; c < Cols; ++c)
+                {
+                    ret.data_[c * Rows + r] = data_[r * Cols + c];
+                }
+            }
+            return ret;
+        }
+
+        [[nodiscard]] inline static constexpr auto ones() noexcept -> fixed_matrix { return fixed_matrix{T{1}}; }
+        [[nodiscard]] inline static constexpr auto zeros() noexcept -> fixed_matrix { return fixed_matrix{T{}}; }
+
+        // Multiply point by point. (Matlab: .*)
+        inline constexpr auto multiply(fixed_matrix const &rhm) noexcept -> void { apply(rhm, detail::simd::mul{}); }
+        [[nodiscard]] friend constexpr auto multiply(fixed_matrix lhm, fixed_matrix const &rhm) noexcept -> fixed_matrix
+        {
+            lhm.multiply(rhm);
+            return lhm;
+        }
+
+        template <numerical L_T, std::size_t L_R, std::size_t L_C>
+            requires(L_R > 0 && L_C > 0)
+        friend struct fixed_matrix;
+
+    private:
+        container_type data_{};
+
+        template <typename op_t>
+        inline constexpr auto apply(fixed_matrix const &rhm, op_t op) noexcept -> fixed_matrix &
+        {
+            for (size_type i{}; i < Rows * Cols; ++i)
+            {
+                data_[i] = op(data_[i], rhm.data_[i]);
+            }
+            return *this;
+        }
+
+        template <typename op_t>
+        inline constexpr auto apply(T const &scalar, op_t op) noexcept -> fixed_matrix &
+        {
+            for (auto &d : data_)
+            {
+                d = op(d, scalar);
+            }
+            return *this;
+        }
+
+        // Row r of this times col c of rhm, unrolled over the inner dimension.
+        template <size_type OtherCols, size_type... K>
+        [[nodiscard]] inline constexpr auto dot(size_type r, fixed_matrix<T, Cols, OtherCols> const &rhm, size_type c, std::index_sequence<K...>) const noexcept -> T
+        {
+            T acc{};
+            ((acc = static_cast<T>(acc + data_[r * Cols + K] * rhm.data_[K * OtherCols + c])), ...);
+            return acc;
+        }
+
+        template <typename This>
+        [[nodiscard]] static inline constexpr auto op_parenthesis(This &instance, size_type r, size_type c) -> auto &
+        {
+            detail::checkIndex<detail::checkPublicAccess>(r, c, Rows, Cols);
+            return instance.data_[r * Cols + c];
+        }
+
+        template <typename This>
+        [[nodiscard]] static inline constexpr auto op_sqBracket(This &instance, size_type idx) -> auto &
+        {
+            detail::checkIndex<detail::checkPublicAccess>(idx, Rows * Cols);
+            return instance.data_[idx];
+        }
+    };
+
+    template <numerical T>
+    using matrix2 = fixed_matrix<T, 2, 2>;
+    template <numerical T>
+    using matrix3 = fixed_matrix<T, 3, 3>;
+    template <numerical T>
+    using matrix4 = fixed_matrix<T, 4, 4>;
+
+    template <numerical T, std::size_t Rows, std::size_t Cols>
+    auto operator<<(std::ostream &os, fixed_matrix<T, Rows, Cols> const &rhm) -> std::ostream &
+    {
+        return os << rhm.view();
+    }
+
+    template <numerical T, std::size_t Rows, std::size_t Cols>
+    [[nodiscard]] constexpr inline auto size(fixed_matrix<T, Rows, Cols> const &) noexcept -> std::tuple<std::size_t, std::size_t>
+    {
+        return std::tuple{Rows, Cols};
+    }
+} // namespace tinyTools
+
+#endif /* FIXED_MATRIX_HPP */
@@ -0,0 +1,210 @@
+#ifndef MATRIX_INSTRUMENT_HPP
+#define MATRIX_INSTRUMENT_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+// Per-operation counters: calls, wall time, bytes allocated and bytes copied.
+// Compiled out unless TINYTOOLS_INSTRUMENT is 1 (the scopes are empty structs then), e.g. -DTINYTOOLS_INSTRUMENT=1.
+//   - Time is inclusive: an operator* also counts the ctor of its result.
+//   - Bytes are charged to the outermost operation of the calling thread, so an operator* shows the buffer of its
+//     result and CONSTRUCT only shows the matrices built directly.
+//   - COPY counts the copy ctor and copy assignment, the copies made when a matrix is passed or returned by value.
+//   tinyTools::resetOperationStats();
+//   run();
+//   tinyTools::dumpOperationStats(std::cerr);
+#ifndef TINYTOOLS_INSTRUMENT
+#define TINYTOOLS_INSTRUMENT 0
+#endif
+
+namespace tinyTools
+{
+    enum struct Operation : std::uint8_t
+    {
+        CONSTRUCT,   // Shape, fill and buffer ctors (and the factories built on them).
+        COPY,        // Copy ctor and copy assignment.
+        VIEW_COPY,   // A view (submatrix, row, col, transpose) copied into a matrix.
+        ELEMENTWISE, // Fused expressions, +=, -=, multiply and the comparisons.
+        MULTIPLY,    // Matrix product.
+        REDUCE,      // sum, prod, min, max, mean, any, all.
+        CAT,         // Concatenation.
+        SUBMATRIX,   // Views of a block (no copy).
+        COUNT
+    };
+
+    inline constexpr bool instrumentEnabled{TINYTOOLS_INSTRUMENT != 0};
+    inline constexpr std::size_t operationCount{static_cast<std::size_t>(Operation::COUNT)};
+
+    struct operation_stats
+    {
+        std::uint64_t calls{};
+        std::uint64_t nanoseconds{};
+        std::uint64_t bytesAllocated{};
+        std::uint64_t bytesCopied{};
+    };
+
+    [[nodiscard]] inline constexpr auto operationName(Operation op) noexcept -> std::string_view
+    {
+        constexpr std::array<std::string_view, operationCount> names{"construct", "copy", "view copy", "elementwise", "multiply", "reduce", "cat", "submatrix"};
+        return op < Operation::COUNT ? names[static_cast<std::size_t>(op)] : std::string_view{"unknown"};
+    }
+
+    namespace detail
+    {
+        struct operation_counters
+        {
+            std::atomic<std::uint64_t> calls{};
+            std::atomic<std::uint64_t> nanoseconds{};
+            std::atomic<std::uint64_t> bytesAllocated{};
+            std::atomic<std::uint64_t> bytesCopied{};
+        };
+
+        inline std::array<operation_counters, operationCount> g_operationStats{};
+
+        // Innermost and outermost operations running on this thread, COUNT when none.
+        inline thread_local Operation g_innerOperation{Operation::COUNT};
+        inline thread_local Operation g_outerOperation{Operation::COUNT};
+
+        [[nodiscard]] inline auto counters(Operation op) noexcept -> operation_counters & { return g_operationStats[static_cast<std::size_t>(op)]; }
+
+        // Bytes of n elements in a matrix<T> buffer (std::vector<bool> packs 8 per byte).
+        template <typename T>
+        [[nodiscard]] inline constexpr auto storageBytes(std::size_t n) noexcept -> std::uint64_t
+        {
+            return std::is_same_v<T, bool> ? (n + 7) / 8 : n * sizeof(T);
+        }
+
+#if TINYTOOLS_INSTRUMENT
+        // Counts one call and its time. A scope nested in a scope of the same operation (delegating ctors) is not
+        // counted again.
+        struct [[nodiscard]] operation_scope
+        {
+            inline constexpr explicit operation_scope(Operation op) noexcept
+                : op_{op}
+            {
+                if (std::is_constant_evaluated() || g_innerOperation == op)
+                {
+                    return;
+                }
+                active_ = true;
+                previous_ = g_innerOperation;
+                g_innerOperation = op;
+                if (g_outerOperation == Operation::COUNT)
+                {
+                    g_outerOperation = op;
+                    outermost_ = true;
+                }
+                counters(op).calls.fetch_add(1, std::memory_order_relaxed);
+                start_ = std::chrono::steady_clock::now();
+            }
+
+            inline constexpr ~operation_scope() noexcept
+            {
+                if (std::is_constant_evaluated() || !active_)
+                {
+                    return;
+                }
+                auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+                counters(op_).nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed), std::memory_order_relaxed);
+                g_innerOperation = previous_;
+                if (outermost_)
+                {
+                    g_outerOperation = Operation::COUNT;
+                }
+            }
+
+            operation_scope(operation_scope const &) = delete;
+            auto operator=(operation_scope const &) -> operation_scope & = delete;
+
+        private:
+            Operation op_;
+            Operation previous_{Operation::COUNT};
+            bool active_{false};
+            bool outermost_{false};
+            std::chrono::steady_clock::time_point start_{};
+        };
+
+        inline constexpr auto countAllocated(std::uint64_t bytes) noexcept -> void
+        {
+            if (!std::is_constant_evaluated())
+            {
+                auto const op = g_outerOperation == Operation::COUNT ? Operation::CONSTRUCT : g_outerOperation;
+                counters(op).bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+            }
+        }
+
+        inline constexpr auto countCopied(std::uint64_t bytes) noexcept -> void
+        {
+            if (!std::is_constant_evaluated())
+            {
+                auto const op = g_outerOperation == Operation::COUNT ? Operation::COPY : g_outerOperation;
+                counters(op).bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+            }
+        }
+#else
+        struct [[nodiscard]] operation_scope
+        {
+            inline constexpr explicit operation_scope(Operation /*unused*/) noexcept {}
+        };
+
+        inline constexpr auto countAllocated(std::uint64_t /*unused*/) noexcept -> void {}
+        inline constexpr auto countCopied(std::uint64_t /*unused*/) noexcept -> void {}
+#endif
+    } // namespace detail
+
+    // Counters since the start or the last reset, zeros when instrumentation is compiled out.
+    [[nodiscard]] inline auto operationStats(Operation op) noexcept -> operation_stats
+    {
+        auto const &counters = detail::counters(op);
+        return {counters.calls.load(std::memory_order_relaxed), counters.nanoseconds.load(std::memory_order_relaxed),
+                counters.bytesAllocated.load(std::memory_order_relaxed), counters.bytesCopied.load(std::memory_order_relaxed)};
+    }
+
+    inline auto resetOperationStats() noexcept -> void
+    {
+        for (auto &counters : detail::g_operationStats)
+        {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.nanoseconds.store(0, std::memory_order_relaxed);
+            counters.bytesAllocated.store(0, std::memory_order_relaxed);
+            counters.bytesCopied.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // One row per operation that was called.
+    inline auto dumpOperationStats(std::ostream &os) -> std::ostream &
+    {
+        if constexpr (!instrumentEnabled)
+        {
+            return os << "Instrumentation disabled, build with TINYTOOLS_INSTRUMENT=1.\n";
+        }
+        auto const flags = os.flags();
+        auto const precision = os.precision();
+        os << std::left << std::setw(12) << "operation" << std::right << std::setw(12) << "calls" << std::setw(14) << "time [ms]"
+           << std::setw(18) << "allocated [B]" << std::setw(18) << "copied [B]" << '\n';
+        for (std::size_t i{}; i < operationCount; ++i)
+        {
+            auto const op = static_cast<Operation>(i);
+            auto const stats = operationStats(op);
+            if (stats.calls == 0)
+            {
+                continue;
+            }
+            os << std::left << std::setw(12) << operationName(op) << std::right << std::setw(12) << stats.calls << std::setw(14) << std::fixed
+               << std::setprecision(3) << static_cast<double>(stats.nanoseconds) / 1e6 << std::setw(18) << stats.bytesAllocated << std::setw(18)
+               << stats.bytesCopied << '\n';
+        }
+        os.flags(flags);
+        os.precision(precision);
+        return os;
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_INSTRUMENT_HPP */
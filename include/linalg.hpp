@@ -0,0 +1,762 @@
+#ifndef MATRIX_LINALG_HPP
+#define MATRIX_LINALG_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/gemm.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+// Dense factorizations for floating point matrices (Matlab: lu, chol, qr, \, det, inv).
+// All of them are blocked right-looking: a narrow panel of factorBlock columns is factored with vector operations and
+// the trailing matrix is updated with detail::gemm, so almost all the work runs in the packed GEMM kernel and follows
+// the execution policy and thread count like operator*.
+//   auto const factors = tinyTools::lu(A);
+//   auto const x = factors.solve(b);       // Same as tinyTools::solve(A, b).
+namespace tinyTools
+{
+    namespace detail
+    {
+        // Panel width: wide enough for the trailing GEMM to reach its speed, narrow enough for the panel to stay in cache.
+        inline constexpr std::size_t factorBlock{64};
+
+        [[noreturn, gnu::cold, gnu::noinline]] inline auto throwNotSquare() -> void { throw std::invalid_argument("Matrix must be square!\n"); }
+
+        [[noreturn, gnu::cold, gnu::noinline]] inline auto throwRhsRows() -> void
+        {
+            throw std::invalid_argument("Right-hand side must have as many rows as the matrix!\n");
+        }
+
+        // b (n x nrhs, row-major) = tri^-1 * b, tri (n x n, any strides) lower or upper triangular.
+        // Block rows of factorBlock: the part coming from the solved rows is one GEMM, the rest is solved row by row.
+        template <typename T>
+        inline auto trsm(bool const lower, bool const unitDiag, std::size_t const n, std::size_t const nrhs, gemm_operand<T const> tri, T *b, std::size_t const ldb) -> void
+        {
+            if (n == 0 || nrhs == 0)
+            {
+                return;
+            }
+
+            auto solveBlock = [=](std::size_t i0, std::size_t ib)
+            {
+                for_each_chunk(nrhs, ib * ib, [=](std::size_t c0, std::size_t c1)
+                               {
+                                   auto solveRow = [=](std::size_t i, std::size_t first, std::size_t last)
+                                   {
+                                       auto *const row = b + i * ldb;
+                                       for (auto p{first}; p < last; ++p)
+                                       {
+                                           auto const l = tri(i, p);
+                                           auto const *const src = b + p * ldb;
+                                           for (auto c{c0}; c < c1; ++c)
+                                           {
+                                               row[c] -= l * src[c];
+                                           }
+                                       }
+                                       if (!unitDiag)
+                                       {
+                                           auto const inv = T{1} / tri(i, i);
+                                           for (auto c{c0}; c < c1; ++c)
+                                           {
+                                               row[c] *= inv;
+                                           }
+                                       }
+                                   };
+                                   if (lower)
+                                   {
+                                       for (auto i{i0}; i < i0 + ib; ++i)
+                                       {
+                                           solveRow(i, i0, i);
+                                       }
+                                   }
+                                   else
+                                   {
+                                       for (auto i{i0 + ib}; i-- > i0;)
+                                       {
+                                           solveRow(i, i + 1, i0 + ib);
+                                       }
+                                   }
+                               });
+            };
+
+            if (lower)
+            {
+                for (std::size_t i0{}; i0 < n; i0 += factorBlock)
+                {
+                    auto const ib = std::min(factorBlock, n - i0);
+                    gemm<T>(ib, nrhs, i0, T{-1}, {&tri(i0, 0), tri.rs, tri.cs}, {b, ldb, 1}, T{1}, {b + i0 * ldb, ldb, 1});
+                    solveBlock(i0, ib);
+                }
+            }
+            else
+            {
+                for (auto i0{(n - 1) / factorBlock * factorBlock};; i0 -= factorBlock)
+                {
+                    auto const ib = std::min(factorBlock, n - i0);
+                    auto const tail = i0 + ib;
+                    if (tail < n)
+                    {
+                        gemm<T>(ib, nrhs, n - tail, T{-1}, {&tri(i0, tail), tri.rs, tri.cs}, {b + tail * ldb, ldb, 1}, T{1}, {b + i0 * ldb, ldb, 1});
+                    }
+                    solveBlock(i0, ib);
+                    if (i0 == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        // P * A = L * U in place (n x n, row-major), L unit lower below the diagonal, U on and above it.
+        // Row j was swapped with row pivots[j]. Returns false when a pivot is exactly zero (the factorization still
+        // completes, the matrix is singular).
+        template <typename T>
+        inline auto luFactor(std::size_t const n, T *a, std::size_t const lda, std::size_t *pivots) -> bool
+        {
+            auto regular = true;
+            for (std::size_t k0{}; k0 < n; k0 += factorBlock)
+            {
+                auto const kb = std::min(factorBlock, n - k0);
+                auto const end = k0 + kb;
+
+                // Panel: unblocked elimination with partial pivoting, whole rows are swapped.
+                for (auto j{k0}; j < end; ++j)
+                {
+                    auto p = j;
+                    auto best = std::abs(a[j * lda + j]);
+                    for (auto i{j + 1}; i < n; ++i)
+                    {
+                        if (auto const v = std::abs(a[i * lda + j]); v > best)
+                        {
+                            best = v;
+                            p = i;
+                        }
+                    }
+                    pivots[j] = p;
+                    if (p != j)
+                    {
+                        std::swap_ranges(a + j * lda, a + j * lda + n, a + p * lda);
+                    }
+
+                    auto const pivot = a[j * lda + j];
+                    if (pivot == T{})
+                    {
+                        regular = false; // The column below is all zeros, nothing to eliminate.
+                        continue;
+                    }
+                    auto const *const pivotRow = a + j * lda;
+                    for_each_chunk(n - j - 1, end - j, [=](std::size_t begin, std::size_t last)
+                                   {
+                                       for (auto i{j + 1 + begin}; i < j + 1 + last; ++i)
+                                       {
+                                           auto *const row = a + i * lda;
+                                           auto const l = row[j] / pivot;
+                                           row[j] = l;
+                                           for (auto c{j + 1}; c < end; ++c)
+                                           {
+                                               row[c] -= l * pivotRow[c];
+                                           }
+                                       }
+                                   });
+                }
+
+                if (end < n)
+                {
+                    auto const rest = n - end;
+                    // U12 = L11^-1 * A12, then A22 -= L21 * U12.
+                    trsm<T>(true, true, kb, rest, {a + k0 * lda + k0, lda, 1}, a + k0 * lda + end, lda);
+                    gemm<T>(rest, rest, kb, T{-1}, {a + end * lda + k0, lda, 1}, {a + k0 * lda + end, lda, 1}, T{1}, {a + end * lda + end, lda, 1});
+                }
+            }
+            return regular;
+        }
+
+        // A = L * L^T in place (n x n, row-major), L in the lower triangle. The upper triangle is not read, the trailing update
+        // uses the strictly upper part of its diagonal blocks as scratch.
+        // Returns false when A is not positive definite.
+        template <typename T>
+        inline auto choleskyFactor(std::size_t const n, T *a, std::size_t const lda) -> bool
+        {
+            // Row i of L21 against the solved columns [k0, j) of the block.
+            auto dot = [a, lda](std::size_t i, std::size_t j, std::size_t k0)
+            {
+                auto sum = T{};
+                for (auto p{k0}; p < j; ++p)
+                {
+                    sum += a[i * lda + p] * a[j * lda + p];
+                }
+                return sum;
+            };
+
+            for (std::size_t k0{}; k0 < n; k0 += factorBlock)
+            {
+                auto const kb = std::min(factorBlock, n - k0);
+                auto const end = k0 + kb;
+
+                // A11 = L11 * L11^T.
+                for (auto j{k0}; j < end; ++j)
+                {
+                    auto const d = a[j * lda + j] - dot(j, j, k0);
+                    if (!(d > T{}))
+                    {
+                        return false;
+                    }
+                    a[j * lda + j] = std::sqrt(d);
+                    for (auto i{j + 1}; i < end; ++i)
+                    {
+                        a[i * lda + j] = (a[i * lda + j] - dot(i, j, k0)) / a[j * lda + j];
+                    }
+                }
+
+                if (end < n)
+                {
+                    // L21 = A21 * L11^-T, every row is an independent forward substitution.
+                    for_each_chunk(n - end, kb * kb, [=](std::size_t begin, std::size_t last)
+                                   {
+                                       for (auto i{end + begin}; i < end + last; ++i)
+                                       {
+                                           for (auto j{k0}; j < end; ++j)
+                                           {
+                                               a[i * lda + j] = (a[i * lda + j] - dot(i, j, k0)) / a[j * lda + j];
+                                           }
+                                       }
+                                   });
+
+                    // A22 -= L21 * L21^T, lower triangle only: each block row stops at its diagonal block.
+                    for (auto i0{end}; i0 < n; i0 += factorBlock)
+                    {
+                        auto const ib = std::min(factorBlock, n - i0);
+                        gemm<T>(ib, i0 + ib - end, kb, T{-1}, {a + i0 * lda + k0, lda, 1}, {a + end * lda + k0, 1, lda}, T{1}, {a + i0 * lda + end, lda, 1});
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Householder vector of x = a[j:m, j] (LAPACK larfg): H * x = beta * e1 with H = I - tau * v * v^T, v[0] = 1.
+        // v[1:] overwrites x[1:] and beta overwrites x[0].
+        template <typename T>
+        inline auto householder(std::size_t const m, std::size_t const j, T *a, std::size_t const lda) noexcept -> T
+        {
+            // Scaled by the largest magnitude so the sum of squares neither overflows nor underflows.
+            auto scale = T{};
+            for (auto i{j + 1}; i < m; ++i)
+            {
+                scale = std::max(scale, std::abs(a[i * lda + j]));
+            }
+            auto const alpha = a[j * lda + j];
+            if (scale == T{})
+            {
+                return T{}; // Already e1, H = I.
+            }
+            auto sum = T{};
+            for (auto i{j + 1}; i < m; ++i)
+            {
+                auto const v = a[i * lda + j] / scale;
+                sum += v * v;
+            }
+            auto const norm = scale * std::sqrt(sum);
+            auto const beta = -std::copysign(std::hypot(alpha, norm), alpha);
+            auto const inv = T{1} / (alpha - beta);
+            for (auto i{j + 1}; i < m; ++i)
+            {
+                a[i * lda + j] *= inv;
+            }
+            a[j * lda + j] = beta;
+            return (beta - alpha) / beta;
+        }
+
+        // Block reflector of the kb Householder vectors stored from (k0, k0): H(k0) ... H(k0 + kb - 1) = I - Y * T * Y^T.
+        // b (m - k0 rows x nrhs, row-major) = H^T * b (transpose) or H * b, as Y^T * b, T or T^T, and Y * W GEMMs.
+        template <typename T>
+        inline auto applyBlockReflector(bool const transpose, std::size_t const m, std::size_t const k0, std::size_t const kb, T const *a,
+                                        std::size_t const lda, T const *taus, T *b, std::size_t const ldb, std::size_t const nrhs) -> void
+        {
+            auto const mk = m - k0;
+            thread_local std::vector<T> y{};
+            thread_local std::vector<T> t{};
+            thread_local std::vector<T> w{};
+            y.assign(mk * kb, T{});
+            t.assign(kb * kb, T{});
+            w.resize(kb * nrhs);
+
+            // Y: unit lower trapezoid.
+            for (std::size_t r{}; r < mk; ++r)
+            {
+                for (std::size_t c{}; c < std::min(r + 1, kb); ++c)
+                {
+                    y[r * kb + c] = r == c ? T{1} : a[(k0 + r) * lda + k0 + c];
+                }
+            }
+            // T: upper triangular, T[0:i, i] = -tau_i * T[0:i, 0:i] * (Y[:, 0:i]^T * Y[:, i]).
+            for (std::size_t i{}; i < kb; ++i)
+            {
+                auto const tau = taus[k0 + i];
+                t[i * kb + i] = tau;
+                for (std::size_t p{}; p < i; ++p)
+                {
+                    auto z = T{};
+                    for (auto r{i}; r < mk; ++r)
+                    {
+                        z += y[r * kb + p] * y[r * kb + i];
+                    }
+                    t[p * kb + i] = -tau * z;
+                }
+                // T[0:i, i] = T[0:i, 0:i] * z, top to bottom only reads entries not updated yet.
+                for (std::size_t p{}; p < i; ++p)
+                {
+                    auto sum = T{};
+                    for (auto q{p}; q < i; ++q)
+                    {
+                        sum += t[p * kb + q] * t[q * kb + i];
+                    }
+                    t[p * kb + i] = sum;
+                }
+            }
+
+            // W = Y^T * b.
+            gemm<T>(kb, nrhs, mk, T{1}, {y.data(), 1, kb}, {b, ldb, 1}, T{}, {w.data(), nrhs, 1});
+            // W = T^T * W (bottom up) or T * W (top down), in place.
+            auto combine = [](T *dst, T const *src, T f, std::size_t n)
+            {
+                for (std::size_t c{}; c < n; ++c)
+                {
+                    dst[c] += f * src[c];
+                }
+            };
+            if (transpose)
+            {
+                for (auto i{kb}; i-- > 0;)
+                {
+                    auto *const row = w.data() + i * nrhs;
+                    std::transform(row, row + nrhs, row, [d = t[i * kb + i]](T v) { return v * d; });
+                    for (std::size_t p{}; p < i; ++p)
+                    {
+                        combine(row, w.data() + p * nrhs, t[p * kb + i], nrhs);
+                    }
+                }
+            }
+            else
+            {
+                for (std::size_t i{}; i < kb; ++i)
+                {
+                    auto *const row = w.data() + i * nrhs;
+                    std::transform(row, row + nrhs, row, [d = t[i * kb + i]](T v) { return v * d; });
+                    for (auto p{i + 1}; p < kb; ++p)
+                    {
+                        combine(row, w.data() + p * nrhs, t[i * kb + p], nrhs);
+                    }
+                }
+            }
+            // b -= Y * W.
+            gemm<T>(mk, nrhs, kb, T{-1}, {y.data(), kb, 1}, {w.data(), nrhs, 1}, T{1}, {b, ldb, 1});
+        }
+
+        // A = Q * R in place (m x n, row-major): R on and above the diagonal, the Householder vectors below it.
+        template <typename T>
+        inline auto qrFactor(std::size_t const m, std::size_t const n, T *a, std::size_t const lda, T *taus) -> void
+        {
+            auto const k = std::min(m, n);
+            std::vector<T> w(n);
+            for (std::size_t k0{}; k0 < k; k0 += factorBlock)
+            {
+                auto const kb = std::min(factorBlock, k - k0);
+                auto const end = k0 + kb;
+
+                // Panel: one reflector per column, applied to the rest of the panel (w = v^T * A, A -= tau * v * w).
+                for (auto j{k0}; j < end; ++j)
+                {
+                    auto const tau = taus[j] = householder(m, j, a, lda);
+                    if (tau == T{})
+                    {
+                        continue;
+                    }
+                    std::copy(a + j * lda + j + 1, a + j * lda + end, w.begin());
+                    for (auto i{j + 1}; i < m; ++i)
+                    {
+                        auto const v = a[i * lda + j];
+                        for (auto c{j + 1}; c < end; ++c)
+                        {
+                            w[c - j - 1] += v * a[i * lda + c];
+                        }
+                    }
+                    for (auto c{j + 1}; c < end; ++c)
+                    {
+                        a[j * lda + c] -= tau * w[c - j - 1];
+                    }
+                    for (auto i{j + 1}; i < m; ++i)
+                    {
+                        auto const f = tau * a[i * lda + j];
+                        for (auto c{j + 1}; c < end; ++c)
+                        {
+                            a[i * lda + c] -= f * w[c - j - 1];
+                        }
+                    }
+                }
+
+                if (end < n)
+                {
+                    applyBlockReflector<T>(true, m, k0, kb, a, lda, taus, a + k0 * lda + end, lda, n - end);
+                }
+            }
+        }
+
+        // b (m x nrhs) = Q^T * b or Q * b for the reflectors of qrFactor.
+        template <typename T>
+        inline auto applyQ(bool const transpose, std::size_t const m, std::size_t const k, T const *a, std::size_t const lda, T const *taus, T *b,
+                           std::size_t const ldb, std::size_t const nrhs) -> void
+        {
+            if (transpose)
+            {
+                for (std::size_t k0{}; k0 < k; k0 += factorBlock)
+                {
+                    applyBlockReflector<T>(true, m, k0, std::min(factorBlock, k - k0), a, lda, taus, b + k0 * ldb, ldb, nrhs);
+                }
+            }
+            else
+            {
+                for (auto k0{(k - 1) / factorBlock * factorBlock};; k0 -= factorBlock)
+                {
+                    applyBlockReflector<T>(false, m, k0, std::min(factorBlock, k - k0), a, lda, taus, b + k0 * ldb, ldb, nrhs);
+                    if (k0 == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        template <typename T, typename Allocator>
+        [[nodiscard]] inline auto identity(std::size_t const rows, std::size_t const cols) -> matrix<T, Allocator>
+        {
+            matrix<T, Allocator> ret{rows, cols, T{}};
+            for (std::size_t i{}; i < std::min(rows, cols); ++i)
+            {
+                ret.unchecked(i, i) = T{1};
+            }
+            return ret;
+        }
+    } // namespace detail
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // P * A = L * U with partial pivoting. (Matlab: [L, U, P] = lu(A))
+    template <typename T, typename Allocator = std::allocator<T>>
+        requires std::is_floating_point_v<T>
+    struct lu_factorization
+    {
+        using matrix_type = matrix<T, Allocator>;
+        using size_type = std::size_t;
+
+        inline explicit lu_factorization(matrix_type a)
+            : factors_{std::move(a)}, pivots_(factors_.rows())
+        {
+            if (factors_.rows() != factors_.cols())
+            {
+                detail::throwNotSquare();
+            }
+            regular_ = detail::luFactor(factors_.rows(), factors_.ptr(), factors_.ld(), pivots_.data());
+        }
+
+        // L below the diagonal (unit diagonal implied), U on and above it.
+        [[nodiscard]] inline auto factors() const noexcept -> matrix_type const & { return factors_; }
+        // Row j was swapped with row pivots()[j], in order.
+        [[nodiscard]] inline auto pivots() const noexcept -> std::span<size_type const> { return pivots_; }
+        [[nodiscard]] inline auto singular() const noexcept -> bool { return !regular_; }
+
+        [[nodiscard]] inline auto L() const -> matrix_type
+        {
+            auto ret = detail::identity<T, Allocator>(size(), size());
+            for (size_type r{}; r < size(); ++r)
+            {
+                std::copy_n(&factors_.unchecked(r, 0), r, &ret.unchecked(r, 0));
+            }
+            return ret;
+        }
+
+        [[nodiscard]] inline auto U() const -> matrix_type
+        {
+            matrix_type ret{size(), size(), T{}};
+            for (size_type r{}; r < size(); ++r)
+            {
+                std::copy(&factors_.unchecked(r, r), factors_.ptr() + (r + 1) * size(), &ret.unchecked(r, r));
+            }
+            return ret;
+        }
+
+        [[nodiscard]] inline auto P() const -> matrix_type { return permute(detail::identity<T, Allocator>(size(), size())); }
+
+        [[nodiscard]] inline auto det() const noexcept -> T
+        {
+            auto ret = T{1};
+            for (size_type i{}; i < size(); ++i)
+            {
+                ret *= pivots_[i] != i ? -factors_.unchecked(i, i) : factors_.unchecked(i, i);
+            }
+            return ret;
+        }
+
+        // A^-1 * b, b with one column per right-hand side.
+        [[nodiscard]] inline auto solve(matrix_type b) const -> matrix_type
+        {
+            if (b.rows() != size())
+            {
+                detail::throwRhsRows();
+            }
+            if (singular())
+            {
+                throw std::domain_error("Matrix is singular!\n");
+            }
+            b = permute(std::move(b));
+            detail::trsm<T>(true, true, size(), b.cols(), {factors_.ptr(), factors_.ld(), 1}, b.ptr(), b.ld());
+            detail::trsm<T>(false, false, size(), b.cols(), {factors_.ptr(), factors_.ld(), 1}, b.ptr(), b.ld());
+            return b;
+        }
+
+        [[nodiscard]] inline auto inv() const -> matrix_type { return solve(detail::identity<T, Allocator>(size(), size())); }
+
+    private:
+        matrix_type factors_;
+        std::vector<size_type> pivots_{};
+        bool regular_{true};
+
+        [[nodiscard]] inline auto size() const noexcept -> size_type { return factors_.rows(); }
+
+        [[nodiscard]] inline auto permute(matrix_type b) const -> matrix_type
+        {
+            for (size_type j{}; j < size(); ++j)
+            {
+                if (pivots_[j] != j)
+                {
+                    std::swap_ranges(b.ptr() + j * b.ld(), b.ptr() + j * b.ld() + b.cols(), b.ptr() + pivots_[j] * b.ld());
+                }
+            }
+            return b;
+        }
+    };
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // A = L * L^T for symmetric positive definite A, only the lower triangle of A is read. (Matlab: chol(A, 'lower'))
+    template <typename T, typename Allocator = std::allocator<T>>
+        requires std::is_floating_point_v<T>
+    struct cholesky_factorization
+    {
+        using matrix_type = matrix<T, Allocator>;
+        using size_type = std::size_t;
+
+        inline explicit cholesky_factorization(matrix_type a)
+            : factors_{std::move(a)}
+        {
+            if (factors_.rows() != factors_.cols())
+            {
+                detail::throwNotSquare();
+            }
+            if (!detail::choleskyFactor(factors_.rows(), factors_.ptr(), factors_.ld()))
+            {
+                throw std::domain_error("Matrix must be symmetric positive definite!\n");
+            }
+        }
+
+        [[nodiscard]] inline auto L() const -> matrix_type
+        {
+            matrix_type ret{size(), size(), T{}};
+            for (size_type r{}; r < size(); ++r)
+            {
+                std::copy_n(&factors_.unchecked(r, 0), r + 1, &ret.unchecked(r, 0));
+            }
+            return ret;
+        }
+
+        [[nodiscard]] inline auto det() const noexcept -> T
+        {
+            auto ret = T{1};
+            for (size_type i{}; i < size(); ++i)
+            {
+                ret *= factors_.unchecked(i, i);
+            }
+            return ret * ret;
+        }
+
+        [[nodiscard]] inline auto solve(matrix_type b) const -> matrix_type
+        {
+            if (b.rows() != size())
+            {
+                detail::throwRhsRows();
+            }
+            detail::trsm<T>(true, false, size(), b.cols(), {factors_.ptr(), factors_.ld(), 1}, b.ptr(), b.ld());
+            detail::trsm<T>(false, false, size(), b.cols(), {factors_.ptr(), 1, factors_.ld()}, b.ptr(), b.ld());
+            return b;
+        }
+
+        [[nodiscard]] inline auto inv() const -> matrix_type { return solve(detail::identity<T, Allocator>(size(), size())); }
+
+    private:
+        matrix_type factors_;
+
+        [[nodiscard]] inline auto size() const noexcept -> size_type { return factors_.rows(); }
+    };
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // A = Q * R with Householder reflectors, any shape. (Matlab: [Q, R] = qr(A, 0), the economy size)
+    template <typename T, typename Allocator = std::allocator<T>>
+        requires std::is_floating_point_v<T>
+    struct qr_factorization
+    {
+        using matrix_type = matrix<T, Allocator>;
+        using size_type = std::size_t;
+
+        inline explicit qr_factorization(matrix_type a)
+            : factors_{std::move(a)}, taus_(std::min(factors_.rows(), factors_.cols()))
+        {
+            detail::qrFactor(factors_.rows(), factors_.cols(), factors_.ptr(), factors_.ld(), taus_.data());
+        }
+
+        // R on and above the diagonal, the Householder vectors (unit first element implied) below it.
+        [[nodiscard]] inline auto factors() const noexcept -> matrix_type const & { return factors_; }
+        [[nodiscard]] inline auto taus() const noexcept -> std::span<T const> { return taus_; }
+
+        // m x min(m, n), orthonormal columns.
+        [[nodiscard]] inline auto Q() const -> matrix_type
+        {
+            auto ret = detail::identity<T, Allocator>(factors_.rows(), rank());
+            applyQ(false, ret);
+            return ret;
+        }
+
+        // min(m, n) x n, upper triangular.
+        [[nodiscard]] inline auto R() const -> matrix_type
+        {
+            matrix_type ret{rank(), factors_.cols(), T{}};
+            for (size_type r{}; r < rank(); ++r)
+            {
+                std::copy(&factors_.unchecked(r, r), factors_.ptr() + (r + 1) * factors_.ld(), &ret.unchecked(r, r));
+            }
+            return ret;
+        }
+
+        // Q^T * b (transpose) or Q * b, b with m rows.
+        inline auto applyQ(bool const transpose, matrix_type &b) const -> void
+        {
+            if (b.rows() != factors_.rows())
+            {
+                detail::throwRhsRows();
+            }
+            detail::applyQ<T>(transpose, factors_.rows(), rank(), factors_.ptr(), factors_.ld(), taus_.data(), b.ptr(), b.ld(), b.cols());
+        }
+
+        // Least squares solution of A * x = b (m >= n): R^-1 * (Q^T * b) over the first n rows.
+        [[nodiscard]] inline auto solve(matrix_type b) const -> matrix_type
+        {
+            auto const n = factors_.cols();
+            if (factors_.rows() < n)
+            {
+                throw std::invalid_argument("QR solve needs rows >= cols, solve(A, b) handles the underdetermined case!\n");
+            }
+            checkRank();
+            applyQ(true, b);
+            detail::trsm<T>(false, false, n, b.cols(), {factors_.ptr(), factors_.ld(), 1}, b.ptr(), b.ld());
+            if (n == b.rows())
+            {
+                return b;
+            }
+            return matrix_type{b(0, 0, n, b.cols())};
+        }
+
+        // Minimum norm solution of A^T * x = b (this factorization is of A^T, m >= n): x = Q * (R^-T * b).
+        [[nodiscard]] inline auto solveTransposed(matrix_type const &b) const -> matrix_type
+        {
+            auto const n = factors_.cols();
+            if (b.rows() != n)
+            {
+                detail::throwRhsRows();
+            }
+            checkRank();
+            matrix_type ret{factors_.rows(), b.cols(), T{}};
+            std::copy(b.begin(), b.end(), ret.begin());
+            detail::trsm<T>(true, false, n, b.cols(), {factors_.ptr(), 1, factors_.ld()}, ret.ptr(), ret.ld());
+            applyQ(false, ret);
+            return ret;
+        }
+
+    private:
+        matrix_type factors_;
+        std::vector<T> taus_{};
+
+        [[nodiscard]] inline auto rank() const noexcept -> size_type { return taus_.size(); }
+
+        inline auto checkRank() const -> void
+        {
+            for (size_type i{}; i < rank(); ++i)
+            {
+                if (factors_.unchecked(i, i) == T{})
+                {
+                    throw std::domain_error("Matrix is rank deficient!\n");
+                }
+            }
+        }
+    };
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    template <typename T, typename Allocator>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] inline auto lu(matrix<T, Allocator> a) -> lu_factorization<T, Allocator>
+    {
+        return lu_factorization<T, Allocator>{std::move(a)};
+    }
+
+    template <typename T, typename Allocator>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] inline auto chol(matrix<T, Allocator> a) -> cholesky_factorization<T, Allocator>
+    {
+        return cholesky_factorization<T, Allocator>{std::move(a)};
+    }
+
+    template <typename T, typename Allocator>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] inline auto qr(matrix<T, Allocator> a) -> qr_factorization<T, Allocator>
+    {
+        return qr_factorization<T, Allocator>{std::move(a)};
+    }
+
+    // x = A \ b: LU for square A, least squares for tall A, minimum norm for wide A.
+    template <typename T, typename Allocator>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] inline auto solve(matrix<T, Allocator> a, matrix<T, Allocator> b) -> matrix<T, Allocator>
+    {
+        if (b.rows() != a.rows())
+        {
+            detail::throwRhsRows();
+        }
+        if (a.rows() == a.cols())
+        {
+            return lu(std::move(a)).solve(std::move(b));
+        }
+        if (a.rows() > a.cols())
+        {
+            return qr(std::move(a)).solve(std::move(b));
+        }
+        return qr(matrix<T, Allocator>{a.t()}).solveTransposed(b);
+    }
+
+    template <typename T, typename Allocator>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] inline auto det(matrix<T, Allocator> a) -> T
+    {
+        return lu(std::move(a)).det();
+    }
+
+    template <typename T, typename Allocator>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] inline auto inv(matrix<T, Allocator> a) -> matrix<T, Allocator>
+    {
+        return lu(std::move(a)).inv();
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_LINALG_HPP */
@@ -1,13 +1,32 @@
 #ifndef MATRIX_HPP
 #define MATRIX_HPP
 
+#include <array>
+#include <bit>
 #include <concepts>
-#include <execution>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
 #include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+
+#include "allocator.hpp"
+#include "bit_mask.hpp"
+#include "detail/bounds.hpp"
+#include "detail/gemm.hpp"
+#include "detail/simd.hpp"
+#include "detail/strassen.hpp"
+#include "detail/transpose.hpp"
+#include "instrument.hpp"
+#include "matrix_expression.hpp"
+#include "matrix_fwd.hpp"
+#include "matrix_view.hpp"
+#include "parallel.hpp"
+#include "random.hpp"
 
 /* Nuestra:         Matlab:
        0 1 2          0 3 6
@@ -17,10 +36,12 @@
 
 namespace tinyTools
 {
-    template <typename T>
-    concept numerical = std::is_integral_v<T> || std::is_floating_point_v<T>;
-
-    template <numerical T>
+    // Allocator: storage of the buffer, see allocator.hpp for the aligned and pooled ones (must be stateless).
+    // L: storage order, the buffer holds the rows one after the other (ROW_MAJOR) or the columns (COL_MAJOR). Linear
+    // indexing, iterators, span() and the buffer ctors follow the storage order, everything addressed by (r, c) does
+    // not depend on it. A COL_MAJOR matrix adopts a Matlab/Fortran buffer as is:
+    //   tinyTools::matrix<double, std::allocator<double>, tinyTools::Layout::COL_MAJOR> const mat{rows, cols, std::move(buffer)};
+    template <numerical T, typename Allocator, Layout L>
     struct matrix
     {
         // -----------------------------------------------------------------------------------------------------------------------------------------------------
@@ -28,51 +49,36 @@ namespace tinyTools
         using reference = value &;
         using const_reference = value const &;
         using size_type = std::size_t;
-        using container_type = std::vector<T>;
+        using allocator_type = Allocator;
+        using container_type = std::vector<T, Allocator>;
+        using Direction = tinyTools::Direction;
 
-        enum struct Direction : std::uint8_t
-        {
-            NONE,
-            COLUMNS,
-            ROWS
-        };
+        static constexpr Layout layout{L};
 
         // -----------------------------------------------------------------------------------------------------------------------------------------------------
         // Ctors.
         inline explicit constexpr matrix(size_type const rows, size_type const cols)
             : rows_{rows}, cols_{cols}, totalSize_{rows * cols}
         {
-            if (rows == 0)
-            {
-                throw std::length_error("Rows can not be 0!\n");
-            }
-            if (cols == 0)
-            {
-                throw std::length_error("Cols can not be 0!\n");
-            }
-            data_.reserve(totalSize_);
+            detail::operation_scope const scope{Operation::CONSTRUCT};
+            allocate();
         }
 
         inline explicit constexpr matrix(size_type const rows, size_type const cols, T const &initialValue)
             : matrix(rows, cols)
         {
-            for (size_type i{}; i < totalSize(); ++i)
-            {
-                data_.emplace_back(initialValue);
-            }
+            data_.assign(totalSize_, initialValue);
         }
 
+        // data holds the elements in storage order.
         inline explicit constexpr matrix(size_type const rows, size_type const cols, container_type const &data)
-            : rows_{rows}, cols_{cols}, totalSize_{rows * cols}, data_{data}
+            : rows_{rows}, cols_{cols}, totalSize_{rows * cols}
         {
-            if (rows == 0)
-            {
-                throw std::length_error("Rows can not be 0!\n");
-            }
-            if (cols == 0)
-            {
-                throw std::length_error("Cols can not be 0!\n");
-            }
+            detail::operation_scope const scope{Operation::CONSTRUCT};
+            checkShape();
+            data_ = data;
+            detail::countAllocated(detail::storageBytes<T>(data_.size()));
+            detail::countCopied(detail::storageBytes<T>(data_.size()));
         }
 
         inline constexpr matrix(size_type const rows, size_type const cols, std::initializer_list<value> &&data)
@@ -80,15 +86,70 @@ namespace tinyTools
         {
         }
 
+        // Adopts the buffer, it counts as allocated here (it was built for this matrix).
         inline explicit constexpr matrix(size_type const rows, size_type const cols, container_type &&data)
-            : matrix(rows, cols)
+            : rows_{rows}, cols_{cols}, totalSize_{rows * cols}, data_{std::move(data)}
         {
-            std::swap(data_, data);
+            detail::operation_scope const scope{Operation::CONSTRUCT};
+            checkShape();
+            detail::countAllocated(detail::storageBytes<T>(data_.size()));
         }
 
         inline constexpr matrix(matrix const &rhm)
-            : matrix(rhm.rows(), rhm.cols_, rhm.data_)
+            : rows_{rhm.rows_}, cols_{rhm.cols_}, totalSize_{rhm.totalSize_}
         {
+            detail::operation_scope const scope{Operation::COPY};
+            data_ = rhm.data_;
+            detail::countAllocated(detail::storageBytes<T>(data_.size()));
+            detail::countCopied(detail::storageBytes<T>(data_.size()));
+        }
+
+        // Copies the elements seen through a view (e.g. a submatrix, row or col) into a new matrix.
+        template <typename U>
+            requires std::is_same_v<std::remove_const_t<U>, T>
+        inline constexpr matrix(matrix_view<U> const &rhv)
+            : rows_{rhv.rows()}, cols_{rhv.cols()}, totalSize_{rhv.rows() * rhv.cols()}
+        {
+            detail::operation_scope const scope{Operation::VIEW_COPY};
+            allocate();
+            detail::countCopied(detail::storageBytes<T>(totalSize_));
+            // The storage lines are the rows of src: the view itself, or its transpose for COL_MAJOR.
+            auto const src = colMajor ? rhv.t() : rhv;
+            if constexpr (!std::is_same_v<T, bool>)
+            {
+                // Lines strided in the other order, let the tiled kernel do it.
+                if (src.rowStride() == 1 && src.colStride() != 1)
+                {
+                    data_.resize(totalSize_);
+                    detail::transpose(src.ptr(), src.cols(), src.rows(), src.colStride(), data_.data(), src.cols());
+                    return;
+                }
+            }
+            for (size_type r{}; r < src.rows(); ++r)
+            {
+                if (src.colStride() == 1)
+                {
+                    auto const *const row = &src.unchecked(r, 0);
+                    data_.insert(data_.end(), row, row + src.cols());
+                    continue;
+                }
+                for (size_type c{}; c < src.cols(); ++c)
+                {
+                    data_.emplace_back(src.unchecked(r, c));
+                }
+            }
+        }
+
+        // Evaluates a lazy expression (A + B - C * 2, ...) in one fused pass.
+        template <typename E>
+            requires detail::is_expression_v<E>
+        inline matrix(E const &expr)
+            : rows_{expr.rows()}, cols_{expr.cols()}, totalSize_{expr.rows() * expr.cols()}
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            allocate();
+            data_.resize(totalSize_);
+            detail::evaluate<colMajor>(expr, data_.data());
         }
 
         inline constexpr matrix(matrix &&rhm) noexcept
@@ -109,6 +170,11 @@ namespace tinyTools
             return *this;
         }
 
+        // The expression may read this matrix through other positions (views), so it is evaluated into new storage.
+        template <typename E>
+            requires detail::is_expression_v<E>
+        inline auto operator=(E const &expr) -> matrix & { return *this = matrix(expr); }
+
         constexpr ~matrix() noexcept
         {
             data_.clear();
@@ -116,65 +182,65 @@ namespace tinyTools
 
         // -----------------------------------------------------------------------------------------------------------------------------------------------------
         // Getters.
-        [[nodiscard]] inline auto data() const noexcept -> container_type { return data_; }
+        [[nodiscard]] inline constexpr auto data() const noexcept -> container_type const & { return data_; }
         [[nodiscard]] inline constexpr auto rows() const noexcept -> size_type { return rows_; }
         [[nodiscard]] inline constexpr auto cols() const noexcept -> size_type { return cols_; }
         [[nodiscard]] inline constexpr auto totalSize() const noexcept -> size_type { return totalSize_; }
-        template <numerical L_T>
-        friend constexpr inline auto size(matrix<L_T> const &mat) noexcept -> std::tuple<std::size_t, std::size_t>;
+        [[nodiscard]] inline auto view() const noexcept -> matrix_view<T const> { return matrix_view<T const>{data_.data(), rows_, cols_, L}; }
+        [[nodiscard]] inline auto view() noexcept -> matrix_view<T> { return matrix_view<T>{data_.data(), rows_, cols_, L}; }
 
-        // -----------------------------------------------------------------------------------------------------------------------------------------------------
-        // Operators.
-        template <numerical L_T>
-        friend auto operator<<(std::ostream &os, matrix<L_T> const &rhm) -> std::ostream &;
-        [[nodiscard]] inline constexpr auto operator()(size_type r, size_type c) const -> const_reference { return op_parenthesis(*this, r, c); }
-        inline constexpr auto operator()(size_type r, size_type c) -> reference { return op_parenthesis(*this, r, c); }
-
-        inline constexpr auto operator()(size_type row, size_type col, size_type height, size_type width) const -> matrix
+        // In-place access to the storage (storage order, no copy). std::vector<bool> is packed, so bool only has iterators.
+        [[nodiscard]] inline constexpr auto begin() const noexcept { return data_.cbegin(); }
+        [[nodiscard]] inline constexpr auto end() const noexcept { return data_.cend(); }
+        [[nodiscard]] inline constexpr auto begin() noexcept { return data_.begin(); }
+        [[nodiscard]] inline constexpr auto end() noexcept { return data_.end(); }
+        [[nodiscard]] inline constexpr auto span() const noexcept -> std::span<T const>
+            requires(!std::is_same_v<T, bool>)
         {
-            if (row >= rows())
-            {
-                throw std::out_of_range(std::string{"Rows out of range, max rows= " + std::to_string(rows()) + '\n'});
-            }
-            if (col >= cols())
-            {
-                throw std::out_of_range(std::string{"Cols out of range, max cols= " + std::to_string(cols()) + '\n'});
-            }
-
-            auto const lastRow = row + height;
-            auto const lastCol = col + width;
-
-            if (lastRow > rows())
-            {
-                throw std::out_of_range("[HEIGHT] Max size out of bounds!\n");
-            }
-            if (lastCol > cols())
-            {
-                throw std::out_of_range(" [WIDHT] Max size out of bounds!\n");
-            }
+            return std::span<T const>{data_};
+        }
+        [[nodiscard]] inline constexpr auto span() noexcept -> std::span<T>
+            requires(!std::is_same_v<T, bool>)
+        {
+            return std::span<T>{data_};
+        }
+        // BLAS-style access: element (r, c) is ptr()[r * ld() + c] (ROW_MAJOR) or ptr()[c * ld() + r] (COL_MAJOR).
+        [[nodiscard]] inline constexpr auto ptr() const noexcept -> T const *
+            requires(!std::is_same_v<T, bool>)
+        {
+            return data_.data();
+        }
+        [[nodiscard]] inline constexpr auto ptr() noexcept -> T *
+            requires(!std::is_same_v<T, bool>)
+        {
+            return data_.data();
+        }
+        [[nodiscard]] inline constexpr auto ld() const noexcept -> size_type { return colMajor ? rows_ : cols_; }
+        template <numerical L_T, typename L_A, Layout L_L>
+        friend constexpr inline auto size(matrix<L_T, L_A, L_L> const &mat) noexcept -> std::tuple<std::size_t, std::size_t>;
 
-            matrix ret{height, width, 0};
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Operators.
+        template <numerical L_T, typename L_A, Layout L_L>
+        friend auto operator<<(std::ostream &os, matrix<L_T, L_A, L_L> const &rhm) -> std::ostream &;
+        [[nodiscard]] inline constexpr auto operator()(size_type r, size_type c) const -> const_reference { return op_parenthesis<detail::checkPublicAccess>(*this, r, c); }
+        inline constexpr auto operator()(size_type r, size_type c) -> reference { return op_parenthesis<detail::checkPublicAccess>(*this, r, c); }
 
-            size_type i{}; // rows;
-            for (size_type r{row}; r < lastRow; ++r)
-            {
-                size_type j{0}; // Cols.
-                for (size_type c{col}; c < lastCol; ++c)
-                {
-                    ret(i, j) = op_parenthesis(*this, r, c);
-                    ++j;
-                }
-                ++i;
-            }
+        // Kernel accessors: no bounds check in release, checked when TINYTOOLS_BOUNDS_CHECK >= 2 (DEBUG_BUILD).
+        [[nodiscard]] inline constexpr auto unchecked(size_type r, size_type c) const noexcept(!detail::checkInternalAccess) -> const_reference { return op_parenthesis<detail::checkInternalAccess>(*this, r, c); }
+        [[nodiscard]] inline constexpr auto unchecked(size_type r, size_type c) noexcept(!detail::checkInternalAccess) -> reference { return op_parenthesis<detail::checkInternalAccess>(*this, r, c); }
+        [[nodiscard]] inline constexpr auto unchecked(size_type idx) const noexcept(!detail::checkInternalAccess) -> const_reference { return op_sqBracket<detail::checkInternalAccess>(*this, idx); }
+        [[nodiscard]] inline constexpr auto unchecked(size_type idx) noexcept(!detail::checkInternalAccess) -> reference { return op_sqBracket<detail::checkInternalAccess>(*this, idx); }
 
-            return ret;
-        }
+        // Submatrix, O(1) view over this matrix storage.
+        [[nodiscard]] inline auto operator()(size_type row, size_type col, size_type height, size_type width) const -> matrix_view<T const> { return view()(row, col, height, width); }
+        [[nodiscard]] inline auto operator()(size_type row, size_type col, size_type height, size_type width) -> matrix_view<T> { return view()(row, col, height, width); }
 
         // Following matlab submatrix style: "(1:end, 1:3)"
         // inline constexpr auto operator()(std::string_view str) const -> matrix {}
 
-        inline auto operator[](size_type idx) const -> const_reference { return op_sqBracket(*this, idx); }
-        [[nodiscard]] inline auto operator[](size_type idx) -> reference { return op_sqBracket(*this, idx); }
+        inline auto operator[](size_type idx) const -> const_reference { return op_sqBracket<detail::checkPublicAccess>(*this, idx); }
+        [[nodiscard]] inline auto operator[](size_type idx) -> reference { return op_sqBracket<detail::checkPublicAccess>(*this, idx); }
 
         [[nodiscard]] inline constexpr auto operator==(matrix const &rhm) const noexcept -> bool
         {
@@ -189,89 +255,60 @@ namespace tinyTools
         }
         [[nodiscard]] inline constexpr auto operator!=(matrix const &rhm) const noexcept -> bool { return !(operator==(rhm)); }
 
-        [[nodiscard]] inline auto operator<(matrix const &rhm) const -> matrix<bool>
-        {
-            if (!sameSize(rhm))
-            {
-                throw std::invalid_argument("Matrixes are not the same size!\n");
-            }
-            std::vector<bool> data{};
-            data.reserve(totalSize());
-            for (size_type i{}; i < totalSize(); ++i)
-            {
-                data.emplace_back(data_[i] < rhm.data_[i]);
-            }
-            return matrix<bool>{rows(), cols(), std::move(data)};
-        }
-
-        [[nodiscard]] inline auto operator<=(matrix const &rhm) const -> matrix<bool>
-        {
-            if (!sameSize(rhm))
-            {
-                throw std::invalid_argument("Matrixes are not the same size!\n");
-            }
-            std::vector<bool> data{};
-            data.reserve(totalSize());
-            for (size_type i{}; i < totalSize(); ++i)
-            {
-                data.emplace_back(data_[i] <= rhm.data_[i]);
-            }
-            return matrix<bool>{rows(), cols(), std::move(data)};
-        }
-
-        [[nodiscard]] inline auto operator>(matrix const &rhm) const -> matrix<bool>
-        {
-            if (!sameSize(rhm))
-            {
-                throw std::invalid_argument("Matrixes are not the same size!\n");
-            }
-            std::vector<bool> data{};
-            data.reserve(totalSize());
-            for (size_type i{}; i < totalSize(); ++i)
-            {
-                data.emplace_back(data_[i] > rhm.data_[i]);
-            }
-            return matrix<bool>{rows(), cols(), std::move(data)};
-        }
-
-        [[nodiscard]] inline auto operator>=(matrix const &rhm) const -> matrix<bool>
-        {
-            if (!sameSize(rhm))
-            {
-                throw std::invalid_argument("Matrixes are not the same size!\n");
-            }
-            std::vector<bool> data{};
-            data.reserve(totalSize());
-            for (size_type i{}; i < totalSize(); ++i)
-            {
-                data.emplace_back(data_[i] >= rhm.data_[i]);
-            }
-            return matrix<bool>{rows(), cols(), std::move(data)};
-        }
+        [[nodiscard]] inline auto operator<(matrix const &rhm) const -> matrix<bool, std::allocator<bool>, L> { return compare(rhm, std::less<>{}); }
+        [[nodiscard]] inline auto operator<=(matrix const &rhm) const -> matrix<bool, std::allocator<bool>, L> { return compare(rhm, std::less_equal<>{}); }
+
+        [[nodiscard]] inline auto operator>(matrix const &rhm) const -> matrix<bool, std::allocator<bool>, L> { return compare(rhm, std::greater<>{}); }
+        [[nodiscard]] inline auto operator>=(matrix const &rhm) const -> matrix<bool, std::allocator<bool>, L> { return compare(rhm, std::greater_equal<>{}); }
+
+        // Packed comparisons (Matlab: lt, le, gt, ge, eq, ne) against a matrix of the same size or a scalar.
+        // The SIMD kernel writes the mask words directly, use them for logical indexing (select, assign).
+        // bit_mask is row-major, so the mask operations are only there for ROW_MAJOR storage.
+        [[nodiscard]] inline auto lt(matrix const &rhm) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(rhm, std::less<>{}); }
+        [[nodiscard]] inline auto le(matrix const &rhm) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(rhm, std::less_equal<>{}); }
+        [[nodiscard]] inline auto gt(matrix const &rhm) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(rhm, std::greater<>{}); }
+        [[nodiscard]] inline auto ge(matrix const &rhm) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(rhm, std::greater_equal<>{}); }
+        [[nodiscard]] inline auto eq(matrix const &rhm) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(rhm, std::equal_to<>{}); }
+        [[nodiscard]] inline auto ne(matrix const &rhm) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(rhm, std::not_equal_to<>{}); }
+
+        [[nodiscard]] inline auto lt(T const &scalar) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(scalar, std::less<>{}); }
+        [[nodiscard]] inline auto le(T const &scalar) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(scalar, std::less_equal<>{}); }
+        [[nodiscard]] inline auto gt(T const &scalar) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(scalar, std::greater<>{}); }
+        [[nodiscard]] inline auto ge(T const &scalar) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(scalar, std::greater_equal<>{}); }
+        [[nodiscard]] inline auto eq(T const &scalar) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(scalar, std::equal_to<>{}); }
+        [[nodiscard]] inline auto ne(T const &scalar) const -> bit_mask requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR) { return compare_mask(scalar, std::not_equal_to<>{}); }
 
         inline constexpr auto operator+=(matrix const &rhm) noexcept -> matrix &
         {
-            for (size_type i{}; i < totalSize_; ++i)
-            {
-                data_[i] += rhm.data_[i];
-            }
+            apply(rhm, detail::simd::add{});
             return *this;
         }
+        // matrix<bool> is no expression operand, its binary operators stay eager.
         [[nodiscard]] friend constexpr auto operator+(matrix lhm, matrix const &rhm) noexcept -> matrix
+            requires std::is_same_v<T, bool>
         {
             lhm += rhm;
             return lhm;
         }
 
+        template <typename U>
+        inline auto operator+=(matrix_view<U> const &rhv) -> matrix &
+        {
+            apply(rhv, detail::simd::add{});
+            return *this;
+        }
+
+        template <typename E>
+            requires detail::is_expression_v<E>
+        inline auto operator+=(E const &expr) -> matrix & { return *this = *this + expr; }
+
         inline constexpr auto operator+=(T const &scalar) noexcept -> matrix &
         {
-            for (auto &d : data_)
-            {
-                d += scalar;
-            }
+            apply(scalar, detail::simd::add{});
             return *this;
         }
         [[nodiscard]] friend constexpr auto operator+(matrix lhm, T const &scalar) noexcept -> matrix
+            requires std::is_same_v<T, bool>
         {
             lhm += scalar;
             return lhm;
@@ -279,27 +316,34 @@ namespace tinyTools
 
         inline constexpr auto operator-=(matrix const &rhm) noexcept -> matrix &
         {
-            for (size_type i{}; i < totalSize_; ++i)
-            {
-                data_[i] -= rhm.data_[i];
-            }
+            apply(rhm, detail::simd::sub{});
             return *this;
         }
         [[nodiscard]] friend constexpr auto operator-(matrix lhm, matrix const &rhm) noexcept -> matrix
+            requires std::is_same_v<T, bool>
         {
             lhm -= rhm;
             return lhm;
         }
 
+        template <typename U>
+        inline auto operator-=(matrix_view<U> const &rhv) -> matrix &
+        {
+            apply(rhv, detail::simd::sub{});
+            return *this;
+        }
+
+        template <typename E>
+            requires detail::is_expression_v<E>
+        inline auto operator-=(E const &expr) -> matrix & { return *this = *this - expr; }
+
         inline constexpr auto operator-=(T const &scalar) noexcept -> matrix &
         {
-            for (auto &d : data_)
-            {
-                d -= scalar;
-            }
+            apply(scalar, detail::simd::sub{});
             return *this;
         }
         [[nodiscard]] friend constexpr auto operator-(matrix lhm, T const &scalar) noexcept -> matrix
+            requires std::is_same_v<T, bool>
         {
             lhm -= scalar;
             return lhm;
@@ -307,64 +351,84 @@ namespace tinyTools
 
         [[nodiscard]] inline constexpr auto operator*(matrix const &rhm) const -> matrix
         {
+            detail::operation_scope const scope{Operation::MULTIPLY};
             if (cols() != rhm.rows())
             {
                 throw std::invalid_argument("Matrixes left-matrix cols must be same size as right-matrix rows.\n");
             }
             matrix ret{rows(), rhm.cols(), 0};
-            auto const totalSize = rows() * rhm.cols();
 
-            for (size_type i{}; i < totalSize; ++i)
+            if constexpr (std::is_same_v<T, bool>)
             {
-                for (size_type r{}; r < cols(); ++r)
+                // std::vector<bool> has no contiguous storage, keep the reference triple loop.
+                for (size_type r{}; r < rows(); ++r)
                 {
-                    ret[i] += op_parenthesis(*this, i / rows(), r) * rhm(r, i % rhm.cols());
+                    for (size_type c{}; c < rhm.cols(); ++c)
+                    {
+                        for (size_type k{}; k < cols(); ++k)
+                        {
+                            ret.data_[ret.offset(r, c)] = ret.data_[ret.offset(r, c)] || (data_[offset(r, k)] && rhm.data_[rhm.offset(k, c)]);
+                        }
+                    }
                 }
             }
-
-            return ret;
-        }
-
-        // -----------------------------------------------------------------------------------------------------------------------------------------------------
-        // Methods.
-        [[nodiscard]] inline static constexpr auto invalid() noexcept -> matrix { return matrix{}; }
-        [[nodiscard]] inline constexpr auto sameSize(matrix const &rhm) const noexcept -> bool { return (rows() == rhm.rows() && cols() == rhm.cols() && totalSize_ == rhm.totalSize()); }
-        [[nodiscard]] inline constexpr auto getRow(size_type const row) const -> matrix
-        {
-            if (row >= rows())
+            else
             {
-                throw std::out_of_range(std::string{"Rows out of range, max rows= " + std::to_string(rows()) + '\n'});
+                // The packing of the GEMM reads either order, COL_MAJOR operands are passed with swapped strides.
+                detail::multiply<T>(rows(), rhm.cols(), cols(), operand(), rhm.operand(), ret.operand());
             }
 
-            matrix ret{1, cols(), 0};
-            for (size_type i{}; i < cols(); ++i)
-            {
-                ret[i] = op_parenthesis(*this, row, i);
-            }
             return ret;
         }
 
-        [[nodiscard]] inline constexpr auto getCol(size_type const col) const -> matrix
+        template <typename U>
+        [[nodiscard]] inline auto operator*(matrix_view<U> const &rhv) const -> matrix
         {
-            if (col >= cols())
+            detail::operation_scope const scope{Operation::MULTIPLY};
+            static_assert(std::is_same_v<T, std::remove_const_t<U>>, "Matrixes must have the same value type.");
+            if (cols() != rhv.rows())
             {
-                throw std::out_of_range(std::string{"Cols out of range, max cols= " + std::to_string(cols()) + '\n'});
+                throw std::invalid_argument("Matrixes left-matrix cols must be same size as right-matrix rows.\n");
             }
+            matrix ret{rows(), rhv.cols(), 0};
+            detail::multiply<T>(rows(), rhv.cols(), cols(), operand(), {rhv.ptr(), rhv.rowStride(), rhv.colStride()}, ret.operand());
+            return ret;
+        }
 
-            matrix ret{rows(), 1, 0};
-            for (size_type i{}; i < rows(); ++i)
-            {
-                ret[i] = op_parenthesis(*this, i, col);
-            }
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Methods.
+        [[nodiscard]] inline static constexpr auto invalid() noexcept -> matrix { return matrix{}; }
+        [[nodiscard]] inline constexpr auto sameSize(matrix const &rhm) const noexcept -> bool { return (rows() == rhm.rows() && cols() == rhm.cols() && totalSize_ == rhm.totalSize()); }
+        [[nodiscard]] inline auto getRow(size_type const row) const -> matrix_view<T const> { return view().getRow(row); }
+        [[nodiscard]] inline auto getRow(size_type const row) -> matrix_view<T> { return view().getRow(row); }
+        // Transposes. t() is a lazy view (no data moves), transpose() a tiled copy and transposeInPlace() reuses the buffer.
+        [[nodiscard]] inline auto t() const noexcept -> matrix_view<T const> { return view().t(); }
+        [[nodiscard]] inline auto t() noexcept -> matrix_view<T> { return view().t(); }
+        [[nodiscard]] inline auto transpose() const -> matrix
+            requires(!std::is_same_v<T, bool>)
+        {
+            matrix ret{cols_, rows_};
+            ret.data_.resize(totalSize_);
+            detail::transpose(data_.data(), lines(), ld(), ld(), ret.data_.data(), lines());
             return ret;
         }
+        inline auto transposeInPlace() -> matrix &
+            requires(!std::is_same_v<T, bool>)
+        {
+            detail::transpose_inplace(data_.data(), lines(), ld());
+            std::swap(rows_, cols_);
+            return *this;
+        }
+
+        [[nodiscard]] inline auto getCol(size_type const col) const -> matrix_view<T const> { return view().getCol(col); }
+        [[nodiscard]] inline auto getCol(size_type const col) -> matrix_view<T> { return view().getCol(col); }
 
         [[nodiscard]] inline static constexpr auto identity(size_type const size) noexcept
         {
             matrix ret{size, size, 0};
             for (size_type i{}; i < size; ++i)
             {
-                ret(i, i) = 1;
+                ret.unchecked(i, i) = 1;
             }
             return ret;
         }
@@ -374,17 +438,43 @@ namespace tinyTools
         [[nodiscard]] inline static constexpr auto zeros(size_type size) noexcept -> matrix { return zeros(size, size); }
         [[nodiscard]] inline static constexpr auto zeros(size_type rows, size_type cols) noexcept -> matrix { return matrix{rows, cols, 0}; }
         [[nodiscard]] inline static constexpr auto random(size_type size) noexcept -> matrix { return random(size, size); }
+        // Legacy std::rand sequence (kept for reproducing old fixtures): integers in [0, max), floating point in [0, max].
         [[nodiscard]] inline static constexpr auto random(size_type rows, size_type cols, T max = std::numeric_limits<T>::max()) noexcept -> matrix
         {
             matrix ret{rows, cols, 1};
             auto const totalSize = rows * cols;
             for (size_type i{}; i < totalSize; ++i)
             {
-                ret[i] = static_cast<T>(std::rand()) % max;
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    ret.unchecked(i) = static_cast<T>(std::rand()) / static_cast<T>(RAND_MAX) * max;
+                }
+                else
+                {
+                    ret.unchecked(i) = static_cast<T>(std::rand()) % max;
+                }
             }
             return ret;
         }
 
+        // Counter-based generator, same values for any thread count (see random.hpp). (Matlab: rand, randi, randn)
+        // Integers in [lo, hi], floating point in [lo, hi).
+        [[nodiscard]] inline static auto random(size_type rows, size_type cols, T lo, T hi, rng &gen) -> matrix
+            requires(!std::is_same_v<T, bool>)
+        {
+            matrix ret{rows, cols, T{}};
+            gen.uniform(ret.span(), lo, hi);
+            return ret;
+        }
+
+        [[nodiscard]] inline static auto randn(size_type rows, size_type cols, rng &gen, T mean = T{}, T stddev = T{1}) -> matrix
+            requires std::is_floating_point_v<T>
+        {
+            matrix ret{rows, cols, T{}};
+            gen.normal(ret.span(), mean, stddev);
+            return ret;
+        }
+
         // Multiply point by point. (Matlab: .*)
         inline constexpr auto multiply(matrix const &rhm) -> void
         {
@@ -392,178 +482,488 @@ namespace tinyTools
             {
                 throw std::invalid_argument("Matrixes must have same size!");
             }
-            for (size_type i{}; i < totalSize(); ++i)
+            apply(rhm, detail::simd::mul{});
+        }
+        template <typename U>
+        inline auto multiply(matrix_view<U> const &rhv) -> void { apply(rhv, detail::simd::mul{}); }
+
+        // Logical indexing. select copies the elements under the mask in row-major order into a column (Matlab: A(mask)),
+        // an empty selection throws like any empty matrix. assign writes a scalar (A(mask) = v) or the elements of rhm
+        // at the same positions (A(mask) = B(mask)). Full mask words are copied as runs of 64 elements.
+        [[nodiscard]] inline auto select(bit_mask const &mask) const -> matrix
+            requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR)
+        {
+            checkMask(mask);
+            container_type data(mask.count(), T{}, data_.get_allocator());
+            auto *out = data.data();
+            forEachMaskRun(mask, [this, &out](size_type begin, size_type length)
+                           {
+                               out = std::copy_n(data_.data() + begin, length, out);
+                           });
+            return matrix{data.size(), 1, std::move(data)};
+        }
+
+        inline auto assign(bit_mask const &mask, T const &scalar) -> matrix &
+            requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR)
+        {
+            checkMask(mask);
+            forEachMaskRun(mask, [this, &scalar](size_type begin, size_type length) { std::fill_n(data_.data() + begin, length, scalar); });
+            return *this;
+        }
+
+        inline auto assign(bit_mask const &mask, matrix const &rhm) -> matrix &
+            requires(!std::is_same_v<T, bool> && L == Layout::ROW_MAJOR)
+        {
+            checkMask(mask);
+            if (!sameSize(rhm))
             {
-                data_[i] *= rhm[i];
+                throw std::invalid_argument("Matrixes are not the same size!\n");
             }
+            forEachMaskRun(mask, [this, &rhm](size_type begin, size_type length)
+                           {
+                               std::copy_n(rhm.data_.data() + begin, length, data_.data() + begin);
+                           });
+            return *this;
         }
 
-        template <numerical L_T>
-        friend constexpr auto multiply(matrix<L_T> const &lhm, matrix<L_T> const &rhm) -> matrix<L_T>;
+        // Reductions, see matrix_view. Direction::COLUMNS -> 1 x cols(), Direction::ROWS -> rows() x 1, no Direction -> scalar.
+        template <typename U>
+        using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+        [[nodiscard]] inline auto sum(Direction dir) const -> matrix { return view().template sum<Allocator, L>(dir); }
+        [[nodiscard]] inline auto prod(Direction dir) const -> matrix { return view().template prod<Allocator, L>(dir); }
+        [[nodiscard]] inline auto min(Direction dir) const -> matrix { return view().template min<Allocator, L>(dir); }
+        [[nodiscard]] inline auto max(Direction dir) const -> matrix { return view().template max<Allocator, L>(dir); }
+        [[nodiscard]] inline auto mean(Direction dir) const { return view().template mean<rebind_allocator<detail::mean_t<T>>, L>(dir); }
+        [[nodiscard]] inline auto any(Direction dir) const -> matrix<bool, rebind_allocator<bool>, L> { return reduce_bool<detail::reduce_any>(dir); }
+        [[nodiscard]] inline auto all(Direction dir) const -> matrix<bool, rebind_allocator<bool>, L> { return reduce_bool<detail::reduce_all>(dir); }
 
-        [[nodiscard]] inline constexpr auto sum(Direction dir) const -> matrix
+        [[nodiscard]] inline auto sum() const -> T { return view().sum(); }
+        [[nodiscard]] inline auto prod() const -> T { return view().prod(); }
+        [[nodiscard]] inline auto min() const -> T { return view().min(); }
+        [[nodiscard]] inline auto max() const -> T { return view().max(); }
+        [[nodiscard]] inline auto mean() const { return view().mean(); }
+        [[nodiscard]] inline auto any() const -> bool
         {
-            if (dir == Direction::NONE)
+            if constexpr (std::is_same_v<T, bool>)
             {
-                throw std::invalid_argument("Direction must be Columns (1) or Rows (2).\n");
+                return std::find(data_.begin(), data_.end(), true) != data_.end();
             }
-
-            if (dir == Direction::COLUMNS)
+            else
             {
-                matrix ret{1, cols(), 0};
-                for (size_type c{}; c < cols(); ++c)
-                {
-                    auto const &column = getCol(c).data();
-                    ret(0, c) = std::accumulate(column.begin(), column.end(), 0);
-                }
-                return ret;
+                return view().any();
             }
-
-            // Direction::ROWS.
-            matrix ret{rows(), 1, 0};
-            for (size_type r{}; r < rows(); ++r)
+        }
+        [[nodiscard]] inline auto all() const -> bool
+        {
+            if constexpr (std::is_same_v<T, bool>)
             {
-                auto const &row = getRow(r).data();
-                ret(r, 0) = std::accumulate(row.begin(), row.end(), 0);
+                return std::find(data_.begin(), data_.end(), false) == data_.end();
+            }
+            else
+            {
+                return view().all();
             }
-            return ret;
         }
 
-        template <numerical L_T>
-        friend constexpr auto cat(Direction dir, matrix<L_T> const &lhm, matrix<L_T> const &rhm) -> matrix<L_T>;
-
-        template <numerical L_T, typename... args_t>
-        friend constexpr auto cat(Direction dir, matrix<L_T> const &lhm, matrix<L_T> const &rhm, args_t &&...args) -> matrix<L_T>;
+        template <numerical L_T, typename L_A, Layout L_L>
+        friend struct matrix;
 
     private:
         inline explicit constexpr matrix() noexcept = default;
 
+        static constexpr bool colMajor{L == Layout::COL_MAJOR};
+
         size_type rows_{};
         size_type cols_{};
         size_type totalSize_{rows_ * cols_};
         container_type data_{};
 
-        // -----------------------------------------------------------------------------------------------------------------------------------------------------
-        // Deducing This (C++20 Style). TODO: C++23
-        template <typename This>
-        [[nodiscard]] static inline auto op_parenthesis(This &instance, size_type r, size_type c) -> auto &
+        // Storage lines: rows for ROW_MAJOR, columns for COL_MAJOR, each ld() elements long.
+        [[nodiscard]] inline constexpr auto lines() const noexcept -> size_type { return colMajor ? cols_ : rows_; }
+        [[nodiscard]] inline constexpr auto offset(size_type r, size_type c) const noexcept -> size_type { return colMajor ? c * rows_ + r : r * cols_ + c; }
+
+        [[nodiscard]] inline auto operand() const noexcept -> detail::gemm_operand<T const>
         {
-            if (r >= instance.rows())
+            return colMajor ? detail::gemm_operand<T const>{data_.data(), 1, rows_} : detail::gemm_operand<T const>{data_.data(), cols_, 1};
+        }
+        [[nodiscard]] inline auto operand() noexcept -> detail::gemm_operand<T>
+        {
+            return colMajor ? detail::gemm_operand<T>{data_.data(), 1, rows_} : detail::gemm_operand<T>{data_.data(), cols_, 1};
+        }
+
+        inline constexpr auto checkShape() const -> void
+        {
+            if (rows_ == 0)
             {
-                throw std::out_of_range(std::string{"Rows out of range, max rows= " + std::to_string(instance.rows()) + '\n'});
+                throw std::length_error("Rows can not be 0!\n");
             }
-            if (c >= instance.cols())
+            if (cols_ == 0)
             {
-                throw std::out_of_range(std::string{"Cols out of range, max cols= " + std::to_string(instance.cols()) + '\n'});
+                throw std::length_error("Cols can not be 0!\n");
             }
-            return instance.data_[r * instance.cols_ + c];
         }
 
-        template <typename This>
-        [[nodiscard]] static inline auto op_sqBracket(This &instance, size_type idx) -> auto &
+        // Reserves the buffer of the shape, the elements are appended or resized in by the ctor.
+        inline constexpr auto allocate() -> void
         {
-            if (idx >= instance.totalSize())
+            checkShape();
+            data_.reserve(totalSize_);
+            detail::countAllocated(detail::storageBytes<T>(totalSize_));
+        }
+
+        template <typename compare_t>
+        [[nodiscard]] inline auto compare(matrix const &rhm, compare_t cmp) const -> matrix<bool, std::allocator<bool>, L>
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            if (!sameSize(rhm))
             {
-                throw std::out_of_range(std::string{"Index out of range, max= " + std::to_string(instance.totalSize()) + '\n'});
+                throw std::invalid_argument("Matrixes are not the same size!\n");
             }
-            return instance.data_[idx];
+            std::vector<bool> data(totalSize());
+            detail::for_each_chunk(totalSize(), [this, &rhm, &data, cmp](size_type begin, size_type end)
+                                   {
+                                       if constexpr (std::is_same_v<T, bool>)
+                                       {
+                                           for (auto i{begin}; i < end; ++i)
+                                           {
+                                               data[i] = cmp(data_[i], rhm.data_[i]);
+                                           }
+                                       }
+                                       else
+                                       {
+                                           // Compare a block with the SIMD kernel, then pack it into the bit vector.
+                                           constexpr size_type block{256};
+                                           std::array<bool, block> result{};
+                                           for (auto i{begin}; i < end; i += block)
+                                           {
+                                               auto const n = std::min(block, end - i);
+                                               detail::simd::compare(result.data(), data_.data() + i, rhm.data_.data() + i, n, cmp);
+                                               for (size_type j{}; j < n; ++j)
+                                               {
+                                                   data[i + j] = result[j];
+                                               }
+                                           }
+                                       }
+                                   });
+            return matrix<bool, std::allocator<bool>, L>{rows(), cols(), std::move(data)};
+        }
+
+        // rhs is a same size matrix or a scalar broadcast, every chunk writes whole mask words.
+        template <typename rhs_t, typename compare_t>
+        [[nodiscard]] inline auto compare_mask(rhs_t const &rhs, compare_t cmp) const -> bit_mask
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            if constexpr (std::is_same_v<rhs_t, matrix>)
+            {
+                if (!sameSize(rhs))
+                {
+                    throw std::invalid_argument("Matrixes are not the same size!\n");
+                }
+            }
+            bit_mask ret{rows(), cols()};
+            auto const words = ret.words();
+            detail::for_each_chunk(words.size(), bit_mask::wordBits, [this, words, &rhs, cmp](size_type begin, size_type end)
+                                   {
+                                       auto const first = begin * bit_mask::wordBits;
+                                       auto const n = std::min(end * bit_mask::wordBits, totalSize()) - first;
+                                       if constexpr (std::is_same_v<rhs_t, matrix>)
+                                       {
+                                           detail::simd::compare_mask(words.data() + begin, data_.data() + first, rhs.data_.data() + first, n, cmp);
+                                       }
+                                       else
+                                       {
+                                           detail::simd::compare_mask(words.data() + begin, data_.data() + first, detail::simd::broadcast<T>{rhs}, n, cmp);
+                                       }
+                                   });
+            return ret;
         }
-    };
 
-    template <numerical L_T>
-    auto operator<<(std::ostream &os, matrix<L_T> const &rhm) -> std::ostream &
-    {
-        typename matrix<L_T>::size_type i{0};
-        for (auto const d : rhm.data_)
+        inline auto checkMask(bit_mask const &mask) const -> void
+        {
+            if (mask.rows() != rows() || mask.cols() != cols())
+            {
+                throw std::invalid_argument("Mask is not the same size as the matrix!\n");
+            }
+        }
+
+        // Calls func(begin, length) for every run of true bits: a full word is one run of 64, the rest one run per bit.
+        template <typename func_t>
+        static inline auto forEachMaskRun(bit_mask const &mask, func_t func) -> void
         {
-            os << d;
-            if (++i == rhm.cols())
+            auto const words = mask.words();
+            for (size_type w{}; w < words.size(); ++w)
             {
-                os << '\n';
-                i = 0;
+                if (words[w] == ~bit_mask::word_type{})
+                {
+                    func(w * bit_mask::wordBits, bit_mask::wordBits);
+                    continue;
+                }
+                for (auto word = words[w]; word != 0; word &= word - 1)
+                {
+                    func(w * bit_mask::wordBits + static_cast<size_type>(std::countr_zero(word)), 1);
+                }
+            }
+        }
+
+        // any/all, std::vector<bool> has no pointer to hand to the reduction engine so bool walks the bits.
+        template <typename op_t>
+        [[nodiscard]] inline auto reduce_bool(Direction dir) const -> matrix<bool, rebind_allocator<bool>, L>
+        {
+            detail::operation_scope const scope{Operation::REDUCE};
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                if (dir == Direction::NONE)
+                {
+                    throw std::invalid_argument("Direction must be Columns (1) or Rows (2).\n");
+                }
+                auto const columns = dir == Direction::COLUMNS;
+                matrix<bool, rebind_allocator<bool>, L> ret{columns ? 1 : rows_, columns ? cols_ : 1, op_t::template identity<bool>()};
+                for (size_type r{}; r < rows_; ++r)
+                {
+                    for (size_type c{}; c < cols_; ++c)
+                    {
+                        auto const idx = columns ? c : r;
+                        ret.data_[idx] = op_t{}(static_cast<bool>(ret.data_[idx]), static_cast<bool>(data_[offset(r, c)]));
+                    }
+                }
+                return ret;
+            }
+            else if constexpr (std::is_same_v<op_t, detail::reduce_any>)
+            {
+                return view().template any<rebind_allocator<bool>, L>(dir);
             }
             else
             {
-                os << ' ';
+                return view().template all<rebind_allocator<bool>, L>(dir);
+            }
+        }
+
+        // True when the elements of rhv share memory with this buffer.
+        template <typename U>
+        [[nodiscard]] inline auto overlaps(matrix_view<U> const &rhv) const noexcept -> bool
+        {
+            if (rhv.rows() == 0 || rhv.cols() == 0)
+            {
+                return false;
+            }
+            auto const *const first = static_cast<T const *>(rhv.ptr());
+            auto const *const last = first + (rhv.rows() - 1) * rhv.rowStride() + (rhv.cols() - 1) * rhv.colStride();
+            return std::less_equal<>{}(data_.data(), last) && std::less<>{}(first, data_.data() + totalSize_);
+        }
+
+        // Element-wise data_(r, c) = op(data_(r, c), rhv(r, c)), SIMD kernel per storage line when the view reads it contiguously.
+        template <typename U, typename op_t>
+        inline auto apply(matrix_view<U> const &rhv, op_t op) -> void
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            if (rows() != rhv.rows() || cols() != rhv.cols())
+            {
+                throw std::invalid_argument("Matrixes must have same size!");
+            }
+            // A view into this buffer (A += A.t()) would read elements the loop already wrote: apply a copy instead.
+            if (overlaps(rhv))
+            {
+                apply(matrix{rhv}, op);
+                return;
+            }
+            // Rows of src are the storage lines of this matrix.
+            auto const src = colMajor ? rhv.t() : rhv;
+            auto const length = ld();
+            detail::for_each_chunk(lines(), length, [this, src, length, op](size_type begin, size_type end)
+                                   {
+                                       for (auto r{begin}; r < end; ++r)
+                                       {
+                                           auto *const line = data_.data() + r * length;
+                                           if (src.colStride() == 1)
+                                           {
+                                               detail::simd::binary(line, line, &src.unchecked(r, 0), length, op);
+                                               continue;
+                                           }
+                                           for (size_type c{}; c < length; ++c)
+                                           {
+                                               line[c] = op(line[c], src.unchecked(r, c));
+                                           }
+                                       }
+                                   });
+        }
+
+        // Element-wise data_[i] = op(data_[i], rhm[i]), SIMD kernel per chunk.
+        template <typename op_t>
+        inline auto apply(matrix const &rhm, op_t op) noexcept -> void
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            detail::for_each_chunk(totalSize_, [this, &rhm, op](size_type begin, size_type end)
+                                   {
+                                       if constexpr (std::is_same_v<T, bool>)
+                                       {
+                                           for (auto i{begin}; i < end; ++i)
+                                           {
+                                               data_[i] = op(static_cast<bool>(data_[i]), static_cast<bool>(rhm.data_[i]));
+                                           }
+                                       }
+                                       else
+                                       {
+                                           detail::simd::binary(data_.data() + begin, data_.data() + begin, rhm.data_.data() + begin, end - begin, op);
+                                       }
+                                   });
+        }
+
+        // Element-wise data_[i] = op(data_[i], scalar), SIMD kernel per chunk.
+        template <typename op_t>
+        inline auto apply(T const &scalar, op_t op) noexcept -> void
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            detail::for_each_chunk(totalSize_, [this, &scalar, op](size_type begin, size_type end)
+                                   {
+                                       if constexpr (std::is_same_v<T, bool>)
+                                       {
+                                           for (auto i{begin}; i < end; ++i)
+                                           {
+                                               data_[i] = op(static_cast<bool>(data_[i]), scalar);
+                                           }
+                                       }
+                                       else
+                                       {
+                                           detail::simd::binary_scalar(data_.data() + begin, data_.data() + begin, scalar, end - begin, op);
+                                       }
+                                   });
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Deducing This (C++20 Style). TODO: C++23
+        template <bool checked, typename This>
+        [[nodiscard]] static inline auto op_parenthesis(This &instance, size_type r, size_type c) noexcept(!checked) -> auto &
+        {
+            detail::checkIndex<checked>(r, c, instance.rows_, instance.cols_);
+            return instance.data_[instance.offset(r, c)];
+        }
+
+        template <bool checked, typename This>
+        [[nodiscard]] static inline auto op_sqBracket(This &instance, size_type idx) noexcept(!checked) -> auto &
+        {
+            detail::checkIndex<checked>(idx, instance.totalSize_);
+            return instance.data_[idx];
+        }
+    };
+
+    template <numerical L_T, typename L_A, Layout L_L>
+    auto operator<<(std::ostream &os, matrix<L_T, L_A, L_L> const &rhm) -> std::ostream &
+    {
+        if constexpr (std::is_same_v<L_T, bool>)
+        {
+            for (std::size_t r{}; r < rhm.rows(); ++r)
+            {
+                for (std::size_t c{}; c < rhm.cols(); ++c)
+                {
+                    os << rhm.data_[rhm.offset(r, c)] << (c + 1 == rhm.cols() ? '\n' : ' ');
+                }
             }
+            return os;
+        }
+        else
+        {
+            return os << rhm.view();
         }
-        return os;
     }
 
     // -----------------------------------------------------------------------------------------------------------------------------------------------------
     // Friend.
-    template <numerical L_T>
-    [[nodiscard]] constexpr inline auto size(matrix<L_T> const &mat) noexcept -> std::tuple<std::size_t, std::size_t>
+    template <numerical L_T, typename L_A, Layout L_L>
+    [[nodiscard]] constexpr inline auto size(matrix<L_T, L_A, L_L> const &mat) noexcept -> std::tuple<std::size_t, std::size_t>
     {
         return std::tuple{mat.rows_, mat.cols_};
     }
 
-    template <numerical L_T>
-    [[nodiscard]] constexpr auto multiply(matrix<L_T> const &lhm, matrix<L_T> const &rhm) -> matrix<L_T>
+    namespace detail
     {
-        auto ret{lhm};
-        ret.multiply(rhm);
-        return ret;
-    }
-
-    template <numerical L_T>
-    [[nodiscard]] constexpr auto cat(typename matrix<L_T>::Direction dir, matrix<L_T> const &lhm, matrix<L_T> const &rhm) -> matrix<L_T>
-    {
-        using Direction = typename matrix<L_T>::Direction;
-
-        // TODO: Not tested!
-        auto const lh_r = lhm.rows();
-        auto const lh_c = lhm.cols();
+        template <typename T>
+        inline constexpr bool is_matrix_v{false};
 
-        auto const rh_r = rhm.rows();
-        auto const rh_c = lhm.cols();
+        template <numerical T, typename Allocator, Layout L>
+        inline constexpr bool is_matrix_v<matrix<T, Allocator, L>>{true};
 
-        if (dir == Direction::ROWS)
+        // Final shape first, then one allocation and one pass: whole buffers when the direction follows the storage lines
+        // (ROWS of ROW_MAJOR, COLUMNS of COL_MAJOR), otherwise a line run of every input per output line (vector::insert
+        // copies them with memmove, bool goes through its packed iterators).
+        template <typename matrix_t, typename range_t>
+        [[nodiscard]] inline auto concatenate(Direction dir, range_t const &mats) -> matrix_t
         {
-            auto ret = matrix{lh_r + rh_r, lh_c};
+            operation_scope const scope{Operation::CAT};
+            if (dir == Direction::NONE)
+            {
+                throw std::invalid_argument("Direction must be Columns (1) or Rows (2).\n");
+            }
+            if (std::ranges::empty(mats))
+            {
+                throw std::length_error("Nothing to concatenate!\n");
+            }
 
-            for (std::size_t c{}; c < lh_c; ++c)
-            {                                        // For all columns.
-                for (std::size_t r{}; r < lh_r; ++r) // Copy all rows from left hand matrix.
+            matrix_t const &first = *std::ranges::begin(mats);
+            auto const byRows = dir == Direction::ROWS;
+            auto rows = byRows ? std::size_t{} : first.rows();
+            auto cols = byRows ? first.cols() : std::size_t{};
+            for (matrix_t const &mat : mats)
+            {
+                if (byRows)
                 {
-                    ret(r, c) = lhm(r, c);
+                    if (mat.cols() != cols)
+                    {
+                        throw std::invalid_argument("Matrices must have the same number of columns!\n");
+                    }
+                    rows += mat.rows();
                 }
-
-                for (std::size_t r{}; r < rh_r; ++r) // Copy all rows from right hand matrix.
+                else
                 {
-                    ret(r + lh_r, c) = rhm(r, c);
+                    if (mat.rows() != rows)
+                    {
+                        throw std::invalid_argument("Matrices must have the same number of rows!\n");
+                    }
+                    cols += mat.cols();
                 }
             }
 
-            return ret;
-        }
-        else if (dir == Direction::COLUMNS)
-        {
-            auto ret = matrix{lh_r, lh_c + rh_c};
-
-            for (std::size_t r{}; r < lh_r; ++r)
+            typename matrix_t::container_type data(first.data().get_allocator());
+            data.reserve(rows * cols);
+            auto const colMajor = matrix_t::layout == Layout::COL_MAJOR;
+            if (byRows != colMajor)
             {
-                for (std::size_t c{}; c < lh_c; ++c)
-                    ret(r, c) = lhm(r, c);
-
-                for (std::size_t c{}; c < rh_c; ++c)
-                    ret(r, c + lh_c) = rhm(r, c);
+                for (matrix_t const &mat : mats)
+                {
+                    data.insert(data.end(), mat.begin(), mat.end());
+                }
             }
-
-            return ret;
-        }
-        else
-        {
-            std::cerr << "You can't provide NONE as Direction\n";
-            return {};
+            else
+            {
+                for (std::size_t line{}; line < (colMajor ? cols : rows); ++line)
+                {
+                    for (matrix_t const &mat : mats)
+                    {
+                        auto const run = mat.begin() + static_cast<std::ptrdiff_t>(line * mat.ld());
+                        data.insert(data.end(), run, run + static_cast<std::ptrdiff_t>(mat.ld()));
+                    }
+                }
+            }
+            countCopied(storageBytes<typename matrix_t::value>(data.size()));
+            return matrix_t{rows, cols, std::move(data)};
         }
+    } // namespace detail
+
+    // Concatenation (Matlab: cat). ROWS stacks the matrices vertically, COLUMNS side by side.
+    //   auto const mat = cat(Direction::ROWS, matA, matB, matC);
+    template <numerical L_T, typename L_A, Layout L_L, std::same_as<matrix<L_T, L_A, L_L>>... args_t>
+    [[nodiscard]] inline auto cat(Direction dir, matrix<L_T, L_A, L_L> const &lhm, matrix<L_T, L_A, L_L> const &rhm, args_t const &...args) -> matrix<L_T, L_A, L_L>
+    {
+        std::array<std::reference_wrapper<matrix<L_T, L_A, L_L> const>, 2 + sizeof...(args_t)> const mats{lhm, rhm, args...};
+        return detail::concatenate<matrix<L_T, L_A, L_L>>(dir, mats);
     }
 
-    template <numerical L_T, typename... args_t>
-    [[nodiscard]] constexpr auto cat(typename matrix<L_T>::Direction dir, matrix<L_T> const &lhm, matrix<L_T> const &rhm, args_t &&...args) -> matrix<L_T>
+    // Any number of blocks known at run time (std::vector, std::span, std::array, ...).
+    template <std::ranges::forward_range range_t>
+        requires detail::is_matrix_v<std::ranges::range_value_t<range_t>>
+    [[nodiscard]] inline auto cat(Direction dir, range_t const &mats) -> std::ranges::range_value_t<range_t>
     {
-        // TODO: Not tested!
-        return cat(dir, cat(dir, lhm, rhm), std::forward<args_t>(args)...);
+        return detail::concatenate<std::ranges::range_value_t<range_t>>(dir, mats);
     }
 
 } // namespace tinyTools
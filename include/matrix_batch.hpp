@@ -0,0 +1,471 @@
+#ifndef MATRIX_BATCH_HPP
+#define MATRIX_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/bounds.hpp"
+#include "detail/simd.hpp"
+#include "instrument.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+// Many same-shape small matrices in one buffer: one allocation for the whole batch instead of one per matrix.
+//   INTERLEAVED: element (r, c) of every matrix is contiguous, matrix b is lane b ([(r * cols + c) * count + b]). The
+//                kernels run their innermost loop across the batch, so each SIMD lane works on a different matrix.
+//   STRIDED:     matrix b is a contiguous row-major block ([b * rows * cols + r * cols + c]), cheap to hand out to code
+//                working on one matrix; the kernels loop over the matrices.
+// Operations between batches of different layouts convert the right hand side to the layout of the left one.
+//   tinyTools::matrix_batch<float> rotations{100000, 3, 3};
+//   auto const moved = rotations * points; // 100000 products 3x3 * 3xN.
+namespace tinyTools
+{
+    enum struct BatchLayout : std::uint8_t
+    {
+        INTERLEAVED,
+        STRIDED
+    };
+
+    namespace detail
+    {
+        // Matrices per block of the interleaved product, the operands of one block stay within about 32 KiB (L1), a
+        // multiple of one AVX-512 register.
+        template <typename T>
+        [[nodiscard]] inline constexpr auto batchLanes(std::size_t elements) noexcept -> std::size_t
+        {
+            constexpr std::size_t registerLanes{64 / sizeof(T)};
+            auto const lanes = (32768 / sizeof(T)) / std::max<std::size_t>(elements, 1);
+            return std::max(registerLanes, lanes / registerLanes * registerLanes);
+        }
+    } // namespace detail
+
+    template <numerical T, typename Allocator = std::allocator<T>>
+        requires(!std::is_same_v<T, bool>)
+    struct matrix_batch
+    {
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        using value = T;
+        using reference = value &;
+        using const_reference = value const &;
+        using size_type = std::size_t;
+        using container_type = std::vector<T, Allocator>;
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Ctors.
+        inline explicit matrix_batch(size_type const count, size_type const rows, size_type const cols, BatchLayout const layout = BatchLayout::INTERLEAVED,
+                                     T const &initialValue = T{})
+            : count_{count}, rows_{rows}, cols_{cols}, layout_{layout}
+        {
+            checkShape();
+            detail::operation_scope const scope{Operation::CONSTRUCT};
+            data_.assign(count_ * rows_ * cols_, initialValue);
+            detail::countAllocated(detail::storageBytes<T>(data_.size()));
+        }
+
+        // Gathers matrices of the same shape.
+        template <typename A, Layout L>
+        inline explicit matrix_batch(std::vector<matrix<T, A, L>> const &matrices, BatchLayout const layout = BatchLayout::INTERLEAVED)
+            : matrix_batch(matrices.size(), matrices.empty() ? 0 : matrices.front().rows(), matrices.empty() ? 0 : matrices.front().cols(), layout)
+        {
+            for (size_type b{}; b < count_; ++b)
+            {
+                set(b, matrices[b].view());
+            }
+        }
+
+        [[nodiscard]] inline static auto identity(size_type const count, size_type const size, BatchLayout const layout = BatchLayout::INTERLEAVED) -> matrix_batch
+        {
+            matrix_batch ret{count, size, size, layout};
+            for (size_type i{}; i < size; ++i)
+            {
+                if (layout == BatchLayout::INTERLEAVED)
+                {
+                    std::fill_n(ret.data_.begin() + static_cast<std::ptrdiff_t>(ret.index(0, i, i)), count, T{1});
+                    continue;
+                }
+                for (size_type b{}; b < count; ++b)
+                {
+                    ret.data_[ret.index(b, i, i)] = T{1};
+                }
+            }
+            return ret;
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Getters.
+        [[nodiscard]] inline auto count() const noexcept -> size_type { return count_; }
+        [[nodiscard]] inline auto rows() const noexcept -> size_type { return rows_; }
+        [[nodiscard]] inline auto cols() const noexcept -> size_type { return cols_; }
+        [[nodiscard]] inline auto layout() const noexcept -> BatchLayout { return layout_; }
+        // Elements of one matrix / of the whole batch.
+        [[nodiscard]] inline auto matrixSize() const noexcept -> size_type { return rows_ * cols_; }
+        [[nodiscard]] inline auto totalSize() const noexcept -> size_type { return data_.size(); }
+        [[nodiscard]] inline auto data() const noexcept -> container_type const & { return data_; }
+        [[nodiscard]] inline auto ptr() const noexcept -> T const * { return data_.data(); }
+        [[nodiscard]] inline auto ptr() noexcept -> T * { return data_.data(); }
+
+        // Same count and shape, the layouts may differ.
+        [[nodiscard]] inline auto sameShape(matrix_batch const &rhs) const noexcept -> bool
+        {
+            return count_ == rhs.count_ && rows_ == rhs.rows_ && cols_ == rhs.cols_;
+        }
+
+        // Distance between two elements of one matrix and between the same element of two neighbour matrices.
+        [[nodiscard]] inline auto elementStride() const noexcept -> size_type { return layout_ == BatchLayout::INTERLEAVED ? count_ : 1; }
+        [[nodiscard]] inline auto matrixStride() const noexcept -> size_type { return layout_ == BatchLayout::INTERLEAVED ? 1 : matrixSize(); }
+
+        // Matrix b in place, strided for the interleaved layout.
+        [[nodiscard]] inline auto view(size_type const b) const -> matrix_view<T const>
+        {
+            detail::checkIndex<detail::checkPublicAccess>(b, count_);
+            return matrix_view<T const>{data_.data() + b * matrixStride(), rows_, cols_, cols_ * elementStride(), elementStride()};
+        }
+        [[nodiscard]] inline auto view(size_type const b) -> matrix_view<T>
+        {
+            detail::checkIndex<detail::checkPublicAccess>(b, count_);
+            return matrix_view<T>{data_.data() + b * matrixStride(), rows_, cols_, cols_ * elementStride(), elementStride()};
+        }
+
+        // Copy of matrix b.
+        template <typename A = std::allocator<T>>
+        [[nodiscard]] inline auto get(size_type const b) const -> matrix<T, A>
+        {
+            return matrix<T, A>{view(b)};
+        }
+
+        template <typename U>
+            requires std::is_same_v<std::remove_const_t<U>, T>
+        inline auto set(size_type const b, matrix_view<U> const &rhv) -> void
+        {
+            if (rhv.rows() != rows_ || rhv.cols() != cols_)
+            {
+                throw std::invalid_argument("Matrix is not the same size as the batch!\n");
+            }
+            auto dst = view(b);
+            for (size_type r{}; r < rows_; ++r)
+            {
+                for (size_type c{}; c < cols_; ++c)
+                {
+                    dst.unchecked(r, c) = rhv.unchecked(r, c);
+                }
+            }
+        }
+        template <typename A, Layout L>
+        inline auto set(size_type const b, matrix<T, A, L> const &rhm) -> void
+        {
+            set(b, rhm.view());
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Operators.
+        [[nodiscard]] inline auto operator()(size_type b, size_type r, size_type c) const -> const_reference
+        {
+            checkIndex(b, r, c);
+            return data_[index(b, r, c)];
+        }
+        [[nodiscard]] inline auto operator()(size_type b, size_type r, size_type c) -> reference
+        {
+            checkIndex(b, r, c);
+            return data_[index(b, r, c)];
+        }
+
+        [[nodiscard]] inline auto operator==(matrix_batch const &rhs) const -> bool
+        {
+            if (!sameShape(rhs))
+            {
+                return false;
+            }
+            if (layout_ != rhs.layout_)
+            {
+                return *this == rhs.convert(layout_);
+            }
+            return data_ == rhs.data_;
+        }
+        [[nodiscard]] inline auto operator!=(matrix_batch const &rhs) const -> bool { return !(operator==(rhs)); }
+
+        inline auto operator+=(matrix_batch const &rhs) -> matrix_batch &
+        {
+            apply(rhs, detail::simd::add{});
+            return *this;
+        }
+        inline auto operator-=(matrix_batch const &rhs) -> matrix_batch &
+        {
+            apply(rhs, detail::simd::sub{});
+            return *this;
+        }
+        inline auto operator+=(T const &scalar) -> matrix_batch &
+        {
+            apply(scalar, detail::simd::add{});
+            return *this;
+        }
+        inline auto operator-=(T const &scalar) -> matrix_batch &
+        {
+            apply(scalar, detail::simd::sub{});
+            return *this;
+        }
+        inline auto operator*=(T const &scalar) -> matrix_batch &
+        {
+            apply(scalar, detail::simd::mul{});
+            return *this;
+        }
+
+        [[nodiscard]] friend inline auto operator+(matrix_batch lhs, matrix_batch const &rhs) -> matrix_batch { return lhs += rhs; }
+        [[nodiscard]] friend inline auto operator-(matrix_batch lhs, matrix_batch const &rhs) -> matrix_batch { return lhs -= rhs; }
+        [[nodiscard]] friend inline auto operator+(matrix_batch lhs, T const &scalar) -> matrix_batch { return lhs += scalar; }
+        [[nodiscard]] friend inline auto operator-(matrix_batch lhs, T const &scalar) -> matrix_batch { return lhs -= scalar; }
+        [[nodiscard]] friend inline auto operator*(matrix_batch lhs, T const &scalar) -> matrix_batch { return lhs *= scalar; }
+        [[nodiscard]] friend inline auto operator*(T const &scalar, matrix_batch rhs) -> matrix_batch { return rhs *= scalar; }
+
+        // Product of every pair: ret[b] = lhs[b] * rhs[b].
+        [[nodiscard]] friend inline auto operator*(matrix_batch const &lhs, matrix_batch const &rhs) -> matrix_batch
+        {
+            if (lhs.count_ != rhs.count_)
+            {
+                throw std::invalid_argument("Batches must have the same count!\n");
+            }
+            if (lhs.cols_ != rhs.rows_)
+            {
+                throw std::invalid_argument("Matrixes left-matrix cols must be same size as right-matrix rows.\n");
+            }
+            if (lhs.layout_ != rhs.layout_)
+            {
+                return lhs * rhs.convert(lhs.layout_);
+            }
+
+            detail::operation_scope const scope{Operation::MULTIPLY};
+            auto const m = lhs.rows_;
+            auto const n = rhs.cols_;
+            auto const k = lhs.cols_;
+            matrix_batch ret{lhs.count_, m, n, lhs.layout_};
+            if (lhs.layout_ == BatchLayout::INTERLEAVED)
+            {
+                auto const lanes = detail::batchLanes<T>(m * k + k * n + m * n);
+                detail::for_each_chunk(ret.count_, m * n * k, [&](size_type begin, size_type end)
+                                       {
+                                           for (auto first{begin}; first < end; first += lanes)
+                                           {
+                                               detail::simd::batch_gemm(ret.ptr() + first, lhs.ptr() + first, rhs.ptr() + first, m, n, k, ret.count_,
+                                                                        std::min(lanes, end - first));
+                                           }
+                                       });
+                return ret;
+            }
+            detail::for_each_chunk(ret.count_, m * n * k, [&](size_type begin, size_type end)
+                                   {
+                                       for (auto b{begin}; b < end; ++b)
+                                       {
+                                           auto const *const a = lhs.ptr() + b * m * k;
+                                           auto const *const bb = rhs.ptr() + b * k * n;
+                                           auto *const c = ret.ptr() + b * m * n;
+                                           for (size_type i{}; i < m; ++i)
+                                           {
+                                               for (size_type p{}; p < k; ++p)
+                                               {
+                                                   auto const scale = a[i * k + p];
+                                                   for (size_type j{}; j < n; ++j)
+                                                   {
+                                                       c[i * n + j] = static_cast<T>(c[i * n + j] + scale * bb[p * n + j]);
+                                                   }
+                                               }
+                                           }
+                                       }
+                                   });
+            return ret;
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Methods.
+        // Multiply point by point. (Matlab: .*)
+        inline auto multiply(matrix_batch const &rhs) -> void { apply(rhs, detail::simd::mul{}); }
+
+        // Same batch in the other layout.
+        [[nodiscard]] inline auto convert(BatchLayout const layout) const -> matrix_batch
+        {
+            if (layout == layout_)
+            {
+                return *this;
+            }
+            matrix_batch ret{count_, rows_, cols_, layout};
+            // Walks the interleaved side contiguously, one element of every matrix at a time.
+            auto const interleavedSrc = layout_ == BatchLayout::INTERLEAVED;
+            detail::for_each_chunk(matrixSize(), count_, [&](size_type begin, size_type end)
+                                   {
+                                       for (auto e{begin}; e < end; ++e)
+                                       {
+                                           for (size_type b{}; b < count_; ++b)
+                                           {
+                                               auto const interleaved = e * count_ + b;
+                                               auto const strided = b * matrixSize() + e;
+                                               ret.data_[interleavedSrc ? strided : interleaved] = data_[interleavedSrc ? interleaved : strided];
+                                           }
+                                       }
+                                   });
+            return ret;
+        }
+
+        // Transpose of every matrix.
+        [[nodiscard]] inline auto transpose() const -> matrix_batch
+        {
+            matrix_batch ret{count_, cols_, rows_, layout_};
+            if (layout_ == BatchLayout::INTERLEAVED)
+            {
+                // Whole lanes move: element (r, c) of every matrix is one contiguous run.
+                detail::for_each_chunk(count_, matrixSize(), [this, &ret](size_type begin, size_type end)
+                                       {
+                                           for (size_type r{}; r < rows_; ++r)
+                                           {
+                                               for (size_type c{}; c < cols_; ++c)
+                                               {
+                                                   std::copy(data_.begin() + static_cast<std::ptrdiff_t>(index(begin, r, c)),
+                                                             data_.begin() + static_cast<std::ptrdiff_t>(index(end - 1, r, c) + 1),
+                                                             ret.data_.begin() + static_cast<std::ptrdiff_t>(ret.index(begin, c, r)));
+                                               }
+                                           }
+                                       });
+                return ret;
+            }
+            detail::for_each_chunk(count_, matrixSize(), [this, &ret](size_type begin, size_type end)
+                                   {
+                                       for (auto b{begin}; b < end; ++b)
+                                       {
+                                           for (size_type r{}; r < rows_; ++r)
+                                           {
+                                               for (size_type c{}; c < cols_; ++c)
+                                               {
+                                                   ret.data_[ret.index(b, c, r)] = data_[index(b, r, c)];
+                                               }
+                                           }
+                                       }
+                                   });
+            return ret;
+        }
+
+        // Sums of every matrix. Direction::COLUMNS -> batch of 1 x cols(), Direction::ROWS -> batch of rows() x 1.
+        [[nodiscard]] inline auto sum(Direction const dir) const -> matrix_batch
+        {
+            if (dir == Direction::NONE)
+            {
+                throw std::invalid_argument("Direction must be Columns (1) or Rows (2).\n");
+            }
+            auto const columns = dir == Direction::COLUMNS;
+            matrix_batch ret{count_, columns ? 1 : rows_, columns ? cols_ : 1, layout_};
+            reduceInto(ret.ptr(), [columns](size_type r, size_type c) { return columns ? c : r; });
+            return ret;
+        }
+
+        // Sum of all elements of every matrix, one value per matrix.
+        [[nodiscard]] inline auto sum() const -> std::vector<T>
+        {
+            // A 1 x 1 batch is the same buffer in both layouts.
+            std::vector<T> ret(count_, T{});
+            reduceInto(ret.data(), [](size_type, size_type) { return size_type{}; });
+            return ret;
+        }
+
+    private:
+        size_type count_;
+        size_type rows_;
+        size_type cols_;
+        BatchLayout layout_;
+        container_type data_{};
+
+        [[nodiscard]] inline auto index(size_type b, size_type r, size_type c) const noexcept -> size_type
+        {
+            return (r * cols_ + c) * elementStride() + b * matrixStride();
+        }
+
+        inline auto checkIndex(size_type b, size_type r, size_type c) const -> void
+        {
+            detail::checkIndex<detail::checkPublicAccess>(b, count_);
+            detail::checkIndex<detail::checkPublicAccess>(r, c, rows_, cols_);
+        }
+
+        inline auto checkShape() const -> void
+        {
+            if (count_ == 0)
+            {
+                throw std::length_error("Count can not be 0!\n");
+            }
+            if (rows_ == 0)
+            {
+                throw std::length_error("Rows can not be 0!\n");
+            }
+            if (cols_ == 0)
+            {
+                throw std::length_error("Cols can not be 0!\n");
+            }
+        }
+
+        // out (zeroed, same layout, outSize elements per matrix) += element (r, c) at target(r, c), for every matrix.
+        template <typename target_t>
+        inline auto reduceInto(T *out, target_t target) const -> void
+        {
+            detail::operation_scope const scope{Operation::REDUCE};
+            if (layout_ == BatchLayout::INTERLEAVED)
+            {
+                // Lane runs of the chunk: out[target][begin, end) += in[(r, c)][begin, end).
+                detail::for_each_chunk(count_, matrixSize(), [this, out, target](size_type begin, size_type end)
+                                       {
+                                           for (size_type r{}; r < rows_; ++r)
+                                           {
+                                               for (size_type c{}; c < cols_; ++c)
+                                               {
+                                                   auto *const dst = out + target(r, c) * count_ + begin;
+                                                   detail::simd::binary(dst, dst, data_.data() + index(begin, r, c), end - begin, detail::simd::add{});
+                                               }
+                                           }
+                                       });
+                return;
+            }
+            auto const outSize = std::max(target(rows_ - 1, 0), target(0, cols_ - 1)) + 1;
+            detail::for_each_chunk(count_, matrixSize(), [this, out, target, outSize](size_type begin, size_type end)
+                                   {
+                                       for (auto b{begin}; b < end; ++b)
+                                       {
+                                           auto const *const src = data_.data() + b * matrixSize();
+                                           for (size_type r{}; r < rows_; ++r)
+                                           {
+                                               for (size_type c{}; c < cols_; ++c)
+                                               {
+                                                   auto &dst = out[b * outSize + target(r, c)];
+                                                   dst = static_cast<T>(dst + src[r * cols_ + c]);
+                                               }
+                                           }
+                                       }
+                                   });
+        }
+
+        // Element-wise data_[i] = op(data_[i], rhs[i]) over the whole buffer, SIMD kernel per chunk.
+        template <typename op_t>
+        inline auto apply(matrix_batch const &rhs, op_t op) -> void
+        {
+            if (!sameShape(rhs))
+            {
+                throw std::invalid_argument("Batches are not the same size!\n");
+            }
+            if (layout_ != rhs.layout_)
+            {
+                apply(rhs.convert(layout_), op);
+                return;
+            }
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            detail::for_each_chunk(totalSize(), [this, &rhs, op](size_type begin, size_type end)
+                                   { detail::simd::binary(data_.data() + begin, data_.data() + begin, rhs.data_.data() + begin, end - begin, op); });
+        }
+
+        template <typename op_t>
+        inline auto apply(T const &scalar, op_t op) noexcept -> void
+        {
+            detail::operation_scope const scope{Operation::ELEMENTWISE};
+            detail::for_each_chunk(totalSize(), [this, &scalar, op](size_type begin, size_type end)
+                                   { detail::simd::binary_scalar(data_.data() + begin, data_.data() + begin, scalar, end - begin, op); });
+        }
+    };
+} // namespace tinyTools
+
+#endif /* MATRIX_BATCH_HPP */
@@ -0,0 +1,337 @@
+#ifndef MATRIX_EXPRESSION_HPP
+#define MATRIX_EXPRESSION_HPP
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "detail/simd.hpp"
+#include "matrix_fwd.hpp"
+#include "matrix_view.hpp"
+#include "parallel.hpp"
+
+// Expression templates: element-wise +, -, scalar ops and multiply (Matlab: .*) build a lazy tree that is
+// evaluated once, in a single fused loop, when it is assigned to a matrix.
+//   tinyTools::matrix<float> D = A + B - C * 2.F; // One pass over A, B and C, one allocation for D.
+// Lvalue matrixes are captured as views (no copy), rvalue matrixes are moved into the expression so it never dangles.
+namespace tinyTools
+{
+    namespace detail
+    {
+        struct expression_tag
+        {
+        };
+
+        template <typename T>
+        struct is_matrix : std::false_type
+        {
+        };
+        template <typename T, typename Allocator, Layout L>
+        struct is_matrix<matrix<T, Allocator, L>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_view : std::false_type
+        {
+        };
+        template <typename T>
+        struct is_view<matrix_view<T>> : std::true_type
+        {
+        };
+
+        template <typename E>
+        inline constexpr bool is_expression_v = std::is_base_of_v<expression_tag, std::remove_cvref_t<E>>;
+
+        // Reader of one output line (a row, or a column for COL_MAJOR results) over strided storage, contiguous readers drop
+        // the stride so the fused loop vectorizes.
+        template <typename T, bool contiguous>
+        struct strided_reader
+        {
+            T const *ptr{};
+            std::size_t stride{};
+
+            [[nodiscard]] inline constexpr auto operator[](std::size_t c) const noexcept -> T
+            {
+                if constexpr (contiguous)
+                {
+                    return ptr[c];
+                }
+                else
+                {
+                    return ptr[c * stride];
+                }
+            }
+        };
+
+        template <typename lhs_t, typename rhs_t, typename op_t>
+        struct binary_reader
+        {
+            lhs_t lhs{};
+            rhs_t rhs{};
+            op_t op{};
+
+            [[nodiscard]] inline constexpr auto operator[](std::size_t c) const noexcept { return op(lhs[c], rhs[c]); }
+        };
+
+        template <typename T, typename reader_t, typename op_t, bool scalarFirst>
+        struct scalar_reader
+        {
+            reader_t reader{};
+            T scalar{};
+            op_t op{};
+
+            [[nodiscard]] inline constexpr auto operator[](std::size_t c) const noexcept -> T
+            {
+                if constexpr (scalarFirst)
+                {
+                    return op(scalar, reader[c]);
+                }
+                else
+                {
+                    return op(reader[c], scalar);
+                }
+            }
+        };
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Leafs.
+        template <typename T>
+        struct view_leaf
+        {
+            using value = T;
+            matrix_view<T const> view{};
+
+            [[nodiscard]] inline constexpr auto rows() const noexcept -> std::size_t { return view.rows(); }
+            [[nodiscard]] inline constexpr auto cols() const noexcept -> std::size_t { return view.cols(); }
+
+            template <bool colMajor>
+            [[nodiscard]] inline constexpr auto contiguous() const noexcept -> bool { return (colMajor ? view.rowStride() : view.colStride()) == 1; }
+
+            template <bool colMajor, bool contiguous>
+            [[nodiscard]] inline constexpr auto line(std::size_t i) const noexcept -> strided_reader<T, contiguous>
+            {
+                if constexpr (colMajor)
+                {
+                    return {&view.unchecked(0, i), view.rowStride()};
+                }
+                else
+                {
+                    return {&view.unchecked(i, 0), view.colStride()};
+                }
+            }
+        };
+
+        template <typename matrix_t>
+        struct owned_leaf
+        {
+            using value = typename matrix_t::value;
+            matrix_t mat;
+
+            [[nodiscard]] inline constexpr auto rows() const noexcept -> std::size_t { return mat.rows(); }
+            [[nodiscard]] inline constexpr auto cols() const noexcept -> std::size_t { return mat.cols(); }
+
+            template <bool colMajor>
+            [[nodiscard]] inline auto contiguous() const noexcept -> bool { return view_leaf<value>{mat.view()}.template contiguous<colMajor>(); }
+
+            template <bool colMajor, bool contiguous>
+            [[nodiscard]] inline auto line(std::size_t i) const noexcept -> strided_reader<value, contiguous> { return view_leaf<value>{mat.view()}.template line<colMajor, contiguous>(i); }
+        };
+
+        // matrix lvalue -> view_leaf, matrix rvalue -> owned_leaf, view -> view_leaf, expression -> itself.
+        template <typename E>
+        [[nodiscard]] inline auto make_operand(E &&e)
+        {
+            using D = std::remove_cvref_t<E>;
+            if constexpr (is_matrix<D>::value && std::is_lvalue_reference_v<E>)
+            {
+                return view_leaf<typename D::value>{e.view()};
+            }
+            else if constexpr (is_matrix<D>::value)
+            {
+                return owned_leaf<D>{std::move(e)};
+            }
+            else if constexpr (is_view<D>::value)
+            {
+                return view_leaf<typename D::value>{e};
+            }
+            else
+            {
+                return D{std::forward<E>(e)};
+            }
+        }
+
+        template <typename E>
+        using operand_t = decltype(make_operand(std::declval<E>()));
+
+        template <typename E>
+        using value_t = typename std::remove_cvref_t<E>::value;
+    } // namespace detail
+
+    // Anything that can take part of an expression: matrix, matrix_view or another expression.
+    template <typename E>
+    concept matrix_operand = (detail::is_matrix<std::remove_cvref_t<E>>::value || detail::is_view<std::remove_cvref_t<E>>::value || detail::is_expression_v<E>) &&
+                             !std::is_same_v<detail::value_t<E>, bool>;
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Nodes.
+    template <typename lhs_t, typename rhs_t, typename op_t>
+    struct binary_expression : detail::expression_tag
+    {
+        using value = typename lhs_t::value;
+        static_assert(std::is_same_v<value, typename rhs_t::value>, "Matrixes must have the same value type.");
+
+        inline binary_expression(lhs_t lhs, rhs_t rhs)
+            : lhs_{std::move(lhs)}, rhs_{std::move(rhs)}
+        {
+            if (lhs_.rows() != rhs_.rows() || lhs_.cols() != rhs_.cols())
+            {
+                throw std::invalid_argument("Matrixes must have same size!");
+            }
+        }
+
+        [[nodiscard]] inline constexpr auto rows() const noexcept -> std::size_t { return lhs_.rows(); }
+        [[nodiscard]] inline constexpr auto cols() const noexcept -> std::size_t { return lhs_.cols(); }
+
+        template <bool colMajor>
+        [[nodiscard]] inline constexpr auto contiguous() const noexcept -> bool { return lhs_.template contiguous<colMajor>() && rhs_.template contiguous<colMajor>(); }
+
+        template <bool colMajor, bool contiguous>
+        [[nodiscard]] inline auto line(std::size_t i) const noexcept
+        {
+            using lhs_reader = decltype(lhs_.template line<colMajor, contiguous>(i));
+            using rhs_reader = decltype(rhs_.template line<colMajor, contiguous>(i));
+            return detail::binary_reader<lhs_reader, rhs_reader, op_t>{lhs_.template line<colMajor, contiguous>(i), rhs_.template line<colMajor, contiguous>(i), op_t{}};
+        }
+
+    private:
+        lhs_t lhs_;
+        rhs_t rhs_;
+    };
+
+    template <typename expr_t, typename op_t, bool scalarFirst>
+    struct scalar_expression : detail::expression_tag
+    {
+        using value = typename expr_t::value;
+
+        inline scalar_expression(expr_t expr, value scalar)
+            : expr_{std::move(expr)}, scalar_{scalar}
+        {
+        }
+
+        [[nodiscard]] inline constexpr auto rows() const noexcept -> std::size_t { return expr_.rows(); }
+        [[nodiscard]] inline constexpr auto cols() const noexcept -> std::size_t { return expr_.cols(); }
+
+        template <bool colMajor>
+        [[nodiscard]] inline constexpr auto contiguous() const noexcept -> bool { return expr_.template contiguous<colMajor>(); }
+
+        template <bool colMajor, bool contiguous>
+        [[nodiscard]] inline auto line(std::size_t i) const noexcept
+        {
+            using reader = decltype(expr_.template line<colMajor, contiguous>(i));
+            return detail::scalar_reader<value, reader, op_t, scalarFirst>{expr_.template line<colMajor, contiguous>(i), scalar_, op_t{}};
+        }
+
+    private:
+        expr_t expr_;
+        value scalar_;
+    };
+
+    namespace detail
+    {
+        template <typename L, typename R, typename op_t>
+        [[nodiscard]] inline auto make_binary(L &&lhs, R &&rhs)
+        {
+            return binary_expression<operand_t<L>, operand_t<R>, op_t>{make_operand(std::forward<L>(lhs)), make_operand(std::forward<R>(rhs))};
+        }
+
+        template <bool scalarFirst, typename op_t, typename E>
+        [[nodiscard]] inline auto make_scalar(E &&expr, value_t<E> scalar)
+        {
+            return scalar_expression<operand_t<E>, op_t, scalarFirst>{make_operand(std::forward<E>(expr)), scalar};
+        }
+
+        // Evaluates expr into out (rows() x cols(), contiguous in the colMajor order): parallel chunks of storage lines,
+        // SIMD per line.
+        template <bool colMajor, typename E>
+        inline auto evaluate(E const &expr, typename E::value *out) -> void
+        {
+            auto const lines = colMajor ? expr.cols() : expr.rows();
+            auto const length = colMajor ? expr.rows() : expr.cols();
+            auto const contiguous = expr.template contiguous<colMajor>();
+            for_each_chunk(lines, length, [&expr, out, length, contiguous](std::size_t begin, std::size_t end)
+                           {
+                               for (auto i{begin}; i < end; ++i)
+                               {
+                                   if (contiguous)
+                                   {
+                                       simd::generate(out + i * length, length, expr.template line<colMajor, true>(i));
+                                   }
+                                   else
+                                   {
+                                       simd::generate(out + i * length, length, expr.template line<colMajor, false>(i));
+                                   }
+                               }
+                           });
+        }
+    } // namespace detail
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Operators. At least one side is an expression or a matrix/view pair, matrix op matrix is handled the same way.
+    template <matrix_operand L, matrix_operand R>
+    [[nodiscard]] inline auto operator+(L &&lhs, R &&rhs) { return detail::make_binary<L, R, detail::simd::add>(std::forward<L>(lhs), std::forward<R>(rhs)); }
+
+    template <matrix_operand L, matrix_operand R>
+    [[nodiscard]] inline auto operator-(L &&lhs, R &&rhs) { return detail::make_binary<L, R, detail::simd::sub>(std::forward<L>(lhs), std::forward<R>(rhs)); }
+
+    // Multiply point by point. (Matlab: .*)
+    template <matrix_operand L, matrix_operand R>
+    [[nodiscard]] inline auto multiply(L &&lhs, R &&rhs) { return detail::make_binary<L, R, detail::simd::mul>(std::forward<L>(lhs), std::forward<R>(rhs)); }
+
+    template <matrix_operand E>
+    [[nodiscard]] inline auto operator+(E &&expr, detail::value_t<E> scalar) { return detail::make_scalar<false, detail::simd::add>(std::forward<E>(expr), scalar); }
+    template <matrix_operand E>
+    [[nodiscard]] inline auto operator+(detail::value_t<E> scalar, E &&expr) { return detail::make_scalar<true, detail::simd::add>(std::forward<E>(expr), scalar); }
+
+    template <matrix_operand E>
+    [[nodiscard]] inline auto operator-(E &&expr, detail::value_t<E> scalar) { return detail::make_scalar<false, detail::simd::sub>(std::forward<E>(expr), scalar); }
+    template <matrix_operand E>
+    [[nodiscard]] inline auto operator-(detail::value_t<E> scalar, E &&expr) { return detail::make_scalar<true, detail::simd::sub>(std::forward<E>(expr), scalar); }
+
+    template <matrix_operand E>
+    [[nodiscard]] inline auto operator*(E &&expr, detail::value_t<E> scalar) { return detail::make_scalar<false, detail::simd::mul>(std::forward<E>(expr), scalar); }
+    template <matrix_operand E>
+    [[nodiscard]] inline auto operator*(detail::value_t<E> scalar, E &&expr) { return detail::make_scalar<true, detail::simd::mul>(std::forward<E>(expr), scalar); }
+
+    // Matrix product with an expression operand: the expression is evaluated once, then the GEMM runs. The temporary takes
+    // the allocator and layout of a matrix operand, so both sides of the product have the same type.
+    template <matrix_operand L, matrix_operand R>
+        requires(detail::is_expression_v<L> || detail::is_expression_v<R>)
+    [[nodiscard]] inline auto operator*(L &&lhs, R &&rhs)
+    {
+        using temporary_t = std::conditional_t<detail::is_matrix<std::remove_cvref_t<L>>::value, std::remove_cvref_t<L>,
+                                               std::conditional_t<detail::is_matrix<std::remove_cvref_t<R>>::value, std::remove_cvref_t<R>, matrix<detail::value_t<L>>>>;
+        auto materialize = []<typename E>(E &&e) -> decltype(auto)
+        {
+            if constexpr (detail::is_expression_v<E>)
+            {
+                return temporary_t{e};
+            }
+            else
+            {
+                return std::forward<E>(e);
+            }
+        };
+        return materialize(std::forward<L>(lhs)) * materialize(std::forward<R>(rhs));
+    }
+
+    // Forces the evaluation of an expression.
+    template <typename E>
+        requires detail::is_expression_v<E>
+    [[nodiscard]] inline auto eval(E const &expr) -> matrix<typename E::value>
+    {
+        return matrix<typename E::value>{expr};
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_EXPRESSION_HPP */
@@ -0,0 +1,35 @@
+#ifndef MATRIX_FWD_HPP
+#define MATRIX_FWD_HPP
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace tinyTools
+{
+    template <typename T>
+    concept numerical = std::is_integral_v<T> || std::is_floating_point_v<T>;
+
+    enum struct Direction : std::uint8_t
+    {
+        NONE,
+        COLUMNS,
+        ROWS
+    };
+
+    // Storage order of matrix: ROW_MAJOR keeps the rows contiguous (C), COL_MAJOR the columns (Matlab, Fortran, BLAS).
+    enum struct Layout : std::uint8_t
+    {
+        ROW_MAJOR,
+        COL_MAJOR
+    };
+
+    template <numerical T, typename Allocator = std::allocator<T>, Layout L = Layout::ROW_MAJOR>
+    struct matrix;
+
+    template <typename T>
+        requires numerical<std::remove_const_t<T>>
+    struct matrix_view;
+} // namespace tinyTools
+
+#endif /* MATRIX_FWD_HPP */
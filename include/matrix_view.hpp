@@ -0,0 +1,398 @@
+#ifndef MATRIX_VIEW_HPP
+#define MATRIX_VIEW_HPP
+
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "detail/bounds.hpp"
+#include "detail/gemm.hpp"
+#include "detail/reduce.hpp"
+#include "detail/strassen.hpp"
+#include "detail/text.hpp"
+#include "instrument.hpp"
+#include "matrix_fwd.hpp"
+#include "parallel.hpp"
+
+namespace tinyTools
+{
+    // Non-owning, strided window over matrix storage (like std::span, constness is shallow).
+    // Element (r, c) lives at ptr()[r * rowStride() + c * colStride()].
+    // Slicing (submatrix, getRow, getCol) is O(1) and does not allocate, the owner must outlive the view.
+    template <typename T>
+        requires numerical<std::remove_const_t<T>>
+    struct matrix_view
+    {
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        using value = std::remove_const_t<T>;
+        using element_type = T;
+        using reference = T &;
+        using size_type = std::size_t;
+        using container_type = std::vector<value>;
+        using Direction = tinyTools::Direction;
+
+        // Row-major walk over the viewed elements, following the strides.
+        struct iterator
+        {
+            using value_type = std::remove_const_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using reference = T &;
+            using iterator_category = std::forward_iterator_tag;
+
+            T *data{};
+            size_type row{};
+            size_type col{};
+            size_type cols{};
+            size_type rowStride{};
+            size_type colStride{};
+
+            [[nodiscard]] inline constexpr auto operator*() const noexcept -> reference { return data[row * rowStride + col * colStride]; }
+            inline constexpr auto operator++() noexcept -> iterator &
+            {
+                if (++col == cols)
+                {
+                    col = 0;
+                    ++row;
+                }
+                return *this;
+            }
+            inline constexpr auto operator++(int) noexcept -> iterator
+            {
+                auto ret{*this};
+                ++*this;
+                return ret;
+            }
+            [[nodiscard]] inline constexpr auto operator==(iterator const &rhi) const noexcept -> bool { return row == rhi.row && col == rhi.col; }
+        };
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Ctors.
+        inline constexpr matrix_view() noexcept = default;
+
+        inline constexpr matrix_view(T *data, size_type const rows, size_type const cols) noexcept
+            : matrix_view(data, rows, cols, cols, 1)
+        {
+        }
+
+        inline constexpr matrix_view(T *data, size_type const rows, size_type const cols, size_type const rowStride, size_type const colStride) noexcept
+            : data_{data}, rows_{rows}, cols_{cols}, rowStride_{rowStride}, colStride_{colStride}
+        {
+        }
+
+        // Whole storage of the given order, e.g. a Matlab (column-major) buffer wrapped in place.
+        inline constexpr matrix_view(T *data, size_type const rows, size_type const cols, Layout const layout) noexcept
+            : matrix_view(data, rows, cols, layout == Layout::COL_MAJOR ? 1 : cols, layout == Layout::COL_MAJOR ? rows : 1)
+        {
+        }
+
+        // matrix_view<T> -> matrix_view<T const>.
+        template <typename U>
+            requires(std::is_const_v<T> && std::is_same_v<U const, T> && !std::is_same_v<U, T>)
+        inline constexpr matrix_view(matrix_view<U> const &rhv) noexcept
+            : matrix_view(rhv.ptr(), rhv.rows(), rhv.cols(), rhv.rowStride(), rhv.colStride())
+        {
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Getters.
+        [[nodiscard]] inline constexpr auto ptr() const noexcept -> T * { return data_; }
+        [[nodiscard]] inline constexpr auto rows() const noexcept -> size_type { return rows_; }
+        [[nodiscard]] inline constexpr auto cols() const noexcept -> size_type { return cols_; }
+        [[nodiscard]] inline constexpr auto totalSize() const noexcept -> size_type { return rows_ * cols_; }
+        [[nodiscard]] inline constexpr auto rowStride() const noexcept -> size_type { return rowStride_; }
+        [[nodiscard]] inline constexpr auto colStride() const noexcept -> size_type { return colStride_; }
+        [[nodiscard]] inline constexpr auto isContiguous() const noexcept -> bool { return colStride_ == 1 && (rowStride_ == cols_ || rows_ == 1); }
+
+        // Leading dimension (BLAS lda): distance between rows, element (r, c) is ptr()[r * ld() + c] when colStride() == 1.
+        [[nodiscard]] inline constexpr auto ld() const noexcept -> size_type { return rowStride_; }
+
+        [[nodiscard]] inline constexpr auto begin() const noexcept -> iterator { return iterator{data_, 0, 0, cols_, rowStride_, colStride_}; }
+        [[nodiscard]] inline constexpr auto end() const noexcept -> iterator { return iterator{data_, rows_, 0, cols_, rowStride_, colStride_}; }
+
+        // Storage of a contiguous view (whole matrix, full-width rows), no copy.
+        [[nodiscard]] inline constexpr auto span() const -> std::span<T>
+        {
+            if (!isContiguous())
+            {
+                throw std::invalid_argument("View is not contiguous!\n");
+            }
+            return std::span<T>{data_, totalSize()};
+        }
+
+        // Row r in place, the view columns must be contiguous.
+        [[nodiscard]] inline constexpr auto rowSpan(size_type r) const -> std::span<T>
+        {
+            if (colStride_ != 1)
+            {
+                throw std::invalid_argument("View rows are not contiguous!\n");
+            }
+            detail::checkIndex<detail::checkPublicAccess>(r, 0, rows_, cols_);
+            return std::span<T>{data_ + r * rowStride_, cols_};
+        }
+
+        // Materialized copy in row-major order.
+        [[nodiscard]] inline auto data() const -> container_type
+        {
+            container_type ret{};
+            ret.reserve(totalSize());
+            for (size_type r{}; r < rows_; ++r)
+            {
+                for (size_type c{}; c < cols_; ++c)
+                {
+                    ret.emplace_back(unchecked(r, c));
+                }
+            }
+            return ret;
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Operators.
+        [[nodiscard]] inline constexpr auto operator()(size_type r, size_type c) const -> reference
+        {
+            detail::checkIndex<detail::checkPublicAccess>(r, c, rows_, cols_);
+            return data_[r * rowStride_ + c * colStride_];
+        }
+
+        // Linear index in row-major order.
+        [[nodiscard]] inline constexpr auto operator[](size_type idx) const -> reference
+        {
+            detail::checkIndex<detail::checkPublicAccess>(idx, totalSize());
+            return data_[(idx / cols_) * rowStride_ + (idx % cols_) * colStride_];
+        }
+
+        [[nodiscard]] inline constexpr auto operator()(size_type row, size_type col, size_type height, size_type width) const -> matrix_view
+        {
+            detail::operation_scope const scope{Operation::SUBMATRIX};
+            if (row >= rows())
+            {
+                throw std::out_of_range(std::string{"Rows out of range, max rows= " + std::to_string(rows()) + '\n'});
+            }
+            if (col >= cols())
+            {
+                throw std::out_of_range(std::string{"Cols out of range, max cols= " + std::to_string(cols()) + '\n'});
+            }
+            if (row + height > rows())
+            {
+                throw std::out_of_range("[HEIGHT] Max size out of bounds!\n");
+            }
+            if (col + width > cols())
+            {
+                throw std::out_of_range(" [WIDHT] Max size out of bounds!\n");
+            }
+            return matrix_view{&unchecked(row, col), height, width, rowStride_, colStride_};
+        }
+
+        template <typename U>
+        [[nodiscard]] inline constexpr auto operator==(matrix_view<U> const &rhv) const noexcept -> bool
+        {
+            if (!sameSize(rhv))
+            {
+                return false;
+            }
+            for (size_type r{}; r < rows_; ++r)
+            {
+                for (size_type c{}; c < cols_; ++c)
+                {
+                    if (unchecked(r, c) != rhv.unchecked(r, c))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <typename U>
+        [[nodiscard]] inline auto operator*(matrix_view<U> const &rhv) const -> matrix<value>
+        {
+            static_assert(std::is_same_v<value, std::remove_const_t<U>>, "Matrixes must have the same value type.");
+            if (cols() != rhv.rows())
+            {
+                throw std::invalid_argument("Matrixes left-matrix cols must be same size as right-matrix rows.\n");
+            }
+            matrix<value> ret{rows(), rhv.cols(), 0};
+            detail::multiply<value>(rows(), rhv.cols(), cols(), {ptr(), rowStride(), colStride()}, {rhv.ptr(), rhv.rowStride(), rhv.colStride()}, {ret.ptr(), ret.ld(), 1});
+            return ret;
+        }
+        [[nodiscard]] inline auto operator*(matrix<value> const &rhm) const -> matrix<value> { return *this * rhm.view(); }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Methods.
+        template <typename U>
+        [[nodiscard]] inline constexpr auto sameSize(matrix_view<U> const &rhv) const noexcept -> bool { return rows() == rhv.rows() && cols() == rhv.cols(); }
+
+        [[nodiscard]] inline constexpr auto getRow(size_type const row) const -> matrix_view
+        {
+            if (row >= rows())
+            {
+                throw std::out_of_range(std::string{"Rows out of range, max rows= " + std::to_string(rows()) + '\n'});
+            }
+            return matrix_view{&unchecked(row, 0), 1, cols_, rowStride_, colStride_};
+        }
+
+        // Lazy transpose: same storage, swapped shape and strides. O(1), the GEMM reads it directly (A.t() * B).
+        [[nodiscard]] inline constexpr auto t() const noexcept -> matrix_view { return matrix_view{data_, cols_, rows_, colStride_, rowStride_}; }
+
+        [[nodiscard]] inline constexpr auto getCol(size_type const col) const -> matrix_view
+        {
+            if (col >= cols())
+            {
+                throw std::out_of_range(std::string{"Cols out of range, max cols= " + std::to_string(cols()) + '\n'});
+            }
+            return matrix_view{&unchecked(0, col), rows_, 1, rowStride_, colStride_};
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Reductions. COLUMNS gives a 1 x cols() row, ROWS a rows() x 1 column, without Direction every element is folded.
+        // Floating sums are compensated (Kahan down the columns, pairwise along the rows), integer sums wrap like T does.
+        template <typename Allocator = std::allocator<value>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto sum(Direction dir) const -> matrix<value, Allocator, L> { return reduce<value, value, Allocator, L>(dir, detail::reduce_sum{}); }
+        template <typename Allocator = std::allocator<value>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto prod(Direction dir) const -> matrix<value, Allocator, L> { return reduce<value, value, Allocator, L>(dir, detail::reduce_prod{}); }
+        template <typename Allocator = std::allocator<value>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto min(Direction dir) const -> matrix<value, Allocator, L> { return reduce<value, value, Allocator, L>(dir, detail::reduce_min{}); }
+        template <typename Allocator = std::allocator<value>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto max(Direction dir) const -> matrix<value, Allocator, L> { return reduce<value, value, Allocator, L>(dir, detail::reduce_max{}); }
+        template <typename Allocator = std::allocator<bool>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto any(Direction dir) const -> matrix<bool, Allocator, L> { return reduce<bool, value, Allocator, L>(dir, detail::reduce_any{}); }
+        template <typename Allocator = std::allocator<bool>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto all(Direction dir) const -> matrix<bool, Allocator, L> { return reduce<bool, value, Allocator, L>(dir, detail::reduce_all{}); }
+
+        template <typename Allocator = std::allocator<detail::mean_t<value>>, Layout L = Layout::ROW_MAJOR>
+        [[nodiscard]] inline auto mean(Direction dir) const -> matrix<detail::mean_t<value>, Allocator, L>
+        {
+            using mean_t = detail::mean_t<value>;
+            auto ret = reduce<mean_t, mean_t, Allocator, L>(dir, detail::reduce_sum{});
+            auto const count = static_cast<mean_t>(dir == Direction::COLUMNS ? rows() : cols());
+            detail::simd::binary_scalar(ret.ptr(), ret.ptr(), count, ret.totalSize(), detail::simd::div{});
+            return ret;
+        }
+
+        [[nodiscard]] inline auto sum() const -> value { return reduce<value>(detail::reduce_sum{}); }
+        [[nodiscard]] inline auto prod() const -> value { return reduce<value>(detail::reduce_prod{}); }
+        [[nodiscard]] inline auto min() const -> value { return reduce<value>(detail::reduce_min{}); }
+        [[nodiscard]] inline auto max() const -> value { return reduce<value>(detail::reduce_max{}); }
+        [[nodiscard]] inline auto any() const -> bool { return reduce<value>(detail::reduce_any{}) != value{}; }
+        [[nodiscard]] inline auto all() const -> bool { return reduce<value>(detail::reduce_all{}) != value{}; }
+        [[nodiscard]] inline auto mean() const -> detail::mean_t<value>
+        {
+            using mean_t = detail::mean_t<value>;
+            return reduce<mean_t>(detail::reduce_sum{}) / static_cast<mean_t>(totalSize());
+        }
+
+        // Kernel accessor: no bounds check in release, checked when TINYTOOLS_BOUNDS_CHECK >= 2 (DEBUG_BUILD).
+        [[nodiscard]] inline constexpr auto unchecked(size_type r, size_type c) const noexcept(!detail::checkInternalAccess) -> reference
+        {
+            detail::checkIndex<detail::checkInternalAccess>(r, c, rows_, cols_);
+            return data_[r * rowStride_ + c * colStride_];
+        }
+
+    private:
+        // result_t: element type of the result, acc_t: type the fold runs in.
+        template <typename result_t, typename acc_t, typename Allocator, Layout L, typename op_t>
+        [[nodiscard]] inline auto reduce(Direction dir, op_t op) const -> matrix<result_t, Allocator, L>
+        {
+            detail::operation_scope const scope{Operation::REDUCE};
+            if (dir == Direction::NONE)
+            {
+                throw std::invalid_argument("Direction must be Columns (1) or Rows (2).\n");
+            }
+
+            auto const columns = dir == Direction::COLUMNS;
+            auto const outRows = columns ? 1 : rows_;
+            auto const outCols = columns ? cols_ : 1;
+            auto run = [this, columns, op](auto *out)
+            {
+                // Column-major storage is walked as its transpose, so the kernels read contiguous lines.
+                if (columnOrder())
+                {
+                    if (columns)
+                    {
+                        detail::reduce_rows<acc_t>(data_, cols_, rows_, colStride_, rowStride_, out, op);
+                    }
+                    else
+                    {
+                        detail::reduce_cols<acc_t>(data_, cols_, rows_, colStride_, rowStride_, out, op);
+                    }
+                }
+                else if (columns)
+                {
+                    detail::reduce_cols<acc_t>(data_, rows_, cols_, rowStride_, colStride_, out, op);
+                }
+                else
+                {
+                    detail::reduce_rows<acc_t>(data_, rows_, cols_, rowStride_, colStride_, out, op);
+                }
+            };
+
+            if constexpr (std::is_same_v<result_t, bool>)
+            {
+                // std::vector<bool> is packed, fold into acc_t and convert.
+                std::vector<acc_t> out(outRows * outCols);
+                run(out.data());
+                return matrix<result_t, Allocator, L>{outRows, outCols, typename matrix<result_t, Allocator, L>::container_type(out.begin(), out.end())};
+            }
+            else
+            {
+                matrix<result_t, Allocator, L> ret{outRows, outCols, result_t{}};
+                run(ret.ptr());
+                return ret;
+            }
+        }
+
+        template <typename acc_t, typename op_t>
+        [[nodiscard]] inline auto reduce(op_t op) const -> acc_t
+        {
+            detail::operation_scope const scope{Operation::REDUCE};
+            if (columnOrder())
+            {
+                return detail::reduce_total<acc_t>(data_, cols_, rows_, colStride_, rowStride_, op);
+            }
+            return detail::reduce_total<acc_t>(data_, rows_, cols_, rowStride_, colStride_, op);
+        }
+
+        // Columns contiguous and rows not: column-major storage or a transposed view.
+        [[nodiscard]] inline constexpr auto columnOrder() const noexcept -> bool { return rowStride_ == 1 && colStride_ != 1; }
+
+        T *data_{};
+        size_type rows_{};
+        size_type cols_{};
+        size_type rowStride_{};
+        size_type colStride_{};
+    };
+
+    template <typename T>
+    auto operator<<(std::ostream &os, matrix_view<T> const &rhv) -> std::ostream &
+    {
+        // Numbers go through the buffered to_chars writer with the precision and notation of the stream.
+        if constexpr (!detail::is_character_v<std::remove_const_t<T>>)
+        {
+            if (detail::float_format format{}; detail::streamFloatFormat(os, format))
+            {
+                detail::writeRows(os, rhv, ' ', format);
+                return os;
+            }
+        }
+        for (std::size_t r{}; r < rhv.rows(); ++r)
+        {
+            for (std::size_t c{}; c < rhv.cols(); ++c)
+            {
+                os << rhv.unchecked(r, c);
+                os << (c + 1 == rhv.cols() ? '\n' : ' ');
+            }
+        }
+        return os;
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr inline auto size(matrix_view<T> const &view) noexcept -> std::tuple<std::size_t, std::size_t>
+    {
+        return std::tuple{view.rows(), view.cols()};
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_VIEW_HPP */
@@ -0,0 +1,159 @@
+#ifndef MATRIX_PARALLEL_HPP
+#define MATRIX_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// With TBB (the backend of the parallel algorithms) the thread count is enforced through a task_arena, otherwise it
+// only sets how many chunks the work is split in.
+#if __has_include(<oneapi/tbb/task_arena.h>)
+#include <oneapi/tbb/task_arena.h>
+#include <optional>
+#define TINYTOOLS_HAS_TBB 1
+#else
+#define TINYTOOLS_HAS_TBB 0
+#endif
+
+namespace tinyTools
+{
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Execution policy used by the element-wise and reduction methods.
+    //   SEQUENTIAL: everything runs on the calling thread (default).
+    //   PARALLEL:   work bigger than parallelThreshold() elements is split in chunks over std::execution::par_unseq.
+    enum struct Execution : std::uint8_t
+    {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
+    namespace detail
+    {
+        inline std::atomic<Execution> g_execution{Execution::SEQUENTIAL};
+        inline std::atomic<std::size_t> g_parallelThreshold{std::size_t{1} << 16U};
+        inline std::atomic<std::size_t> g_threadCount{0};
+
+        // Chunks are multiple of 64 elements: one cache line for 1-byte types and one std::vector<bool> word,
+        // so two chunks never write to the same word.
+        inline constexpr std::size_t chunkAlignment{64};
+    } // namespace detail
+
+    inline auto setExecutionPolicy(Execution policy) noexcept -> void { detail::g_execution.store(policy, std::memory_order_relaxed); }
+    [[nodiscard]] inline auto executionPolicy() noexcept -> Execution { return detail::g_execution.load(std::memory_order_relaxed); }
+
+    // Minimum amount of elements to go parallel, smaller work does not pay the threading overhead.
+    inline auto setParallelThreshold(std::size_t elements) noexcept -> void { detail::g_parallelThreshold.store(std::max<std::size_t>(elements, 1), std::memory_order_relaxed); }
+    [[nodiscard]] inline auto parallelThreshold() noexcept -> std::size_t { return detail::g_parallelThreshold.load(std::memory_order_relaxed); }
+
+    // Amount of worker threads used by the parallel work, 0 (default) uses every hardware thread.
+    inline auto setThreadCount(std::size_t threads) noexcept -> void { detail::g_threadCount.store(threads, std::memory_order_relaxed); }
+    [[nodiscard]] inline auto threadCount() noexcept -> std::size_t
+    {
+        auto const threads = detail::g_threadCount.load(std::memory_order_relaxed);
+        return threads != 0 ? threads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    namespace detail
+    {
+        [[nodiscard]] inline auto runParallel(std::size_t size) noexcept -> bool
+        {
+            return executionPolicy() == Execution::PARALLEL && size >= parallelThreshold();
+        }
+
+        // Calls func(begin, end) over [0, size), in parallel chunks when the policy allows it.
+        // itemWork is the amount of elements touched per item (e.g. cols() when iterating rows).
+        // func must not throw (par_unseq calls std::terminate).
+        // A few chunks per worker so work stealing can balance them.
+        [[nodiscard]] inline auto chunkSize(std::size_t size) noexcept -> std::size_t
+        {
+            auto const workers = threadCount();
+            auto const chunk = (size + workers * 4 - 1) / (workers * 4);
+            return (chunk + chunkAlignment - 1) / chunkAlignment * chunkAlignment;
+        }
+
+        // Runs func on threadCount() workers. The arena is cached per calling thread and rebuilt when the count changes.
+        template <typename func_t>
+        inline auto with_workers(func_t &&func) -> void
+        {
+#if TINYTOOLS_HAS_TBB
+            // Nested calls already run inside an arena of the right size.
+            if (auto const threads = static_cast<int>(threadCount()); g_threadCount.load(std::memory_order_relaxed) != 0 && tbb::this_task_arena::max_concurrency() != threads)
+            {
+                thread_local std::optional<tbb::task_arena> arena{};
+                if (!arena || arena->max_concurrency() != threads)
+                {
+                    arena.emplace(threads);
+                }
+                arena->execute(func);
+                return;
+            }
+#endif
+            func();
+        }
+
+        template <typename func_t>
+        inline auto for_each_chunk(std::size_t size, std::size_t itemWork, func_t &&func) -> void
+        {
+            if (!runParallel(size * itemWork))
+            {
+                func(std::size_t{}, size);
+                return;
+            }
+
+            auto const chunk = chunkSize(size);
+            std::vector<std::size_t> starts{};
+            starts.reserve(size / chunk + 1);
+            for (std::size_t begin{}; begin < size; begin += chunk)
+            {
+                starts.emplace_back(begin);
+            }
+
+            with_workers([&]
+                         { std::for_each(std::execution::par_unseq, starts.begin(), starts.end(),
+                                         [&func, chunk, size](std::size_t begin) { func(begin, std::min(begin + chunk, size)); }); });
+        }
+
+        template <typename func_t>
+        inline auto for_each_chunk(std::size_t size, func_t &&func) -> void
+        {
+            for_each_chunk(size, 1, std::forward<func_t>(func));
+        }
+
+        // Calls func(begin, end) -> partial over the same chunks as for_each_chunk and returns the partials in chunk order,
+        // so combining them left to right gives the same result on every run.
+        template <typename func_t>
+        [[nodiscard]] inline auto map_chunks(std::size_t size, std::size_t itemWork, func_t &&func)
+        {
+            using partial_t = std::invoke_result_t<func_t &, std::size_t, std::size_t>;
+            std::vector<partial_t> partials{};
+            if (!runParallel(size * itemWork))
+            {
+                partials.emplace_back(func(std::size_t{}, size));
+                return partials;
+            }
+
+            auto const chunk = chunkSize(size);
+            partials.resize((size + chunk - 1) / chunk);
+            std::vector<std::size_t> indexes(partials.size());
+            std::iota(indexes.begin(), indexes.end(), std::size_t{});
+
+            // Partials may allocate, par (not par_unseq) allows it.
+            with_workers([&]
+                         { std::for_each(std::execution::par, indexes.begin(), indexes.end(),
+                                         [&func, &partials, chunk, size](std::size_t idx)
+                                         {
+                                             auto const begin = idx * chunk;
+                                             partials[idx] = func(begin, std::min(begin + chunk, size));
+                                         }); });
+            return partials;
+        }
+    } // namespace detail
+} // namespace tinyTools
+
+#endif /* MATRIX_PARALLEL_HPP */
@@ -0,0 +1,270 @@
+#ifndef MATRIX_RANDOM_HPP
+#define MATRIX_RANDOM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "detail/simd.hpp"
+#include "parallel.hpp"
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+// Block b of a generator is philox(counter = {b, stream}, key = seed): 4 independent 32-bit words computed from the
+// block index alone, so any range of the sequence is generated without running through the previous ones.
+//   - Fills are split in parallel chunks and give the same values for any thread count or chunk size.
+//   - Each fill consumes the blocks it used, the next fill continues the sequence.
+//   - Streams with the same seed are independent sequences (one per worker, per test, ...).
+//   tinyTools::rng gen{42};
+//   auto const weights = tinyTools::matrix<float>::randn(1024, 1024, gen);
+namespace tinyTools
+{
+    namespace detail
+    {
+        inline constexpr std::uint32_t philoxM0{0xD2511F53U};
+        inline constexpr std::uint32_t philoxM1{0xCD9E8D57U};
+        inline constexpr std::uint32_t philoxW0{0x9E3779B9U};
+        inline constexpr std::uint32_t philoxW1{0xBB67AE85U};
+
+        // Blocks generated per batch, the kernels vectorize across the blocks of a batch.
+        inline constexpr std::size_t philoxBatch{64};
+
+        // out[b * 4 + lane] = word lane of block first + b, for n blocks.
+#define TINYTOOLS_PHILOX_KERNEL(suffix, target)                                                                                 \
+    target inline auto philox_##suffix(std::uint64_t first, std::uint64_t stream, std::uint64_t seed, std::size_t n,           \
+                                       std::uint32_t *out) noexcept -> void                                                    \
+    {                                                                                                                          \
+        for (std::size_t b{}; b < n; ++b)                                                                                      \
+        {                                                                                                                      \
+            auto const counter = first + b;                                                                                    \
+            auto c0 = static_cast<std::uint32_t>(counter);                                                                     \
+            auto c1 = static_cast<std::uint32_t>(counter >> 32U);                                                              \
+            auto c2 = static_cast<std::uint32_t>(stream);                                                                      \
+            auto c3 = static_cast<std::uint32_t>(stream >> 32U);                                                               \
+            auto k0 = static_cast<std::uint32_t>(seed);                                                                        \
+            auto k1 = static_cast<std::uint32_t>(seed >> 32U);                                                                 \
+            for (int round{}; round < 10; ++round)                                                                             \
+            {                                                                                                                  \
+                auto const p0 = std::uint64_t{philoxM0} * c0;                                                                  \
+                auto const p1 = std::uint64_t{philoxM1} * c2;                                                                  \
+                c0 = static_cast<std::uint32_t>(p1 >> 32U) ^ c1 ^ k0;                                                          \
+                c1 = static_cast<std::uint32_t>(p1);                                                                           \
+                c2 = static_cast<std::uint32_t>(p0 >> 32U) ^ c3 ^ k1;                                                          \
+                c3 = static_cast<std::uint32_t>(p0);                                                                           \
+                k0 += philoxW0;                                                                                                \
+                k1 += philoxW1;                                                                                                \
+            }                                                                                                                  \
+            out[b * 4 + 0] = c0;                                                                                               \
+            out[b * 4 + 1] = c1;                                                                                               \
+            out[b * 4 + 2] = c2;                                                                                               \
+            out[b * 4 + 3] = c3;                                                                                               \
+        }                                                                                                                      \
+    }
+
+        TINYTOOLS_PHILOX_KERNEL(generic, )
+#ifdef TINYTOOLS_SIMD_X86
+        TINYTOOLS_PHILOX_KERNEL(sse2, __attribute__((target("sse2"))))
+        TINYTOOLS_PHILOX_KERNEL(avx2, __attribute__((target("avx2"))))
+        TINYTOOLS_PHILOX_KERNEL(avx512, __attribute__((target("avx512f,avx512bw,prefer-vector-width=512"))))
+#endif
+
+#undef TINYTOOLS_PHILOX_KERNEL
+
+        inline auto philox(std::uint64_t first, std::uint64_t stream, std::uint64_t seed, std::size_t n, std::uint32_t *out) noexcept -> void
+        {
+#ifdef TINYTOOLS_SIMD_X86
+            switch (simd::activeIsa())
+            {
+            case simd::Isa::AVX512:
+                philox_avx512(first, stream, seed, n, out);
+                return;
+            case simd::Isa::AVX2:
+                philox_avx2(first, stream, seed, n, out);
+                return;
+            case simd::Isa::SSE2:
+                philox_sse2(first, stream, seed, n, out);
+                return;
+            case simd::Isa::GENERIC:
+                break;
+            }
+#endif
+            philox_generic(first, stream, seed, n, out);
+        }
+
+        // 32-bit types take one word per value (4 per block), 64-bit types two words (2 per block).
+        template <typename T>
+        inline constexpr std::size_t valuesPerBlock{sizeof(T) > 4 ? 2 : 4};
+
+        template <typename T>
+        [[nodiscard]] inline auto wordsOf(std::uint32_t const *words, std::size_t idx) noexcept -> std::uint64_t
+        {
+            if constexpr (sizeof(T) > 4)
+            {
+                return std::uint64_t{words[idx * 2]} << 32U | words[idx * 2 + 1];
+            }
+            else
+            {
+                return words[idx];
+            }
+        }
+
+        // [0, 1) with the full mantissa: 24 bits for float, 53 for double and long double.
+        template <typename T>
+        [[nodiscard]] inline constexpr auto unitReal(std::uint64_t bits) noexcept -> T
+        {
+            if constexpr (sizeof(T) > 4)
+            {
+                return static_cast<T>(static_cast<double>(bits >> 11U) * 0x1.0p-53);
+            }
+            else
+            {
+                return static_cast<T>(static_cast<float>(bits >> 8U) * 0x1.0p-24F);
+            }
+        }
+
+        // High 64 bits of the 128-bit product a * b from four 32-bit partial products (no __int128 under -Wpedantic or MSVC).
+        [[nodiscard]] inline constexpr auto mulHi64(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t
+        {
+            auto const aLo = a & 0xFFFFFFFFU;
+            auto const aHi = a >> 32U;
+            auto const bLo = b & 0xFFFFFFFFU;
+            auto const bHi = b >> 32U;
+            auto const lolo = aLo * bLo;
+            auto const hilo = aHi * bLo;
+            auto const lohi = aLo * bHi;
+            auto const cross = (lolo >> 32U) + (hilo & 0xFFFFFFFFU) + lohi;
+            return aHi * bHi + (hilo >> 32U) + (cross >> 32U);
+        }
+
+        // Uniform integer in [lo, hi] by multiply-shift (Lemire), the bias is below range / 2^32 (2^64 for 64-bit types).
+        template <typename T>
+        [[nodiscard]] inline constexpr auto unitInteger(std::uint64_t bits, T lo, std::uint64_t range) noexcept -> T
+        {
+            using unsigned_t = std::make_unsigned_t<T>;
+            if (range == 0)
+            {
+                return static_cast<T>(bits); // Whole range of a 64-bit type.
+            }
+            if constexpr (sizeof(T) > 4)
+            {
+                auto const offset = mulHi64(bits, range);
+                return static_cast<T>(static_cast<unsigned_t>(lo) + offset);
+            }
+            else
+            {
+                auto const offset = (bits * range) >> 32U;
+                return static_cast<T>(static_cast<unsigned_t>(static_cast<unsigned_t>(lo) + offset));
+            }
+        }
+    } // namespace detail
+
+    struct rng
+    {
+        using seed_type = std::uint64_t;
+
+        inline explicit constexpr rng(seed_type seed, seed_type stream = 0) noexcept
+            : seed_{seed}, stream_{stream}
+        {
+        }
+
+        [[nodiscard]] inline constexpr auto seed() const noexcept -> seed_type { return seed_; }
+        [[nodiscard]] inline constexpr auto stream() const noexcept -> seed_type { return stream_; }
+        // Blocks consumed so far, the next fill starts here.
+        [[nodiscard]] inline constexpr auto offset() const noexcept -> seed_type { return offset_; }
+
+        // Same seed, another independent sequence.
+        [[nodiscard]] inline constexpr auto split(seed_type stream) const noexcept -> rng { return rng{seed_, stream}; }
+        // Jumps to any block of the sequence, O(1).
+        inline constexpr auto seek(seed_type block) noexcept -> void { offset_ = block; }
+
+        // Raw words of one block.
+        [[nodiscard]] inline auto block(seed_type index) const noexcept -> std::array<std::uint32_t, 4>
+        {
+            std::array<std::uint32_t, 4> ret{};
+            detail::philox(index, stream_, seed_, 1, ret.data());
+            return ret;
+        }
+
+        // Uniform values: integers in [lo, hi], floating point in [lo, hi).
+        template <typename T>
+            requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        inline auto uniform(std::span<T> dst, T lo, T hi) -> void
+        {
+            if (hi < lo)
+            {
+                throw std::invalid_argument("Uniform range must have lo <= hi!\n");
+            }
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // lo * (1 - u) + hi * u cannot overflow like hi - lo, rounding can still reach hi so the result is clamped.
+                auto const top = std::nextafter(hi, lo);
+                fill<T>(dst, [lo, hi, top](std::uint32_t const *words, std::size_t idx)
+                        {
+                            auto const u = detail::unitReal<T>(detail::wordsOf<T>(words, idx));
+                            return std::clamp(static_cast<T>(lo * (T{1} - u) + hi * u), lo, top);
+                        });
+            }
+            else
+            {
+                using unsigned_t = std::make_unsigned_t<T>;
+                auto const range = static_cast<std::uint64_t>(static_cast<unsigned_t>(static_cast<unsigned_t>(hi) - static_cast<unsigned_t>(lo))) + 1;
+                fill<T>(dst, [lo, range](std::uint32_t const *words, std::size_t idx) { return detail::unitInteger<T>(detail::wordsOf<T>(words, idx), lo, range); });
+            }
+        }
+
+        // Normal values (Box-Muller, every pair of uniforms gives two values).
+        template <typename T>
+            requires std::is_floating_point_v<T>
+        inline auto normal(std::span<T> dst, T mean, T stddev) -> void
+        {
+            fill<T>(dst, [mean, stddev](std::uint32_t const *words, std::size_t idx)
+                    {
+                        auto const pair = idx & ~std::size_t{1};
+                        // u1 in (0, 1] keeps the log finite.
+                        auto const u1 = T{1} - detail::unitReal<T>(detail::wordsOf<T>(words, pair));
+                        auto const u2 = detail::unitReal<T>(detail::wordsOf<T>(words, pair + 1));
+                        auto const radius = std::sqrt(T{-2} * std::log(u1));
+                        auto const angle = T{2} * std::numbers::pi_v<T> * u2;
+                        return static_cast<T>(mean + stddev * radius * ((idx & 1U) == 0 ? std::cos(angle) : std::sin(angle)));
+                    });
+        }
+
+    private:
+        seed_type seed_{};
+        seed_type stream_{};
+        seed_type offset_{};
+
+        // dst[i] = convert(words of its block, lane), value i belongs to block offset_ + i / valuesPerBlock.
+        template <typename T, typename convert_t>
+        inline auto fill(std::span<T> dst, convert_t convert) -> void
+        {
+            constexpr auto perBlock = detail::valuesPerBlock<T>;
+            auto const blocks = (dst.size() + perBlock - 1) / perBlock;
+            auto const first = offset_;
+            detail::for_each_chunk(blocks, perBlock, [this, dst, first, convert](std::size_t begin, std::size_t end)
+                                   {
+                                       std::array<std::uint32_t, detail::philoxBatch * 4> words{};
+                                       for (auto b{begin}; b < end; b += detail::philoxBatch)
+                                       {
+                                           auto const count = std::min(detail::philoxBatch, end - b);
+                                           detail::philox(first + b, stream_, seed_, count, words.data());
+                                           auto const base = b * perBlock;
+                                           auto const n = std::min(count * perBlock, dst.size() - base);
+                                           for (std::size_t i{}; i < n; ++i)
+                                           {
+                                               dst[base + i] = convert(words.data(), i);
+                                           }
+                                       }
+                                   });
+            offset_ += blocks;
+        }
+    };
+} // namespace tinyTools
+
+#endif /* MATRIX_RANDOM_HPP */
@@ -0,0 +1,699 @@
+#ifndef MATRIX_SPARSE_MATRIX_HPP
+#define MATRIX_SPARSE_MATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+// Compressed sparse matrices, memory and work scale with the amount of nonzeros instead of rows * cols.
+//   CSR: one slice per row (offsets has rows + 1 entries), indices are the columns of the nonzeros.
+//   CSC: one slice per column, indices are the rows.
+// Indices are sorted and unique within a slice. Results of the element-wise operations drop the zeros they produce.
+//   tinyTools::sparse_matrix<double> const adjacency{dense};
+//   auto const y = adjacency * x; // SpMV when x is a column.
+namespace tinyTools
+{
+    enum struct SparseFormat : std::uint8_t
+    {
+        CSR,
+        CSC
+    };
+
+    // Coordinate entry for sparse_matrix::fromTriplets.
+    template <numerical T>
+    struct sparse_entry
+    {
+        std::size_t row{};
+        std::size_t col{};
+        T value{};
+    };
+
+    namespace detail
+    {
+        // Nonzeros per parallel item of the products, rows of one item run on the same thread.
+        inline constexpr std::size_t sparseGrain{256};
+    } // namespace detail
+
+    template <numerical T>
+        requires(!std::is_same_v<T, bool>)
+    struct sparse_matrix
+    {
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        using value = T;
+        using size_type = std::size_t;
+        // 32-bit inner indices: the products stream indices and values, half the index bytes is more nonzeros per cache line.
+        using index_type = std::uint32_t;
+        using Format = SparseFormat;
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Ctors.
+        // All zeros.
+        inline explicit sparse_matrix(size_type const rows, size_type const cols, Format const format = Format::CSR)
+            : rows_{rows}, cols_{cols}, format_{format}
+        {
+            checkShape();
+            offsets_.assign(outerSize() + 1, 0);
+        }
+
+        // Compressed arrays as they are, validated.
+        inline explicit sparse_matrix(size_type const rows, size_type const cols, Format const format, std::vector<size_type> offsets,
+                                      std::vector<index_type> indices, std::vector<T> values)
+            : rows_{rows}, cols_{cols}, format_{format}, offsets_{std::move(offsets)}, indices_{std::move(indices)}, values_{std::move(values)}
+        {
+            checkShape();
+            validate();
+        }
+
+        // Nonzeros of a dense matrix.
+        template <typename Allocator>
+        inline explicit sparse_matrix(matrix<T, Allocator> const &rhm, Format const format = Format::CSR)
+            : sparse_matrix(rhm.view(), format)
+        {
+        }
+
+        template <typename U>
+            requires std::is_same_v<std::remove_const_t<U>, T>
+        inline explicit sparse_matrix(matrix_view<U> const &rhv, Format const format = Format::CSR)
+            : sparse_matrix(rhv.rows(), rhv.cols(), format)
+        {
+            auto const csr = format_ == Format::CSR;
+            auto at = [&rhv, csr](size_type outer, size_type inner) { return csr ? rhv.unchecked(outer, inner) : rhv.unchecked(inner, outer); };
+
+            for (size_type o{}; o < outerSize(); ++o)
+            {
+                size_type count{};
+                for (size_type i{}; i < innerSize(); ++i)
+                {
+                    if (at(o, i) != T{})
+                    {
+                        ++count;
+                    }
+                }
+                offsets_[o + 1] = offsets_[o] + count;
+            }
+            indices_.resize(offsets_.back());
+            values_.resize(offsets_.back());
+            detail::for_each_chunk(outerSize(), innerSize(), [this, at](size_type begin, size_type end)
+                                   {
+                                       for (auto o{begin}; o < end; ++o)
+                                       {
+                                           auto k = offsets_[o];
+                                           for (size_type i{}; i < innerSize(); ++i)
+                                           {
+                                               if (auto const v = at(o, i); v != T{})
+                                               {
+                                                   indices_[k] = static_cast<index_type>(i);
+                                                   values_[k++] = v;
+                                               }
+                                           }
+                                       }
+                                   });
+        }
+
+        // Coordinate list in any order, duplicates are summed.
+        [[nodiscard]] static inline auto fromTriplets(size_type rows, size_type cols, std::span<sparse_entry<T> const> entries, Format format = Format::CSR) -> sparse_matrix
+        {
+            sparse_matrix ret{rows, cols, format};
+            auto const csr = format == Format::CSR;
+            for (auto const &entry : entries)
+            {
+                detail::checkIndex<true>(entry.row, entry.col, rows, cols);
+                ++ret.offsets_[(csr ? entry.row : entry.col) + 1];
+            }
+            std::partial_sum(ret.offsets_.begin(), ret.offsets_.end(), ret.offsets_.begin());
+
+            // Bucket by slice, then sort every slice and fold the duplicates.
+            std::vector<std::pair<index_type, T>> slots(entries.size());
+            auto cursor = ret.offsets_;
+            for (auto const &entry : entries)
+            {
+                auto const outer = csr ? entry.row : entry.col;
+                slots[cursor[outer]++] = {static_cast<index_type>(csr ? entry.col : entry.row), entry.value};
+            }
+
+            ret.indices_.reserve(entries.size());
+            ret.values_.reserve(entries.size());
+            size_type begin{};
+            for (size_type o{}; o < ret.outerSize(); ++o)
+            {
+                auto const end = ret.offsets_[o + 1];
+                std::stable_sort(slots.begin() + static_cast<std::ptrdiff_t>(begin), slots.begin() + static_cast<std::ptrdiff_t>(end),
+                          [](auto const &lhs, auto const &rhs) { return lhs.first < rhs.first; });
+                for (auto k{begin}; k < end;)
+                {
+                    auto const index = slots[k].first;
+                    auto sum = T{};
+                    for (; k < end && slots[k].first == index; ++k)
+                    {
+                        sum += slots[k].second;
+                    }
+                    if (sum != T{})
+                    {
+                        ret.indices_.push_back(index);
+                        ret.values_.push_back(sum);
+                    }
+                }
+                begin = end;
+                ret.offsets_[o + 1] = ret.indices_.size();
+            }
+            return ret;
+        }
+
+        template <typename Allocator = std::allocator<T>>
+        [[nodiscard]] inline auto toMatrix() const -> matrix<T, Allocator>
+        {
+            matrix<T, Allocator> ret{rows_, cols_, T{}};
+            auto *const out = ret.ptr();
+            detail::for_each_chunk(outerSize(), innerSize(), [this, out](size_type begin, size_type end)
+                                   {
+                                       for (auto o{begin}; o < end; ++o)
+                                       {
+                                           for (auto k{offsets_[o]}; k < offsets_[o + 1]; ++k)
+                                           {
+                                               out[denseIndex(o, indices_[k])] = values_[k];
+                                           }
+                                       }
+                                   });
+            return ret;
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Getters.
+        [[nodiscard]] inline auto rows() const noexcept -> size_type { return rows_; }
+        [[nodiscard]] inline auto cols() const noexcept -> size_type { return cols_; }
+        [[nodiscard]] inline auto format() const noexcept -> Format { return format_; }
+        [[nodiscard]] inline auto nonZeros() const noexcept -> size_type { return values_.size(); }
+        [[nodiscard]] inline auto density() const noexcept -> double { return static_cast<double>(nonZeros()) / static_cast<double>(rows_ * cols_); }
+        // Slices (rows for CSR, columns for CSC) and the length of each one.
+        [[nodiscard]] inline auto outerSize() const noexcept -> size_type { return format_ == Format::CSR ? rows_ : cols_; }
+        [[nodiscard]] inline auto innerSize() const noexcept -> size_type { return format_ == Format::CSR ? cols_ : rows_; }
+
+        [[nodiscard]] inline auto offsets() const noexcept -> std::span<size_type const> { return offsets_; }
+        [[nodiscard]] inline auto indices() const noexcept -> std::span<index_type const> { return indices_; }
+        [[nodiscard]] inline auto values() const noexcept -> std::span<T const> { return values_; }
+        // The values can change in place, the structure can not.
+        [[nodiscard]] inline auto values() noexcept -> std::span<T> { return values_; }
+
+        [[nodiscard]] inline auto sameSize(sparse_matrix const &rhm) const noexcept -> bool { return rows_ == rhm.rows_ && cols_ == rhm.cols_; }
+
+        // Binary search in the slice, zero when the element is not stored.
+        [[nodiscard]] inline auto operator()(size_type r, size_type c) const -> T
+        {
+            detail::checkIndex<detail::checkPublicAccess>(r, c, rows_, cols_);
+            auto const outer = format_ == Format::CSR ? r : c;
+            auto const inner = static_cast<index_type>(format_ == Format::CSR ? c : r);
+            auto const first = indices_.begin() + static_cast<std::ptrdiff_t>(offsets_[outer]);
+            auto const last = indices_.begin() + static_cast<std::ptrdiff_t>(offsets_[outer + 1]);
+            auto const it = std::lower_bound(first, last, inner);
+            return it != last && *it == inner ? values_[static_cast<size_type>(it - indices_.begin())] : T{};
+        }
+
+        [[nodiscard]] inline auto operator==(sparse_matrix const &rhm) const -> bool
+        {
+            if (!sameSize(rhm))
+            {
+                return false;
+            }
+            if (format_ != rhm.format_)
+            {
+                return *this == rhm.convert(format_);
+            }
+            return offsets_ == rhm.offsets_ && indices_ == rhm.indices_ && values_ == rhm.values_;
+        }
+        [[nodiscard]] inline auto operator!=(sparse_matrix const &rhm) const -> bool { return !(operator==(rhm)); }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Methods.
+        // Same matrix in the other format (counting sort over the inner indices, O(nonZeros + rows + cols)).
+        [[nodiscard]] inline auto convert(Format format) const -> sparse_matrix
+        {
+            if (format == format_)
+            {
+                return *this;
+            }
+            sparse_matrix ret{rows_, cols_, format};
+            for (auto const index : indices_)
+            {
+                ++ret.offsets_[index + 1];
+            }
+            std::partial_sum(ret.offsets_.begin(), ret.offsets_.end(), ret.offsets_.begin());
+            ret.indices_.resize(nonZeros());
+            ret.values_.resize(nonZeros());
+            auto cursor = ret.offsets_;
+            for (size_type o{}; o < outerSize(); ++o)
+            {
+                for (auto k{offsets_[o]}; k < offsets_[o + 1]; ++k)
+                {
+                    auto const dst = cursor[indices_[k]]++;
+                    ret.indices_[dst] = static_cast<index_type>(o);
+                    ret.values_[dst] = values_[k];
+                }
+            }
+            return ret;
+        }
+
+        // Transpose: the CSR arrays of a matrix are the CSC arrays of its transpose, nothing is reordered.
+        [[nodiscard]] inline auto t() const -> sparse_matrix
+        {
+            return sparse_matrix{cols_, rows_, format_ == Format::CSR ? Format::CSC : Format::CSR, offsets_, indices_, values_, unchecked_tag{}};
+        }
+
+        // Removes the stored zeros (e.g. after changing values()).
+        inline auto prune() -> void
+        {
+            size_type k{};
+            size_type begin{};
+            for (size_type o{}; o < outerSize(); ++o)
+            {
+                auto const end = offsets_[o + 1];
+                for (auto src{begin}; src < end; ++src)
+                {
+                    if (values_[src] != T{})
+                    {
+                        indices_[k] = indices_[src];
+                        values_[k++] = values_[src];
+                    }
+                }
+                begin = end;
+                offsets_[o + 1] = k;
+            }
+            indices_.resize(k);
+            values_.resize(k);
+        }
+
+        // SpMV: y = A * x.
+        inline auto multiply(std::span<T const> x, std::span<T> y) const -> void
+        {
+            if (x.size() != cols_ || y.size() != rows_)
+            {
+                throw std::invalid_argument("Vector sizes must match the sparse matrix cols and rows.\n");
+            }
+            std::fill(y.begin(), y.end(), T{});
+            product(x.data(), 1, y.data());
+        }
+
+        // Element-wise product in place, with a sparse or dense matrix. (Matlab: .*)
+        inline auto multiply(sparse_matrix const &rhm) -> void { *this = merge<false>(rhm, [](T lhs, T rhs) { return lhs * rhs; }); }
+
+        template <typename Allocator>
+        inline auto multiply(matrix<T, Allocator> const &rhm) -> void
+        {
+            checkSize(rhm.rows(), rhm.cols());
+            for (size_type o{}; o < outerSize(); ++o)
+            {
+                for (auto k{offsets_[o]}; k < offsets_[o + 1]; ++k)
+                {
+                    values_[k] *= rhm.ptr()[denseIndex(o, indices_[k])];
+                }
+            }
+            prune();
+        }
+
+        // -----------------------------------------------------------------------------------------------------------------------------------------------------
+        // Operators.
+        [[nodiscard]] inline auto operator+(sparse_matrix const &rhm) const -> sparse_matrix { return merge<true>(rhm, [](T lhs, T rhs) { return lhs + rhs; }); }
+        [[nodiscard]] inline auto operator-(sparse_matrix const &rhm) const -> sparse_matrix { return merge<true>(rhm, [](T lhs, T rhs) { return lhs - rhs; }); }
+        inline auto operator+=(sparse_matrix const &rhm) -> sparse_matrix & { return *this = *this + rhm; }
+        inline auto operator-=(sparse_matrix const &rhm) -> sparse_matrix & { return *this = *this - rhm; }
+
+        [[nodiscard]] inline auto operator-() const -> sparse_matrix
+        {
+            auto ret{*this};
+            for (auto &v : ret.values_)
+            {
+                v = static_cast<T>(-v);
+            }
+            return ret;
+        }
+
+        inline auto operator*=(T const scalar) -> sparse_matrix &
+        {
+            for (auto &v : values_)
+            {
+                v *= scalar;
+            }
+            prune();
+            return *this;
+        }
+        [[nodiscard]] friend inline auto operator*(sparse_matrix lhm, T const scalar) -> sparse_matrix { return lhm *= scalar; }
+        [[nodiscard]] friend inline auto operator*(T const scalar, sparse_matrix rhm) -> sparse_matrix { return rhm *= scalar; }
+
+        // Sparse plus or minus dense is dense.
+        template <typename Allocator>
+        [[nodiscard]] friend inline auto operator+(sparse_matrix const &lhm, matrix<T, Allocator> rhm) -> matrix<T, Allocator> { return lhm.addTo(std::move(rhm), false); }
+        template <typename Allocator>
+        [[nodiscard]] friend inline auto operator+(matrix<T, Allocator> lhm, sparse_matrix const &rhm) -> matrix<T, Allocator> { return rhm.addTo(std::move(lhm), false); }
+        template <typename Allocator>
+        [[nodiscard]] friend inline auto operator-(matrix<T, Allocator> lhm, sparse_matrix const &rhm) -> matrix<T, Allocator> { return rhm.addTo(std::move(lhm), true); }
+        template <typename Allocator>
+        [[nodiscard]] friend inline auto operator-(sparse_matrix const &lhm, matrix<T, Allocator> const &rhm) -> matrix<T, Allocator>
+        {
+            matrix<T, Allocator> ret{rhm.rows(), rhm.cols(), T{}};
+            ret -= rhm;
+            return lhm.addTo(std::move(ret), false);
+        }
+
+        // SpMM: sparse times dense (SpMV when rhm is a column).
+        template <typename Allocator>
+        [[nodiscard]] inline auto operator*(matrix<T, Allocator> const &rhm) const -> matrix<T, Allocator>
+        {
+            if (cols_ != rhm.rows())
+            {
+                throw std::invalid_argument("Matrixes left-matrix cols must be same size as right-matrix rows.\n");
+            }
+            matrix<T, Allocator> ret{rows_, rhm.cols(), T{}};
+            product(rhm.ptr(), rhm.cols(), ret.ptr());
+            return ret;
+        }
+
+        // Dense times sparse, every row of the result is independent.
+        template <typename Allocator>
+        [[nodiscard]] friend inline auto operator*(matrix<T, Allocator> const &lhm, sparse_matrix const &rhm) -> matrix<T, Allocator>
+        {
+            if (lhm.cols() != rhm.rows_)
+            {
+                throw std::invalid_argument("Matrixes left-matrix cols must be same size as right-matrix rows.\n");
+            }
+            matrix<T, Allocator> ret{lhm.rows(), rhm.cols_, T{}};
+            auto const *const a = lhm.ptr();
+            auto *const out = ret.ptr();
+            auto const k = lhm.cols();
+            auto const n = rhm.cols_;
+            detail::for_each_chunk(lhm.rows(), std::max<size_type>(rhm.nonZeros(), 1), [&rhm, a, out, k, n](size_type begin, size_type end)
+                                   {
+                                       for (auto r{begin}; r < end; ++r)
+                                       {
+                                           auto const *const row = a + r * k;
+                                           auto *const dst = out + r * n;
+                                           if (rhm.format_ == Format::CSR)
+                                           {
+                                               // dst += row[i] * (row i of rhm).
+                                               for (size_type i{}; i < k; ++i)
+                                               {
+                                                   if (row[i] == T{})
+                                                   {
+                                                       continue;
+                                                   }
+                                                   for (auto p{rhm.offsets_[i]}; p < rhm.offsets_[i + 1]; ++p)
+                                                   {
+                                                       dst[rhm.indices_[p]] += row[i] * rhm.values_[p];
+                                                   }
+                                               }
+                                           }
+                                           else
+                                           {
+                                               // dst[c] = row . (column c of rhm).
+                                               for (size_type c{}; c < n; ++c)
+                                               {
+                                                   auto sum = T{};
+                                                   for (auto p{rhm.offsets_[c]}; p < rhm.offsets_[c + 1]; ++p)
+                                                   {
+                                                       sum += row[rhm.indices_[p]] * rhm.values_[p];
+                                                   }
+                                                   dst[c] = sum;
+                                               }
+                                           }
+                                       }
+                                   });
+            return ret;
+        }
+
+    private:
+        struct unchecked_tag
+        {
+        };
+
+        size_type rows_{};
+        size_type cols_{};
+        Format format_{Format::CSR};
+        std::vector<size_type> offsets_{};
+        std::vector<index_type> indices_{};
+        std::vector<T> values_{};
+
+        // Arrays known to be valid (e.g. another matrix reinterpreted).
+        inline explicit sparse_matrix(size_type const rows, size_type const cols, Format const format, std::vector<size_type> offsets,
+                                      std::vector<index_type> indices, std::vector<T> values, unchecked_tag /*unused*/) noexcept
+            : rows_{rows}, cols_{cols}, format_{format}, offsets_{std::move(offsets)}, indices_{std::move(indices)}, values_{std::move(values)}
+        {
+        }
+
+        inline auto checkShape() const -> void
+        {
+            if (rows_ == 0)
+            {
+                throw std::length_error("Rows can not be 0!\n");
+            }
+            if (cols_ == 0)
+            {
+                throw std::length_error("Cols can not be 0!\n");
+            }
+            if (innerSize() > std::numeric_limits<index_type>::max())
+            {
+                throw std::length_error("Sparse inner dimension must fit in 32 bits!\n");
+            }
+        }
+
+        inline auto checkSize(size_type rows, size_type cols) const -> void
+        {
+            if (rows != rows_ || cols != cols_)
+            {
+                throw std::invalid_argument("Matrices are not the same size!\n");
+            }
+        }
+
+        inline auto validate() const -> void
+        {
+            if (offsets_.size() != outerSize() + 1 || offsets_.front() != 0 || offsets_.back() != indices_.size() || indices_.size() != values_.size())
+            {
+                throw std::invalid_argument("Sparse arrays do not match the shape!\n");
+            }
+            for (size_type o{}; o < outerSize(); ++o)
+            {
+                if (offsets_[o + 1] < offsets_[o])
+                {
+                    throw std::invalid_argument("Sparse offsets must not decrease!\n");
+                }
+                for (auto k{offsets_[o]}; k < offsets_[o + 1]; ++k)
+                {
+                    if (indices_[k] >= innerSize() || (k > offsets_[o] && indices_[k] <= indices_[k - 1]))
+                    {
+                        throw std::invalid_argument("Sparse indices must be in range, sorted and unique within a slice!\n");
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] inline auto denseIndex(size_type outer, size_type inner) const noexcept -> size_type
+        {
+            return format_ == Format::CSR ? outer * cols_ + inner : inner * cols_ + outer;
+        }
+
+        template <typename Allocator>
+        [[nodiscard]] inline auto addTo(matrix<T, Allocator> dense, bool const subtract) const -> matrix<T, Allocator>
+        {
+            checkSize(dense.rows(), dense.cols());
+            auto *const out = dense.ptr();
+            for (size_type o{}; o < outerSize(); ++o)
+            {
+                for (auto k{offsets_[o]}; k < offsets_[o + 1]; ++k)
+                {
+                    auto &dst = out[denseIndex(o, indices_[k])];
+                    dst = static_cast<T>(subtract ? dst - values_[k] : dst + values_[k]);
+                }
+            }
+            return dense;
+        }
+
+        // Slice by slice merge of the sorted indices, the union of both patterns or only their intersection.
+        // Counts first and fills after, so the slices are independent and run in parallel.
+        template <bool keepUnion, typename op_t>
+        [[nodiscard]] inline auto merge(sparse_matrix const &rhm, op_t op) const -> sparse_matrix
+        {
+            checkSize(rhm.rows_, rhm.cols_);
+            if (rhm.format_ != format_)
+            {
+                return merge<keepUnion>(rhm.convert(format_), op);
+            }
+
+            auto visit = [this, &rhm, op](size_type o, auto &&emit)
+            {
+                auto a = offsets_[o];
+                auto b = rhm.offsets_[o];
+                auto const aEnd = offsets_[o + 1];
+                auto const bEnd = rhm.offsets_[o + 1];
+                while (keepUnion ? (a < aEnd || b < bEnd) : (a < aEnd && b < bEnd))
+                {
+                    index_type index{};
+                    T result{};
+                    if (b == bEnd || (a < aEnd && indices_[a] < rhm.indices_[b]))
+                    {
+                        if constexpr (!keepUnion)
+                        {
+                            ++a;
+                            continue;
+                        }
+                        index = indices_[a];
+                        result = op(values_[a++], T{});
+                    }
+                    else if (a == aEnd || rhm.indices_[b] < indices_[a])
+                    {
+                        if constexpr (!keepUnion)
+                        {
+                            ++b;
+                            continue;
+                        }
+                        index = rhm.indices_[b];
+                        result = op(T{}, rhm.values_[b++]);
+                    }
+                    else
+                    {
+                        index = indices_[a];
+                        result = op(values_[a++], rhm.values_[b++]);
+                    }
+                    if (result != T{})
+                    {
+                        emit(index, result);
+                    }
+                }
+            };
+
+            sparse_matrix ret{rows_, cols_, format_};
+            auto const work = std::max<size_type>((nonZeros() + rhm.nonZeros()) / outerSize(), 1);
+            detail::for_each_chunk(outerSize(), work, [&ret, visit](size_type begin, size_type end)
+                                   {
+                                       for (auto o{begin}; o < end; ++o)
+                                       {
+                                           size_type count{};
+                                           visit(o, [&count](index_type, T) { ++count; });
+                                           ret.offsets_[o + 1] = count;
+                                       }
+                                   });
+            std::partial_sum(ret.offsets_.begin(), ret.offsets_.end(), ret.offsets_.begin());
+            ret.indices_.resize(ret.offsets_.back());
+            ret.values_.resize(ret.offsets_.back());
+            detail::for_each_chunk(outerSize(), work, [&ret, visit](size_type begin, size_type end)
+                                   {
+                                       for (auto o{begin}; o < end; ++o)
+                                       {
+                                           auto k = ret.offsets_[o];
+                                           visit(o, [&ret, &k](index_type index, T result)
+                                                 {
+                                                     ret.indices_[k] = index;
+                                                     ret.values_[k++] = result;
+                                                 });
+                                       }
+                                   });
+            return ret;
+        }
+
+        // First slice of parallel item p: items hold about sparseGrain nonzeros each, so skewed rows still split evenly.
+        [[nodiscard]] inline auto itemStart(size_type item, size_type items) const noexcept -> size_type
+        {
+            if (item == items)
+            {
+                return outerSize();
+            }
+            auto const it = std::lower_bound(offsets_.begin(), offsets_.end() - 1, item * detail::sparseGrain);
+            return static_cast<size_type>(it - offsets_.begin());
+        }
+
+        // out (rows_ x n, zeroed) += A * b (cols_ x n), both row-major.
+        inline auto product(T const *b, size_type const n, T *out) const -> void
+        {
+            auto const items = std::max<size_type>((nonZeros() + detail::sparseGrain - 1) / detail::sparseGrain, 1);
+            if (format_ == Format::CSR)
+            {
+                // Rows of the result are independent: each gathers the rows of b its nonzeros point to.
+                detail::for_each_chunk(items, detail::sparseGrain * n, [this, b, n, out, items](size_type begin, size_type end)
+                                       {
+                                           for (auto r{itemStart(begin, items)}; r < itemStart(end, items); ++r)
+                                           {
+                                               auto const first = offsets_[r];
+                                               auto const last = offsets_[r + 1];
+                                               if (n == 1)
+                                               {
+                                                   auto sum = T{};
+                                                   for (auto k{first}; k < last; ++k)
+                                                   {
+                                                       sum += values_[k] * b[indices_[k]];
+                                                   }
+                                                   out[r] = sum;
+                                                   continue;
+                                               }
+                                               auto *const dst = out + r * n;
+                                               for (auto k{first}; k < last; ++k)
+                                               {
+                                                   auto const v = values_[k];
+                                                   auto const *const src = b + size_type{indices_[k]} * n;
+                                                   for (size_type c{}; c < n; ++c)
+                                                   {
+                                                       dst[c] += v * src[c];
+                                                   }
+                                               }
+                                           }
+                                       });
+            }
+            else if (n == 1 && detail::runParallel(nonZeros()))
+            {
+                // Columns scatter into the whole result: one partial result per chunk, summed in chunk order.
+                auto const partials = detail::map_chunks(items, detail::sparseGrain, [this, b, items](size_type begin, size_type end)
+                                                         {
+                                                             std::vector<T> partial(rows_, T{});
+                                                             scatter(itemStart(begin, items), itemStart(end, items), b, 1, 0, 1, partial.data());
+                                                             return partial;
+                                                         });
+                for (auto const &partial : partials)
+                {
+                    for (size_type r{}; r < rows_; ++r)
+                    {
+                        out[r] += partial[r];
+                    }
+                }
+            }
+            else
+            {
+                // Columns of b and of the result are independent.
+                detail::for_each_chunk(n, std::max<size_type>(nonZeros(), 1), [this, b, n, out](size_type begin, size_type end)
+                                       { scatter(0, cols_, b, n, begin, end, out); });
+            }
+        }
+
+        // CSC: out[:, c0:c1] += (columns first..last of A) * b[first..last, c0:c1].
+        inline auto scatter(size_type first, size_type last, T const *b, size_type n, size_type c0, size_type c1, T *out) const noexcept -> void
+        {
+            for (auto col{first}; col < last; ++col)
+            {
+                auto const *const src = b + col * n;
+                for (auto k{offsets_[col]}; k < offsets_[col + 1]; ++k)
+                {
+                    auto const v = values_[k];
+                    auto *const dst = out + size_type{indices_[k]} * n;
+                    for (auto c{c0}; c < c1; ++c)
+                    {
+                        dst[c] += v * src[c];
+                    }
+                }
+            }
+        }
+    };
+
+    // Element-wise product of two sparse matrices, only the common nonzeros. (Matlab: .*)
+    template <numerical T>
+    [[nodiscard]] inline auto multiply(sparse_matrix<T> lhm, sparse_matrix<T> const &rhm) -> sparse_matrix<T>
+    {
+        lhm.multiply(rhm);
+        return lhm;
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_SPARSE_MATRIX_HPP */
@@ -0,0 +1,191 @@
+#ifndef MATRIX_TEXT_IO_HPP
+#define MATRIX_TEXT_IO_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "detail/text.hpp"
+#include "matrix.hpp"
+
+// Text matrices: one row per line, values separated by spaces, tabs, commas or semicolons (whitespace tables and CSV).
+//   writeText:   shortest round-trip text through a large to_chars buffer, readText reads it back bit exact.
+//   text_reader: streams the rows in blocks, so inputs bigger than memory can be processed block by block.
+namespace tinyTools
+{
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Writers. A view can be a row block of a bigger matrix, writing consecutive blocks to the same stream appends them.
+    template <typename U>
+    inline auto writeText(std::ostream &os, matrix_view<U> const &rhv, char separator = ' ') -> void
+    {
+        detail::writeRows(os, rhv, separator, detail::float_format{});
+    }
+
+    template <numerical T, typename Allocator>
+    inline auto writeText(std::ostream &os, matrix<T, Allocator> const &rhm, char separator = ' ') -> void
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            detail::text_writer writer{os};
+            std::size_t i{};
+            for (auto const value : rhm)
+            {
+                writer.put(value ? '1' : '0');
+                writer.put(++i % rhm.cols() == 0 ? '\n' : separator);
+            }
+            writer.flush();
+        }
+        else
+        {
+            writeText(os, rhm.view(), separator);
+        }
+    }
+
+    template <typename matrix_t>
+    inline auto writeText(std::filesystem::path const &path, matrix_t const &rhm, char separator = ' ') -> void
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Can not open file for writing: "} + path.string());
+        }
+        writeText(file, rhm, separator);
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Error writing file: "} + path.string());
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------------------------------------------
+    // Block reader. Every line is a row, blank lines are skipped, all rows must have the same amount of values.
+    template <numerical T, typename Allocator = std::allocator<T>>
+    struct text_reader
+    {
+        using size_type = std::size_t;
+        using matrix_type = matrix<T, Allocator>;
+
+        inline explicit text_reader(std::istream &is)
+            : is_{&is}
+        {
+        }
+
+        // Next block of at most maxRows rows, std::nullopt once the input is exhausted.
+        [[nodiscard]] inline auto next(size_type maxRows) -> std::optional<matrix_type>
+        {
+            if (maxRows == 0)
+            {
+                throw std::invalid_argument("Block must have at least one row!\n");
+            }
+
+            typename matrix_type::container_type values{};
+            if (cols_ != 0 && maxRows != std::numeric_limits<size_type>::max())
+            {
+                values.reserve(std::min(maxRows, detail::textBufferSize) * cols_);
+            }
+            size_type rows{};
+            std::string_view line{};
+            while (rows < maxRows && nextLine(line))
+            {
+                auto const count = detail::parseLine<T>(line, line_, [&values](T value) { values.push_back(value); });
+                if (count == 0)
+                {
+                    continue;
+                }
+                if (cols_ == 0)
+                {
+                    cols_ = count;
+                }
+                if (count != cols_)
+                {
+                    throw std::invalid_argument("Line " + std::to_string(line_) + " has " + std::to_string(count) + " values, expected " + std::to_string(cols_) + "!\n");
+                }
+                ++rows;
+            }
+
+            if (rows == 0)
+            {
+                return std::nullopt;
+            }
+            rowsRead_ += rows;
+            return matrix_type{rows, cols_, std::move(values)};
+        }
+
+        [[nodiscard]] inline auto cols() const noexcept -> size_type { return cols_; }
+        [[nodiscard]] inline auto rowsRead() const noexcept -> size_type { return rowsRead_; }
+
+    private:
+        std::istream *is_{};
+        std::string buffer_{};
+        size_type pos_{};
+        size_type line_{};
+        size_type cols_{};
+        size_type rowsRead_{};
+
+        // Next line without the newline, the view is valid until the next call.
+        inline auto nextLine(std::string_view &line) -> bool
+        {
+            for (;;)
+            {
+                if (auto const end = buffer_.find('\n', pos_); end != std::string::npos)
+                {
+                    line = std::string_view{buffer_}.substr(pos_, end - pos_);
+                    pos_ = end + 1;
+                    ++line_;
+                    return true;
+                }
+                if (!*is_)
+                {
+                    if (pos_ == buffer_.size())
+                    {
+                        return false;
+                    }
+                    line = std::string_view{buffer_}.substr(pos_);
+                    pos_ = buffer_.size();
+                    ++line_;
+                    return true;
+                }
+                // Keep the unfinished line and append the next chunk behind it.
+                buffer_.erase(0, pos_);
+                pos_ = 0;
+                auto const kept = buffer_.size();
+                buffer_.resize(kept + detail::textBufferSize);
+                is_->read(buffer_.data() + kept, static_cast<std::streamsize>(detail::textBufferSize));
+                buffer_.resize(kept + static_cast<size_type>(is_->gcount()));
+            }
+        }
+    };
+
+    // Whole input as one matrix.
+    template <numerical T, typename Allocator = std::allocator<T>>
+    [[nodiscard]] inline auto readText(std::istream &is) -> matrix<T, Allocator>
+    {
+        text_reader<T, Allocator> reader{is};
+        auto ret = reader.next(std::numeric_limits<std::size_t>::max());
+        if (!ret)
+        {
+            throw std::invalid_argument("No values to read!\n");
+        }
+        return std::move(*ret);
+    }
+
+    template <numerical T, typename Allocator = std::allocator<T>>
+    [[nodiscard]] inline auto readText(std::filesystem::path const &path) -> matrix<T, Allocator>
+    {
+        std::ifstream file{path, std::ios::binary};
+        if (!file)
+        {
+            throw std::runtime_error(std::string{"Can not open file for reading: "} + path.string());
+        }
+        return readText<T, Allocator>(file);
+    }
+} // namespace tinyTools
+
+#endif /* MATRIX_TEXT_IO_HPP */
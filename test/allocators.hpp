@@ -0,0 +1,96 @@
+#ifndef ALLOCATORS_TEST_HPP
+#define ALLOCATORS_TEST_HPP
+
+#include <cstdint>
+#include <set>
+
+#include "common.hpp"
+
+template <typename T> auto isAligned(T const* ptr, std::size_t alignment) -> bool { return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0; }
+
+TEST_F(TestMatrix, Alloc_aligned)
+{
+  using matrix_t = tinyTools::matrix<float, tinyTools::aligned_allocator<float>>;
+  for(std::size_t size{1}; size < 40; size += 7)
+  {
+    matrix_t const mat{size, size + 1, 2.F};
+    EXPECT_TRUE(isAligned(mat.view().ptr(), 64));
+  }
+
+  matrix_t const matA{2, 2, {1.F, 2.F, 3.F, 4.F}};
+  matrix_t const matB = matA * matrix_t::identity(2);
+  EXPECT_TRUE(matA == matB);
+
+  matrix_t const matC = matA + matB * 2.F;
+  EXPECT_TRUE(isAligned(matC.view().ptr(), 64));
+  auto const dataC = matC.data();
+  compareVectors(std::vector<float>(dataC.begin(), dataC.end()), {3.F, 6.F, 9.F, 12.F});
+
+  auto const sum = matC.sum(tinyTools::Direction::COLUMNS).data();
+  compareVectors(std::vector<float>(sum.begin(), sum.end()), {12.F, 18.F});
+
+  tinyTools::matrix<bool, tinyTools::aligned_allocator<bool>> const flags{2, 2, true};
+  EXPECT_EQ(flags.totalSize(), 4);
+}
+
+TEST_F(TestMatrix, Alloc_size_classes)
+{
+  using tinyTools::detail::size_class;
+  EXPECT_EQ(size_class::index(1), 0);
+  EXPECT_EQ(size_class::index(64), 0);
+  EXPECT_EQ(size_class::bytes(size_class::index(65)), 80);
+  EXPECT_EQ(size_class::bytes(size_class::index(128)), 128);
+  EXPECT_EQ(size_class::bytes(size_class::index(129)), 160);
+  EXPECT_EQ(size_class::index(size_class::maxPooledBytes), size_class::count - 1);
+  for(std::size_t bytes{1}; bytes < 100'000; bytes += 37)
+  {
+    auto const classBytes = size_class::bytes(size_class::index(bytes));
+    EXPECT_GE(classBytes, bytes);
+    EXPECT_LE(classBytes, bytes + bytes / 4 + 64);
+  }
+}
+
+TEST_F(TestMatrix, Alloc_pool_reuse)
+{
+  using matrix_t = tinyTools::matrix<double, tinyTools::pool_allocator<double>>;
+  tinyTools::releasePoolMemory();
+
+  double const* first{};
+  {
+    matrix_t const mat{30, 30, 1.};
+    first = mat.view().ptr();
+    EXPECT_TRUE(isAligned(first, 64));
+  }
+  EXPECT_GE(tinyTools::poolCachedBytes(), 30 * 30 * sizeof(double));
+
+  // Same shape matrixes get the cached block back.
+  for(int i{}; i < 4; ++i)
+  {
+    matrix_t const mat{30, 30, 2.};
+    EXPECT_EQ(mat.view().ptr(), first);
+  }
+
+  // A temporary feeding an expression: two blocks cycle through the pool, no new ones are requested.
+  std::set<double const*> blocks{};
+  for(int i{}; i < 8; ++i)
+  {
+    matrix_t const mat = matrix_t::ones(30) * 2.;
+    blocks.insert(mat.view().ptr());
+    EXPECT_EQ(mat(29, 29), 2.);
+  }
+  EXPECT_LE(blocks.size(), 2);
+
+  tinyTools::releasePoolMemory();
+  EXPECT_EQ(tinyTools::poolCachedBytes(), 0);
+
+  // Over the cache limit blocks go straight back to the system.
+  auto const limit = tinyTools::poolCacheLimit();
+  tinyTools::setPoolCacheLimit(0);
+  {
+    matrix_t const mat{30, 30, 1.};
+  }
+  EXPECT_EQ(tinyTools::poolCachedBytes(), 0);
+  tinyTools::setPoolCacheLimit(limit);
+}
+
+#endif /* ALLOCATORS_TEST_HPP */
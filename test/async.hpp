@@ -0,0 +1,76 @@
+#ifndef ASYNC_TEST_HPP
+#define ASYNC_TEST_HPP
+
+#include <atomic>
+#include <coroutine>
+
+#include "../include/async.hpp"
+#include "common.hpp"
+
+// Minimal eager coroutine, enough to co_await a task from a test.
+struct await_probe
+{
+  struct promise_type
+  {
+    auto get_return_object() -> await_probe { return {}; }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+TEST_F(TestMatrix, Async_operations)
+{
+  tinyTools::matrix<int> const lhm{2, 3, {1, 2, 3, 4, 5, 6}};
+  tinyTools::matrix<int> const rhm{3, 2, {1, 0, 0, 1, 1, 1}};
+
+  auto const product = tinyTools::asyncMultiply(std::cref(lhm), std::cref(rhm));
+  compare2Matrixes(product.get(), lhm * rhm);
+  EXPECT_TRUE(product.ready());
+
+  // Tasks as arguments are dependencies.
+  auto const sums = tinyTools::asyncSum(product, tinyTools::Direction::COLUMNS);
+  auto const total = tinyTools::asyncSum(product);
+  compareMatrix(sums.get(), {14, 16});
+  EXPECT_EQ(total.get(), 30);
+
+  auto const expr = tinyTools::async(lhm + lhm * 2);
+  compareMatrix(expr.get(), {3, 6, 9, 12, 15, 18});
+
+  auto const generic = tinyTools::async([](auto const& mat, int scale) { return mat.max() * scale; }, product, 10);
+  EXPECT_EQ(generic.get(), 110);
+
+  // Errors reach get() and every task depending on the failed one.
+  auto const failed = tinyTools::asyncMultiply(lhm, lhm);
+  auto const dependent = tinyTools::asyncSum(failed);
+  EXPECT_THROW(static_cast<void>(failed.get()), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(dependent.get()), std::invalid_argument);
+}
+
+TEST_F(TestMatrix, Async_graph)
+{
+  tinyTools::thread_pool pool{2};
+  EXPECT_EQ(pool.size(), 2);
+
+  // Diamond: two branches on the same source, joined at the end.
+  std::atomic<int> order{};
+  auto const source = tinyTools::async(pool, [&order] { return ++order; });
+  auto const left = tinyTools::async(pool, [&order](int value) { ++order; return value * 2; }, source);
+  auto const right = tinyTools::async(pool, [&order](int value) { ++order; return value * 3; }, source);
+  auto const join = tinyTools::async(pool, [&order](int lhs, int rhs) { return std::pair{lhs + rhs, ++order}; }, left, right);
+  EXPECT_EQ(join.get().first, 5);
+  EXPECT_EQ(join.get().second, 4); // After both branches.
+
+  std::atomic<int> awaited{};
+  auto const value = tinyTools::async(pool, [] { return 21; });
+  [](tinyTools::task<int> t, std::atomic<int>& out) -> await_probe { out = co_await t * 2; }(value, awaited);
+  value.wait();
+  for(int spin{}; awaited.load() == 0 && spin < 1000000; ++spin)
+  {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(awaited.load(), 42);
+}
+
+#endif /* ASYNC_TEST_HPP */
@@ -0,0 +1,107 @@
+#ifndef BATCH_TEST_HPP
+#define BATCH_TEST_HPP
+
+#include "../include/matrix_batch.hpp"
+#include "common.hpp"
+
+// Batch b of count matrices rows x cols, element (b, r, c) = b + 10 r + 100 c.
+template <typename T> auto makeBatch(std::size_t count, std::size_t rows, std::size_t cols, tinyTools::BatchLayout layout)
+{
+  tinyTools::matrix_batch<T> ret{count, rows, cols, layout};
+  for(std::size_t b{}; b < count; ++b)
+  {
+    for(std::size_t r{}; r < rows; ++r)
+    {
+      for(std::size_t c{}; c < cols; ++c)
+      {
+        ret(b, r, c) = static_cast<T>(b + 10 * r + 100 * c);
+      }
+    }
+  }
+  return ret;
+}
+
+TEST_F(TestMatrix, Batch_storage)
+{
+  using tinyTools::BatchLayout;
+  auto const interleaved = makeBatch<int>(3, 2, 2, BatchLayout::INTERLEAVED);
+  auto const strided = makeBatch<int>(3, 2, 2, BatchLayout::STRIDED);
+  compareVectors(std::vector<int>{interleaved.data().begin(), interleaved.data().end()}, {0, 1, 2, 100, 101, 102, 10, 11, 12, 110, 111, 112});
+  compareVectors(std::vector<int>{strided.data().begin(), strided.data().end()}, {0, 100, 10, 110, 1, 101, 11, 111, 2, 102, 12, 112});
+  EXPECT_TRUE(interleaved == strided);
+  EXPECT_EQ(interleaved.convert(BatchLayout::STRIDED).data(), strided.data());
+  EXPECT_EQ(strided.convert(BatchLayout::INTERLEAVED).data(), interleaved.data());
+
+  compareMatrix(interleaved.get(1), {1, 101, 11, 111});
+  compareMatrix(strided.get(2), {2, 102, 12, 112});
+  auto copy = interleaved;
+  copy.set(0, tinyTools::matrix<int>{2, 2, {5, 6, 7, 8}});
+  compareMatrix(copy.get(0), {5, 6, 7, 8});
+  EXPECT_TRUE(copy != interleaved);
+
+  std::vector<tinyTools::matrix<int>> const matrices{tinyTools::matrix<int>{1, 2, {1, 2}}, tinyTools::matrix<int>{1, 2, {3, 4}}};
+  tinyTools::matrix_batch<int> const gathered{matrices};
+  compareVectors(std::vector<int>{gathered.data().begin(), gathered.data().end()}, {1, 3, 2, 4});
+
+  EXPECT_THROW(static_cast<void>(interleaved(3, 0, 0)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(interleaved(0, 2, 0)), std::out_of_range);
+  EXPECT_THROW(copy.set(0, tinyTools::matrix<int>{2, 3, 0}), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(tinyTools::matrix_batch<int>(0, 2, 2)), std::length_error);
+}
+
+TEST_F(TestMatrix, Batch_operations)
+{
+  using tinyTools::BatchLayout;
+  for(auto const layout : {BatchLayout::INTERLEAVED, BatchLayout::STRIDED})
+  {
+    // Odd count and shapes, so the interleaved blocks have a tail.
+    constexpr std::size_t count{37};
+    auto const lhs = makeBatch<double>(count, 3, 4, layout);
+    auto const rhs = makeBatch<double>(count, 4, 2, layout);
+    auto const product = lhs * rhs;
+    auto const transposed = lhs.transpose();
+    auto const columns = lhs.sum(tinyTools::Direction::COLUMNS);
+    auto const rowSums = lhs.sum(tinyTools::Direction::ROWS);
+    auto const totals = lhs.sum();
+    auto const scaled = 2. * lhs - lhs + 1.;
+    EXPECT_EQ(product.layout(), layout);
+    EXPECT_EQ(product.rows(), 3);
+    EXPECT_EQ(product.cols(), 2);
+    for(std::size_t b{}; b < count; ++b)
+    {
+      auto const mat = lhs.get(b);
+      compare2Matrixes(product.get(b), mat * rhs.get(b));
+      compare2Matrixes(transposed.get(b), tinyTools::matrix<double>{mat.t()});
+      compare2Matrixes(columns.get(b), mat.sum(tinyTools::Direction::COLUMNS));
+      compare2Matrixes(rowSums.get(b), mat.sum(tinyTools::Direction::ROWS));
+      EXPECT_EQ(totals[ b ], mat.sum());
+      compare2Matrixes(scaled.get(b), tinyTools::matrix<double>{mat + 1.});
+    }
+
+    // Mixed layouts convert the right hand side.
+    auto const other = layout == BatchLayout::INTERLEAVED ? BatchLayout::STRIDED : BatchLayout::INTERLEAVED;
+    EXPECT_TRUE(lhs * rhs.convert(other) == product);
+    auto squared = lhs;
+    squared.multiply(lhs.convert(other));
+    EXPECT_EQ(squared(5, 2, 3), lhs(5, 2, 3) * lhs(5, 2, 3));
+
+    auto const identity = tinyTools::matrix_batch<double>::identity(count, 3, layout);
+    EXPECT_TRUE(identity * lhs == lhs);
+    EXPECT_THROW(static_cast<void>(lhs * lhs), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(lhs + rhs), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(lhs.sum(tinyTools::Direction::NONE)), std::invalid_argument);
+  }
+}
+
+// Enough matrices for several blocks and parallel chunks.
+TEST_F(TestMatrix, Batch_large)
+{
+  constexpr std::size_t count{5000};
+  auto const lhs = makeBatch<int>(count, 4, 4, tinyTools::BatchLayout::INTERLEAVED);
+  auto const product = lhs * lhs;
+  auto const reference = lhs.convert(tinyTools::BatchLayout::STRIDED) * lhs.convert(tinyTools::BatchLayout::STRIDED);
+  EXPECT_TRUE(product == reference);
+  EXPECT_TRUE(lhs.transpose().transpose() == lhs);
+}
+
+#endif /* BATCH_TEST_HPP */
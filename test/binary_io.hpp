@@ -0,0 +1,95 @@
+#ifndef BINARY_IO_TEST_HPP
+#define BINARY_IO_TEST_HPP
+
+#include <filesystem>
+#include <fstream>
+
+#include "../include/binary_io.hpp"
+#include "common.hpp"
+
+// Temporary file removed at the end of the scope.
+struct temp_file
+{
+  std::filesystem::path path{};
+
+  explicit temp_file(std::string const& name) : path{std::filesystem::temp_directory_path() / ("tinyTools_" + std::to_string(::getpid()) + "_" + name)} {}
+  temp_file(temp_file const&) = delete;
+  auto operator=(temp_file const&) -> temp_file& = delete;
+  ~temp_file() { std::filesystem::remove(path); }
+};
+
+TEST_F(TestMatrix, Binary_round_trip)
+{
+  temp_file const file{"round_trip.ttm"};
+  tinyTools::matrix<double> const mat{3, 4, {1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11., 12.}};
+  tinyTools::writeBinary(file.path, mat);
+
+  auto const read = tinyTools::readBinary<double>(file.path);
+  EXPECT_TRUE(read == mat);
+
+  // Strided views are written row by row.
+  tinyTools::writeBinary(file.path, mat.t());
+  EXPECT_TRUE(tinyTools::readBinary<double>(file.path) == mat.transpose());
+
+  tinyTools::matrix<std::int16_t> const small{1, 3, {-1, 2, -3}};
+  tinyTools::writeBinary(file.path, small);
+  EXPECT_TRUE(tinyTools::readBinary<std::int16_t>(file.path) == small);
+}
+
+TEST_F(TestMatrix, Binary_mapped_view)
+{
+  temp_file const file{"mapped.ttm"};
+  tinyTools::matrix<float> const mat{4, 5, 2.5F};
+  tinyTools::writeBinary(file.path, mat, 4096);
+
+  tinyTools::mapped_matrix<float> mapped{file.path};
+  EXPECT_EQ(mapped.rows(), 4);
+  EXPECT_EQ(mapped.cols(), 5);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.view().ptr()) % 4096, 0);
+  EXPECT_EQ(std::filesystem::file_size(file.path), 4096 + mat.totalSize() * sizeof(float));
+
+  // The view reads the mapping in place and works with the rest of the API.
+  EXPECT_FLOAT_EQ(mapped.view().sum(), 50.F);
+  EXPECT_TRUE(mapped.toMatrix() == mat);
+  compareMatrix(mat * mapped.view().t(), tinyTools::matrix<float>{4, 4, 31.25F}.data());
+
+  auto moved = std::move(mapped);
+  EXPECT_EQ(moved.totalSize(), 20);
+  EXPECT_EQ(mapped.totalSize(), 0);
+}
+
+TEST_F(TestMatrix, Binary_endianness)
+{
+  temp_file const file{"foreign.ttm"};
+  auto constexpr foreign = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+  tinyTools::matrix<std::int32_t> const mat{2, 2, {1, -2, 300, 70000}};
+  tinyTools::writeBinary(file.path, mat, 64, foreign);
+
+  // The copying reader converts, the mapping refuses.
+  EXPECT_TRUE(tinyTools::readBinary<std::int32_t>(file.path) == mat);
+  EXPECT_THROW(tinyTools::mapped_matrix<std::int32_t>{file.path}, std::invalid_argument);
+}
+
+TEST_F(TestMatrix, Binary_errors)
+{
+  temp_file const file{"errors.ttm"};
+  tinyTools::writeBinary(file.path, tinyTools::matrix<float>{2, 2, 1.F});
+
+  EXPECT_THROW((void)tinyTools::readBinary<double>(file.path), std::invalid_argument);
+  EXPECT_THROW(tinyTools::mapped_matrix<int>{file.path}, std::invalid_argument);
+  EXPECT_THROW(tinyTools::writeBinary(file.path, tinyTools::matrix<float>{2, 2, 1.F}, 3), std::invalid_argument);
+
+  // Truncated data.
+  std::filesystem::resize_file(file.path, 64 + 8);
+  EXPECT_THROW(tinyTools::mapped_matrix<float>{file.path}, std::invalid_argument);
+
+  {
+    std::ofstream garbage{file.path, std::ios::trunc};
+    garbage << "not a matrix";
+  }
+  EXPECT_THROW((void)tinyTools::readBinary<float>(file.path), std::invalid_argument);
+  EXPECT_THROW(tinyTools::mapped_matrix<float>{file.path}, std::invalid_argument);
+  EXPECT_THROW(tinyTools::mapped_matrix<float>{file.path.string() + ".missing"}, std::system_error);
+}
+
+#endif // BINARY_IO_TEST_HPP
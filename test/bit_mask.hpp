@@ -0,0 +1,120 @@
+#ifndef BIT_MASK_TEST_HPP
+#define BIT_MASK_TEST_HPP
+
+#include "common.hpp"
+
+TEST_F(TestMatrix, Mask_compare)
+{
+  tinyTools::matrix<int> const mat{2, 3, {1, 5, 3, 4, 2, 6}};
+  tinyTools::matrix<int> const mat2{2, 3, {2, 5, 1, 4, 3, 0}};
+
+  auto const less = mat.lt(mat2);
+  EXPECT_EQ(less.rows(), 2);
+  EXPECT_EQ(less.cols(), 3);
+  compareMatrix(less.toMatrix(), {true, false, false, false, true, false});
+  EXPECT_TRUE(less.toMatrix() == (mat < mat2));
+  EXPECT_TRUE(mat.ge(mat2).toMatrix() == (mat >= mat2));
+  compareMatrix(mat.eq(mat2).toMatrix(), {false, true, false, true, false, false});
+  compareMatrix(mat.ne(4).toMatrix(), {true, true, true, false, true, true});
+  compareMatrix(mat.gt(3).toMatrix(), {false, true, false, true, false, true});
+  EXPECT_EQ(mat.le(3).count(), 3);
+
+  EXPECT_THROW((void)mat.lt(tinyTools::matrix<int>{3, 2, 0}), std::invalid_argument);
+}
+
+TEST_F(TestMatrix, Mask_compare_simd)
+{
+  // Full words plus a ragged tail, every ISA must produce the same words as the scalar comparison.
+  std::size_t const rows{13};
+  std::size_t const cols{29};
+  auto randomData = []()
+  {
+    std::vector<float> data(rows * cols);
+    std::generate(data.begin(), data.end(), []() { return static_cast<float>(std::rand() % 100); });
+    return data;
+  };
+  tinyTools::matrix<float> const matA{rows, cols, randomData()};
+  tinyTools::matrix<float> const matB{rows, cols, randomData()};
+
+  using Isa = tinyTools::detail::simd::Isa;
+  for(auto const isa : {Isa::GENERIC, Isa::SSE2, Isa::AVX2, Isa::AVX512})
+  {
+    tinyTools::detail::simd::setIsaLimit(isa);
+    auto const mask = matA.lt(matB);
+    auto const scalarMask = matA.ge(50.F);
+    for(std::size_t i{}; i < rows * cols; ++i)
+    {
+      EXPECT_EQ(mask[ i ], matA[ i ] < matB[ i ]);
+      EXPECT_EQ(scalarMask[ i ], matA[ i ] >= 50.F);
+    }
+    EXPECT_EQ(mask.words().back() >> (rows * cols % 64), 0);
+  }
+  tinyTools::detail::simd::setIsaLimit(Isa::AVX512);
+}
+
+TEST_F(TestMatrix, Mask_logical)
+{
+  tinyTools::bit_mask lhm{3, 50};
+  tinyTools::bit_mask rhm{3, 50, true};
+  EXPECT_TRUE(lhm.none());
+  EXPECT_TRUE(rhm.all());
+  EXPECT_EQ(rhm.count(), 150);
+
+  lhm.set(0, 1);
+  lhm.set(2, 49);
+  lhm.set(1, 20);
+  EXPECT_EQ(lhm.count(), 3);
+  EXPECT_TRUE(lhm.any());
+  EXPECT_FALSE(lhm.all());
+  EXPECT_TRUE(lhm(2, 49));
+  EXPECT_THROW(lhm.set(3, 0), std::out_of_range);
+
+  EXPECT_EQ((lhm & rhm), lhm);
+  EXPECT_EQ((lhm | rhm), rhm);
+  EXPECT_EQ((lhm ^ rhm).count(), 147);
+  EXPECT_EQ((~lhm).count(), 147);
+  EXPECT_EQ(~~lhm, lhm);
+  EXPECT_TRUE((~rhm).none());
+  EXPECT_THROW((lhm &= tinyTools::bit_mask{2, 50}), std::invalid_argument);
+
+  auto const found = lhm.find();
+  ASSERT_EQ(found.size(), 3);
+  EXPECT_EQ(found[ 0 ], 1);
+  EXPECT_EQ(found[ 1 ], 70);
+  EXPECT_EQ(found[ 2 ], 149);
+  EXPECT_EQ(lhm.findNext(2), 70);
+  EXPECT_EQ(lhm.findNext(150), 150);
+
+  tinyTools::matrix<bool> const flags{1, 3, {true, false, true}};
+  EXPECT_TRUE(tinyTools::bit_mask{flags}.toMatrix() == flags);
+}
+
+TEST_F(TestMatrix, Mask_select_assign)
+{
+  std::vector<int> data(200);
+  std::iota(data.begin(), data.end(), 0);
+  tinyTools::matrix<int> mat{10, 20, std::move(data)};
+
+  // Full words (a run of 64) and single bits.
+  auto const mask = mat.lt(70) & mat.ne(3);
+  auto const selected = mat.select(mask);
+  EXPECT_EQ(selected.rows(), 69);
+  EXPECT_EQ(selected.cols(), 1);
+  EXPECT_EQ(selected(2, 0), 2);
+  EXPECT_EQ(selected(3, 0), 4);
+  EXPECT_EQ(selected(68, 0), 69);
+
+  mat.assign(mat.ge(190), -1);
+  EXPECT_EQ(mat.ge(0).count(), 190);
+  EXPECT_EQ(mat(9, 10), -1);
+
+  tinyTools::matrix<int> const zeros{10, 20, 0};
+  mat.assign(mask, zeros);
+  EXPECT_EQ(mat.eq(0).count(), 69);
+  EXPECT_EQ(mat(0, 3), 3);
+
+  EXPECT_THROW((void)mat.select(tinyTools::bit_mask{2, 2}), std::invalid_argument);
+  EXPECT_THROW((void)mat.select(tinyTools::bit_mask{10, 20}), std::length_error);
+}
+
+#endif /* BIT_MASK_TEST_HPP */
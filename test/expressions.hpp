@@ -0,0 +1,84 @@
+#ifndef EXPRESSIONS_TEST_HPP
+#define EXPRESSIONS_TEST_HPP
+
+#include "common.hpp"
+TEST_F(TestMatrix, Expr_fused_chain)
+{
+  tinyTools::matrix<int> const matA{2, 2, {1, 2, 3, 4}};
+  tinyTools::matrix<int> const matB{2, 2, {5, 6, 7, 8}};
+  tinyTools::matrix<int> const matC{2, 2, {1, 1, 2, 2}};
+
+  // Nothing is evaluated until the assignment.
+  auto const expr = matA + matB - matC * 2;
+  EXPECT_EQ(expr.rows(), 2);
+  EXPECT_EQ(expr.cols(), 2);
+
+  tinyTools::matrix<int> const result = expr;
+  compareMatrix(result, {4, 6, 6, 8});
+}
+
+TEST_F(TestMatrix, Expr_scalar)
+{
+  tinyTools::matrix<int> const mat{1, 3, {1, 2, 3}};
+
+  compareMatrix(tinyTools::eval(mat + 1), {2, 3, 4});
+  compareMatrix(tinyTools::eval(10 - mat), {9, 8, 7});
+  compareMatrix(tinyTools::eval(2 * mat - 1), {1, 3, 5});
+}
+
+TEST_F(TestMatrix, Expr_multiply)
+{
+  tinyTools::matrix<int> const matA{2, 2, {1, 2, 3, 4}};
+  tinyTools::matrix<int> const matB{2, 2, {5, 6, 7, 8}};
+
+  tinyTools::matrix<int> const result = tinyTools::multiply(matA + 1, matB) - matA;
+  compareMatrix(result, {9, 16, 25, 36});
+}
+
+TEST_F(TestMatrix, Expr_rvalue_operands)
+{
+  tinyTools::matrix<int> const matA{2, 2, {1, 2, 3, 4}};
+
+  // Temporaries are moved into the expression, so it can outlive them.
+  auto const expr = tinyTools::matrix<int>::ones(2) + tinyTools::matrix<int>{2, 2, 3};
+  tinyTools::matrix<int> const result = expr + matA;
+  compareMatrix(result, {5, 6, 7, 8});
+}
+
+TEST_F(TestMatrix, Expr_views_and_assign)
+{
+  tinyTools::matrix<int> mat{3, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8}};
+  tinyTools::matrix<int> acc{2, 2, 1};
+
+  // Non-contiguous operands (a column block) and compound assignment.
+  acc += mat(0, 0, 2, 2) + mat(1, 1, 2, 2);
+  compareMatrix(acc, {5, 7, 11, 13});
+
+  acc = acc - 1;
+  compareMatrix(acc, {4, 6, 10, 12});
+
+  // The expression reads the destination itself.
+  acc -= acc * 2;
+  compareMatrix(acc, {-4, -6, -10, -12});
+
+  EXPECT_ANY_THROW(static_cast<void>(acc + mat));
+}
+
+TEST_F(TestMatrix, Expr_matrix_product)
+{
+  tinyTools::matrix<int> const matA{2, 2, {1, 2, 3, 4}};
+  tinyTools::matrix<int> const iden = tinyTools::matrix<int>::identity(2);
+
+  compareMatrix((matA + iden) * matA, {8, 12, 18, 26});
+  compareMatrix(matA * (iden * 2), {2, 4, 6, 8});
+
+  // The evaluated expression takes the allocator and layout of the matrix operand.
+  using col_major = tinyTools::matrix<int, std::allocator<int>, tinyTools::Layout::COL_MAJOR>;
+  col_major const colA{matA.view()};
+  compareMatrix(tinyTools::matrix<int>{((matA + iden) * colA).view()}, {8, 12, 18, 26});
+  compareMatrix(tinyTools::matrix<int>{(colA * (iden * 2)).view()}, {2, 4, 6, 8});
+  tinyTools::matrix<int, tinyTools::aligned_allocator<int>> const alignedA{2, 2, {1, 2, 3, 4}};
+  EXPECT_TRUE(std::ranges::equal(((matA + iden) * alignedA).data(), std::vector<int>{8, 12, 18, 26}));
+}
+
+#endif /* EXPRESSIONS_TEST_HPP */
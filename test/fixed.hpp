@@ -0,0 +1,57 @@
+#ifndef FIXED_TEST_HPP
+#define FIXED_TEST_HPP
+
+#include "../include/fixed_matrix.hpp"
+#include "common.hpp"
+
+template <typename L, typename R>
+concept fixedMultipliable = requires(L const &lhm, R const &rhm) { lhm * rhm; };
+
+TEST_F(TestMatrix, Fixed_constexpr)
+{
+  constexpr tinyTools::matrix2<int> matA{1, 2, 3, 4};
+  constexpr auto iden = tinyTools::matrix2<int>::identity();
+
+  static_assert(matA * iden == matA);
+  static_assert((matA + 1) * 2 == tinyTools::matrix2<int>{4, 6, 8, 10});
+  static_assert(matA.get<1, 0>() == 3);
+  static_assert(sizeof(tinyTools::matrix4<float>) == 16 * sizeof(float));
+
+  constexpr tinyTools::fixed_matrix<int, 2, 3> matB{1, 2, 3, 4, 5, 6};
+  constexpr tinyTools::fixed_matrix<int, 3, 2> matC{7, 8, 9, 10, 11, 12};
+  static_assert(matB * matC == tinyTools::matrix2<int>{58, 64, 139, 154});
+
+  static_assert(fixedMultipliable<tinyTools::fixed_matrix<int, 2, 3>, tinyTools::fixed_matrix<int, 3, 2>>);
+  static_assert(!fixedMultipliable<tinyTools::fixed_matrix<int, 2, 3>, tinyTools::fixed_matrix<int, 2, 3>>);
+}
+
+TEST_F(TestMatrix, Fixed_methods)
+{
+  tinyTools::matrix3<double> mat{};
+  mat(1, 2) = 4.5;
+  EXPECT_EQ(mat[ 5 ], 4.5);
+  EXPECT_ANY_THROW(mat(3, 0));
+
+  auto ones = tinyTools::matrix3<double>::ones();
+  ones.multiply(tinyTools::matrix3<double>{2.0});
+  ones -= 1.0;
+  EXPECT_EQ(ones, tinyTools::matrix3<double>::ones());
+}
+
+TEST_F(TestMatrix, Fixed_interop)
+{
+  tinyTools::matrix2<int> const fixed{1, 2, 3, 4};
+
+  tinyTools::matrix<int> const dynamic = fixed.toMatrix();
+  compareMatrix(dynamic, {1, 2, 3, 4});
+  EXPECT_EQ(tinyTools::matrix2<int>{dynamic}, fixed);
+  EXPECT_ANY_THROW(tinyTools::matrix3<int>{dynamic});
+
+  compareMatrix(fixed * tinyTools::matrix<int>::identity(2), {1, 2, 3, 4});
+
+  // Views let fixed matrixes join dynamic expressions.
+  tinyTools::matrix<int> const sum = dynamic + fixed.view();
+  compareMatrix(sum, {2, 4, 6, 8});
+}
+
+#endif /* FIXED_TEST_HPP */
@@ -1,6 +1,9 @@
 #ifndef GETTERS_TEST_HPP
 #define GETTERS_TEST_HPP
 
+#include <algorithm>
+#include <numeric>
+
 #include "common.hpp"
 TEST_F(TestMatrix, Get_Data)
 {
@@ -10,6 +13,30 @@ TEST_F(TestMatrix, Get_Data)
   compareVectors(data, priv_data);
 }
 
+TEST_F(TestMatrix, Get_Data_no_copy)
+{
+  tinyTools::matrix<int> mat{2, 3, {1, 2, 3, 4, 5, 6}};
+  EXPECT_EQ(mat.data().data(), mat.ptr());
+  EXPECT_EQ(mat.span().data(), mat.ptr());
+  EXPECT_EQ(mat.span().size(), mat.totalSize());
+  EXPECT_EQ(mat.ld(), 3);
+  EXPECT_EQ(mat.ptr()[1 * mat.ld() + 2], 6);
+
+  for(auto &v : mat.span())
+  {
+    v *= 2;
+  }
+  EXPECT_TRUE(std::ranges::equal(mat, std::vector<int>{2, 4, 6, 8, 10, 12}));
+
+  std::fill(mat.begin(), mat.end(), 7);
+  tinyTools::matrix<int> const &cmat = mat;
+  EXPECT_TRUE(std::ranges::all_of(cmat.span(), [](int v) { return v == 7; }));
+  EXPECT_EQ(std::accumulate(cmat.begin(), cmat.end(), 0), 42);
+
+  tinyTools::matrix<bool> const flags{1, 3, true};
+  EXPECT_EQ(std::count(flags.begin(), flags.end(), true), 3);
+}
+
 TEST_F(TestMatrix, Get_Rows)
 {
   tinyTools::matrix<char> mat(1, 5, {'P', 'a', 'b', 'l', 'o'});
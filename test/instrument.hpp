@@ -0,0 +1,57 @@
+#ifndef INSTRUMENT_TEST_HPP
+#define INSTRUMENT_TEST_HPP
+
+#include <sstream>
+
+#include "common.hpp"
+
+TEST_F(TestMatrix, Instrument_counters)
+{
+  using tinyTools::Operation;
+  tinyTools::resetOperationStats();
+
+  tinyTools::matrix<int> const matA{4, 4, 1};
+  auto matB = matA;
+  auto const matC = matA * matB;
+  auto const sum = matA.sum(tinyTools::Direction::COLUMNS);
+  auto const both = tinyTools::cat(tinyTools::Direction::ROWS, matA, matB);
+  tinyTools::matrix<int> const block{matA(1, 1, 2, 2)};
+  matB += matA;
+
+  std::ostringstream os{};
+  tinyTools::dumpOperationStats(os);
+
+  if constexpr (tinyTools::instrumentEnabled)
+  {
+    auto const bytes = 16 * sizeof(int);
+    // Buffers built inside an operation are charged to it, its nested ctors still count as calls.
+    EXPECT_EQ(tinyTools::operationStats(Operation::CONSTRUCT).calls, 4);
+    EXPECT_EQ(tinyTools::operationStats(Operation::CONSTRUCT).bytesAllocated, bytes);
+
+    auto const copy = tinyTools::operationStats(Operation::COPY);
+    EXPECT_EQ(copy.calls, 1);
+    EXPECT_EQ(copy.bytesAllocated, bytes);
+    EXPECT_EQ(copy.bytesCopied, bytes);
+
+    EXPECT_EQ(tinyTools::operationStats(Operation::MULTIPLY).calls, 1);
+    EXPECT_EQ(tinyTools::operationStats(Operation::MULTIPLY).bytesAllocated, bytes);
+    EXPECT_EQ(tinyTools::operationStats(Operation::REDUCE).calls, 1);
+    EXPECT_EQ(tinyTools::operationStats(Operation::CAT).bytesCopied, 2 * bytes);
+    EXPECT_EQ(tinyTools::operationStats(Operation::SUBMATRIX).calls, 1);
+    EXPECT_EQ(tinyTools::operationStats(Operation::VIEW_COPY).bytesCopied, 4 * sizeof(int));
+    EXPECT_EQ(tinyTools::operationStats(Operation::ELEMENTWISE).calls, 1);
+    EXPECT_NE(os.str().find("multiply"), std::string::npos);
+
+    tinyTools::resetOperationStats();
+    EXPECT_EQ(tinyTools::operationStats(Operation::COPY).calls, 0);
+  }
+  else
+  {
+    EXPECT_EQ(tinyTools::operationStats(Operation::CONSTRUCT).calls, 0);
+    EXPECT_EQ(tinyTools::operationStats(Operation::COPY).bytesCopied, 0);
+    EXPECT_NE(os.str().find("disabled"), std::string::npos);
+  }
+  EXPECT_EQ(tinyTools::operationName(Operation::VIEW_COPY), "view copy");
+}
+
+#endif /* INSTRUMENT_TEST_HPP */
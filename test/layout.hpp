@@ -0,0 +1,90 @@
+#ifndef LAYOUT_TEST_HPP
+#define LAYOUT_TEST_HPP
+
+#include "common.hpp"
+
+template <typename T> using col_major = tinyTools::matrix<T, std::allocator<T>, tinyTools::Layout::COL_MAJOR>;
+
+TEST_F(TestMatrix, Layout_storage)
+{
+  // Matlab buffer of [1 3 5; 2 4 6], adopted as is.
+  col_major<int> const mat{2, 3, std::vector<int>{1, 2, 3, 4, 5, 6}};
+  EXPECT_EQ(mat(0, 1), 3);
+  EXPECT_EQ(mat(1, 0), 2);
+  EXPECT_EQ(mat[ 2 ], 3); // Linear indexing follows the storage, like Matlab.
+  EXPECT_EQ(mat.ld(), 2);
+  EXPECT_EQ(mat.view().rowStride(), 1);
+  EXPECT_EQ(mat.view().colStride(), 2);
+
+  tinyTools::matrix<int> const rowMajor{mat.view()};
+  compareMatrix(rowMajor, {1, 3, 5, 2, 4, 6});
+  col_major<int> const back{rowMajor.view()};
+  compareVectors(back.data(), mat.data());
+  compareVectors(col_major<int>{mat.t()}.data(), {1, 3, 5, 2, 4, 6});
+
+  // Wrapping foreign column-major storage without a copy.
+  std::vector<int> buffer{1, 2, 3, 4, 5, 6};
+  tinyTools::matrix_view<int> const wrapped{buffer.data(), 2, 3, tinyTools::Layout::COL_MAJOR};
+  EXPECT_TRUE(wrapped == mat.view());
+
+  auto const col = mat.getCol(2);
+  EXPECT_EQ(col.rowStride(), 1);
+  EXPECT_EQ(col(1, 0), 6);
+  EXPECT_EQ(mat.getRow(1)(0, 2), 6);
+  auto const block = mat(0, 1, 2, 2);
+  compareVectors(col_major<int>{block}.data(), {3, 4, 5, 6});
+  compareMatrix(tinyTools::matrix<int>{block}, {3, 5, 4, 6});
+
+  std::stringstream out{};
+  out << mat;
+  EXPECT_EQ(out.str(), "1 3 5\n2 4 6\n");
+}
+
+TEST_F(TestMatrix, Layout_kernels)
+{
+  tinyTools::matrix<float> const rowA{3, 2, {1.F, 2.F, 3.F, 4.F, 5.F, 6.F}};
+  tinyTools::matrix<float> const rowB{2, 3, {1.F, -1.F, 2.F, 0.F, 3.F, 1.F}};
+  col_major<float> const colA{rowA.view()};
+  col_major<float> const colB{rowB.view()};
+
+  auto const product = colA * colB;
+  compareMatrix(tinyTools::matrix<float>{product.view()}, (rowA * rowB).data());
+  compareMatrix(tinyTools::matrix<float>{(colA * rowB.view()).view()}, (rowA * rowB).data());
+
+  compareMatrix(tinyTools::matrix<float>{colA.sum(tinyTools::Direction::COLUMNS).view()}, {9.F, 12.F});
+  compareMatrix(tinyTools::matrix<float>{colA.sum(tinyTools::Direction::ROWS).view()}, {3.F, 7.F, 11.F});
+  EXPECT_EQ(colA.sum(), 21.F);
+  EXPECT_EQ(colA.max(), 6.F);
+
+  // Fused expressions write in the storage order of the result, mixed layouts read through the strides.
+  col_major<float> const expr = colA + rowA.view() * 2.F;
+  compareMatrix(tinyTools::matrix<float>{expr.view()}, {3.F, 6.F, 9.F, 12.F, 15.F, 18.F});
+  col_major<float> acc{colA};
+  acc += rowA.view();
+  acc -= colA;
+  compareVectors(acc.data(), colA.data());
+
+  compareMatrix(tinyTools::matrix<float>{colA.transpose().view()}, {1.F, 3.F, 5.F, 2.F, 4.F, 6.F});
+  col_major<float> inPlace{colA};
+  inPlace.transposeInPlace();
+  EXPECT_EQ(inPlace.rows(), 2);
+  EXPECT_EQ(inPlace(1, 2), 6.F);
+
+  auto const less = colA < col_major<float>{3, 2, 3.5F};
+  compareVectors(less.data(), {true, true, false, true, false, false});
+}
+
+TEST_F(TestMatrix, Layout_cat)
+{
+  col_major<int> const lhm{2, 2, {1, 3, 2, 4}};
+  col_major<int> const rhm{2, 1, {5, 6}};
+  auto const side = tinyTools::cat(tinyTools::Direction::COLUMNS, lhm, rhm);
+  compareMatrix(tinyTools::matrix<int>{side.view()}, {1, 2, 5, 3, 4, 6});
+
+  col_major<int> const bottom{1, 2, {7, 8}};
+  auto const stacked = tinyTools::cat(tinyTools::Direction::ROWS, lhm, bottom);
+  compareMatrix(tinyTools::matrix<int>{stacked.view()}, {1, 2, 3, 4, 7, 8});
+  compareVectors(stacked.data(), {1, 3, 7, 2, 4, 8});
+}
+
+#endif /* LAYOUT_TEST_HPP */
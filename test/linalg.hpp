@@ -0,0 +1,112 @@
+#ifndef LINALG_TEST_HPP
+#define LINALG_TEST_HPP
+
+#include "../include/linalg.hpp"
+#include "../include/random.hpp"
+#include "common.hpp"
+
+template <typename T> void compareNear(tinyTools::matrix<T> const& lhm, tinyTools::matrix<T> const& rhm, T tolerance)
+{
+  ASSERT_EQ(lhm.rows(), rhm.rows());
+  ASSERT_EQ(lhm.cols(), rhm.cols());
+  for(std::size_t i{}; i < lhm.totalSize(); ++i)
+  {
+    EXPECT_NEAR(lhm.data()[ i ], rhm.data()[ i ], tolerance);
+  }
+}
+
+TEST_F(TestMatrix, Linalg_lu)
+{
+  tinyTools::matrix<double> const mat{3, 3, {2., 1., 1., 4., -6., 0., -2., 7., 2.}};
+  auto const factors = tinyTools::lu(mat);
+  EXPECT_FALSE(factors.singular());
+  compareVectors(std::vector<std::size_t>{factors.pivots().begin(), factors.pivots().end()}, {1, 1, 2});
+  compareNear(factors.P() * mat, factors.L() * factors.U(), 1e-12);
+  EXPECT_NEAR(factors.det(), -16., 1e-12);
+  EXPECT_NEAR(tinyTools::det(mat), -16., 1e-12);
+
+  tinyTools::matrix<double> const rhs{3, 1, {5., -2., 9.}};
+  compareNear(tinyTools::solve(mat, rhs), tinyTools::matrix<double>{3, 1, {1., 1., 2.}}, 1e-12);
+  compareNear(mat * tinyTools::inv(mat), tinyTools::matrix<double>{3, 3, {1., 0., 0., 0., 1., 0., 0., 0., 1.}}, 1e-12);
+
+  tinyTools::matrix<double> const singular{2, 2, {1., 2., 2., 4.}};
+  EXPECT_TRUE(tinyTools::lu(singular).singular());
+  EXPECT_EQ(tinyTools::det(singular), 0.);
+  EXPECT_THROW(static_cast<void>(tinyTools::inv(singular)), std::domain_error);
+  EXPECT_THROW(static_cast<void>(tinyTools::lu(tinyTools::matrix<double>{2, 3, 1.})), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(tinyTools::solve(mat, tinyTools::matrix<double>{2, 1, 1.})), std::invalid_argument);
+}
+
+// Sizes across several panels, so the blocked updates run.
+TEST_F(TestMatrix, Linalg_lu_blocked)
+{
+  tinyTools::rng gen{21};
+  constexpr std::size_t n{203};
+  auto const mat = tinyTools::matrix<double>::randn(n, n, gen);
+  auto const rhs = tinyTools::matrix<double>::randn(n, 3, gen);
+  auto const factors = tinyTools::lu(mat);
+  compareNear(factors.P() * mat, factors.L() * factors.U(), 1e-10);
+  compareNear(mat * factors.solve(rhs), rhs, 1e-9);
+
+  auto const single = tinyTools::matrix<float>::randn(n, n, gen);
+  compareNear(single * tinyTools::inv(single), tinyTools::detail::identity<float, std::allocator<float>>(n, n), 1e-3F);
+}
+
+TEST_F(TestMatrix, Linalg_cholesky)
+{
+  tinyTools::matrix<double> const mat{3, 3, {4., 12., -16., 12., 37., -43., -16., -43., 98.}};
+  auto const factors = tinyTools::chol(mat);
+  compareNear(factors.L(), tinyTools::matrix<double>{3, 3, {2., 0., 0., 6., 1., 0., -8., 5., 3.}}, 1e-12);
+  EXPECT_NEAR(factors.det(), 36., 1e-9);
+
+  tinyTools::rng gen{7};
+  constexpr std::size_t n{150};
+  auto const base = tinyTools::matrix<double>::randn(n, n, gen);
+  tinyTools::matrix<double> spd = base * tinyTools::matrix<double>{base.t()};
+  for(std::size_t i{}; i < n; ++i)
+  {
+    spd(i, i) += static_cast<double>(n);
+  }
+  auto const blocked = tinyTools::chol(spd);
+  compareNear(blocked.L() * tinyTools::matrix<double>{blocked.L().t()}, spd, 1e-9);
+  auto const rhs = tinyTools::matrix<double>::randn(n, 2, gen);
+  compareNear(spd * blocked.solve(rhs), rhs, 1e-9);
+
+  EXPECT_THROW(static_cast<void>(tinyTools::chol(tinyTools::matrix<double>{2, 2, {1., 2., 2., 1.}})), std::domain_error);
+}
+
+TEST_F(TestMatrix, Linalg_qr)
+{
+  tinyTools::rng gen{3};
+  auto const tall = tinyTools::matrix<double>::randn(170, 90, gen);
+  auto const factors = tinyTools::qr(tall);
+  auto const q = factors.Q();
+  auto const r = factors.R();
+  EXPECT_EQ(q.rows(), 170);
+  EXPECT_EQ(q.cols(), 90);
+  compareNear(q * r, tall, 1e-10);
+  compareNear(tinyTools::matrix<double>{q.t()} * q, tinyTools::detail::identity<double, std::allocator<double>>(90, 90), 1e-12);
+  for(std::size_t row{1}; row < r.rows(); ++row)
+  {
+    for(std::size_t col{}; col < row; ++col)
+    {
+      EXPECT_EQ(r(row, col), 0.);
+    }
+  }
+
+  // Least squares: the residual is orthogonal to the columns.
+  auto const rhs = tinyTools::matrix<double>::randn(170, 1, gen);
+  auto const x = tinyTools::solve(tall, rhs);
+  EXPECT_EQ(x.rows(), 90);
+  auto const residual = tinyTools::matrix<double>{rhs - tall * x};
+  for(auto const value : tinyTools::matrix<double>{tall.t()} * residual)
+  {
+    EXPECT_NEAR(value, 0., 1e-10);
+  }
+
+  // Minimum norm: exact solution in the row space.
+  tinyTools::matrix<double> const wide{1, 2, {1., 1.}};
+  compareNear(tinyTools::solve(wide, tinyTools::matrix<double>{1, 1, 2.}), tinyTools::matrix<double>{2, 1, {1., 1.}}, 1e-12);
+}
+
+#endif /* LINALG_TEST_HPP */
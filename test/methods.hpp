@@ -83,6 +83,35 @@ TEST_F(TestMatrix, Method_random)
   std::srand(static_cast<unsigned int>(std::time(nullptr))); // Disable seed.
 }
 
+TEST_F(TestMatrix, Method_cat)
+{
+  tinyTools::matrix<int> const matA{2, 2, {1, 2, 3, 4}};
+  tinyTools::matrix<int> const matB{1, 2, {5, 6}};
+  tinyTools::matrix<int> const matC{2, 1, {7, 8}};
+
+  auto const rows = tinyTools::cat(tinyTools::Direction::ROWS, matA, matB);
+  EXPECT_EQ(rows.rows(), 3);
+  EXPECT_EQ(rows.cols(), 2);
+  compareMatrix(rows, {1, 2, 3, 4, 5, 6});
+
+  auto const cols = tinyTools::cat(tinyTools::Direction::COLUMNS, matA, matC, matA);
+  EXPECT_EQ(cols.rows(), 2);
+  EXPECT_EQ(cols.cols(), 5);
+  compareMatrix(cols, {1, 2, 7, 1, 2, 3, 4, 8, 3, 4});
+
+  std::vector<tinyTools::matrix<int>> const blocks{matB, matB, matB, matB};
+  compareMatrix(tinyTools::cat(tinyTools::Direction::ROWS, blocks), {5, 6, 5, 6, 5, 6, 5, 6});
+  compareMatrix(tinyTools::cat(tinyTools::Direction::COLUMNS, std::span{blocks}.subspan(1)), {5, 6, 5, 6, 5, 6});
+
+  tinyTools::matrix<bool> const flags{1, 2, {true, false}};
+  compareMatrix(tinyTools::cat(tinyTools::Direction::COLUMNS, flags, flags), {true, false, true, false});
+
+  EXPECT_THROW(static_cast<void>(tinyTools::cat(tinyTools::Direction::ROWS, matA, matC)), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(tinyTools::cat(tinyTools::Direction::COLUMNS, matA, matB)), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(tinyTools::cat(tinyTools::Direction::NONE, matA, matA)), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(tinyTools::cat(tinyTools::Direction::ROWS, std::vector<tinyTools::matrix<int>>{})), std::length_error);
+}
+
 TEST_F(TestMatrix, Method_multiply_inplace)
 {
   auto matA = tinyTools::matrix<int>{2, 2, {1, 2, 3, 4}};
@@ -101,7 +130,7 @@ TEST_F(TestMatrix, Method_multiply)
 
   auto const resolve = tinyTools::matrix<int>{2, 2, {5, 12, 21, 32}};
 
-  auto const matC = tinyTools::multiply(matA, matB);
+  tinyTools::matrix<int> const matC = tinyTools::multiply(matA, matB);
   compare2Matrixes(matC, resolve);
 }
 
@@ -116,4 +145,31 @@ TEST_F(TestMatrix, Method_sum)
   compareMatrix(sumR, {3, 7});
 }
 
+TEST_F(TestMatrix, Method_parallel_execution)
+{
+  auto const matA = tinyTools::matrix<int>::random(257, 131, 1000);
+  auto const matB = tinyTools::matrix<int>::random(257, 131, 1000);
+
+  auto run = [&]()
+  {
+    tinyTools::matrix<int> add = matA + matB;
+    add -= 3;
+    add.multiply(matB);
+    return std::tuple{add, add.sum(tinyTools::matrix<int>::Direction::COLUMNS), add.sum(tinyTools::matrix<int>::Direction::ROWS), (matA < matB)};
+  };
+
+  auto const [seq, seqC, seqR, seqLess] = run();
+
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  auto const [par, parC, parR, parLess] = run();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+
+  compare2Matrixes(seq, par);
+  compare2Matrixes(seqC, parC);
+  compare2Matrixes(seqR, parR);
+  compare2Matrixes(seqLess, parLess);
+}
+
 #endif /* METHODS_TEST_HPP */
@@ -30,6 +30,33 @@ TEST_F(TestMatrix, Op_squareBracket)
   EXPECT_EQ(mat[ 0 ], value);
 }
 
+TEST_F(TestMatrix, Op_bounds_policy)
+{
+  tinyTools::matrix<int> mat{2, 3, {0, 1, 2, 3, 4, 5}};
+  EXPECT_EQ(mat.unchecked(1, 2), 5);
+  EXPECT_EQ(mat.unchecked(4), 4);
+  mat.unchecked(0, 1) = 7;
+  EXPECT_EQ(mat(0, 1), 7);
+
+  if constexpr (tinyTools::detail::checkPublicAccess)
+  {
+    EXPECT_THROW(static_cast<void>(mat(2, 0)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(mat(0, 3)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(mat[6]), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(mat.view()(2, 0)), std::out_of_range);
+  }
+  if constexpr (tinyTools::detail::checkInternalAccess)
+  {
+    EXPECT_THROW(static_cast<void>(mat.unchecked(2, 0)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(mat.unchecked(6)), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(mat.view().unchecked(0, 3)), std::out_of_range);
+  }
+  else
+  {
+    EXPECT_TRUE(noexcept(mat.unchecked(0, 0)));
+  }
+}
+
 TEST_F(TestMatrix, Op_equal)
 {
   float const value{4.5F};
@@ -116,6 +143,34 @@ TEST_F(TestMatrix, Op_minus_eq_mat)
   compareMatrix(mat, {0, 0});
 }
 
+// A view of the same buffer is read before anything is written.
+TEST_F(TestMatrix, Op_eq_aliased_view)
+{
+  tinyTools::matrix<int> mat{3, 3, {1, 2, 3, 4, 5, 6, 7, 8, 9}};
+  auto const original = mat;
+  mat += mat.t();
+  compareMatrix(mat, {2, 6, 10, 6, 10, 14, 10, 14, 18});
+  mat = original;
+  mat -= mat.t();
+  compareMatrix(mat, {0, -2, -4, 2, 0, -2, 4, 2, 0});
+  mat = original;
+  mat.multiply(mat.t());
+  compareMatrix(mat, {1, 8, 21, 8, 25, 48, 21, 48, 81});
+  mat = original;
+  mat += mat(0, 0, 3, 3);
+  compareMatrix(mat, {2, 4, 6, 8, 10, 12, 14, 16, 18});
+}
+
+// matrix<bool> is no expression operand, + and - stay eager.
+TEST_F(TestMatrix, Op_bool_mat)
+{
+  tinyTools::matrix<bool> const lhm{2, 2, {true, true, false, false}};
+  tinyTools::matrix<bool> const rhm{2, 2, {true, false, true, false}};
+  compareMatrix(lhm + rhm, {true, true, true, false});
+  compareMatrix(lhm - rhm, {false, true, true, false});
+  compareMatrix(rhm + false, {true, false, true, false});
+}
+
 TEST_F(TestMatrix, Op_minus_mat)
 {
   tinyTools::matrix<int> mat{1, 2, {0, 1}};
@@ -148,6 +203,114 @@ TEST_F(TestMatrix, Op_multiply)
   compare2Matrixes(matC, res);
 }
 
+TEST_F(TestMatrix, Op_multiply_rectangular)
+{
+  tinyTools::matrix<int> matA{2, 3, {1, 2, 3, 4, 5, 6}};
+  tinyTools::matrix<int> matB{3, 2, {7, 8, 9, 10, 11, 12}};
+
+  auto const matC = matA * matB;
+  EXPECT_EQ(matC.rows(), 2);
+  EXPECT_EQ(matC.cols(), 2);
+  compareMatrix(matC, {58, 64, 139, 154});
+
+  EXPECT_ANY_THROW(matA * matA);
+}
+
+TEST_F(TestMatrix, Op_multiply_blocked)
+{
+  // Crosses every blocking boundary (MR, NR, MC, KC) with ragged edges.
+  std::size_t const m{131};
+  std::size_t const k{263};
+  std::size_t const n{37};
+  auto const matA = tinyTools::matrix<int>::random(m, k, 100);
+  auto const matB = tinyTools::matrix<int>::random(k, n, 100);
+
+  std::vector<int> reference(m * n, 0);
+  for (std::size_t r{}; r < m; ++r)
+  {
+    for (std::size_t c{}; c < n; ++c)
+    {
+      for (std::size_t i{}; i < k; ++i)
+      {
+        reference[ r * n + c ] += matA(r, i) * matB(i, c);
+      }
+    }
+  }
+
+  compareMatrix(matA * matB, reference);
+}
+
+TEST_F(TestMatrix, Op_multiply_parallel)
+{
+  // Several MC row tiles and split column tiles, the parallel product must match the sequential one exactly.
+  auto const matA = tinyTools::matrix<int>::random(301, 190, 100);
+  auto const matB = tinyTools::matrix<int>::random(190, 77, 100);
+  auto const seq = matA * matB;
+  auto const seqT = matB.t() * matA.t();
+
+  EXPECT_GT(tinyTools::detail::gemm_tiles<int>(301, 77, 4).size(), 3);
+
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  for(std::size_t const threads : {0U, 1U, 2U, 3U})
+  {
+    tinyTools::setThreadCount(threads);
+    compare2Matrixes(matA * matB, seq);
+    compare2Matrixes(tinyTools::matrix<int>{matB.t() * matA.t()}, seqT);
+  }
+  tinyTools::setThreadCount(0);
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+}
+
+template <typename T> void checkSimdKernels()
+{
+  using Isa = tinyTools::detail::simd::Isa;
+  // Odd size so every ISA runs its vector body and a scalar tail.
+  auto randomData = []()
+  {
+    std::vector<T> data(37 * 29);
+    std::generate(data.begin(), data.end(), []() { return static_cast<T>(std::rand() % 100); });
+    return data;
+  };
+  auto const matA = tinyTools::matrix<T>{37, 29, randomData()};
+  auto const matB = tinyTools::matrix<T>{37, 29, randomData()};
+
+  auto run = [&]()
+  {
+    auto mat = matA;
+    mat += matB;
+    mat -= T{3};
+    mat.multiply(matB);
+    mat -= matA;
+    mat += T{1};
+    return std::tuple{mat, (mat < matB), (mat >= matA)};
+  };
+
+  tinyTools::detail::simd::setIsaLimit(Isa::GENERIC);
+  auto const [generic, genericLess, genericGreaterEq] = run();
+  for (auto const isa : {Isa::SSE2, Isa::AVX2, Isa::AVX512})
+  {
+    tinyTools::detail::simd::setIsaLimit(isa);
+    auto const [mat, less, greaterEq] = run();
+    compare2Matrixes(mat, generic);
+    compare2Matrixes(less, genericLess);
+    compare2Matrixes(greaterEq, genericGreaterEq);
+  }
+  tinyTools::detail::simd::setIsaLimit(Isa::AVX512);
+}
+
+TEST_F(TestMatrix, Op_simd_dispatch)
+{
+  checkSimdKernels<signed char>();
+  checkSimdKernels<unsigned char>();
+  checkSimdKernels<short>();
+  checkSimdKernels<int>();
+  checkSimdKernels<long long>();
+  checkSimdKernels<float>();
+  checkSimdKernels<double>();
+}
+
 TEST_F(TestMatrix, Op_parenthesis_submatrix)
 {
   tinyTools::matrix<int> const mat{ 5, 5,
@@ -165,7 +328,7 @@ TEST_F(TestMatrix, Op_parenthesis_submatrix)
   auto const subMat2 = mat(2, 2, 3, 3);
   compareVectors(subMat2.data(), {12, 13, 14, 17, 18, 19, 22, 23, 24});
 
-  EXPECT_ANY_THROW(mat(2, 3, 7, 8));
+  EXPECT_ANY_THROW(static_cast<void>(mat(2, 3, 7, 8)));
 }
 
 
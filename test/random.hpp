@@ -0,0 +1,115 @@
+#ifndef RANDOM_TEST_HPP
+#define RANDOM_TEST_HPP
+
+#include <cmath>
+#include <set>
+
+#include "common.hpp"
+
+TEST_F(TestMatrix, Random_philox_known_answers)
+{
+  // Philox4x32-10 known answers (Random123): counter {block, stream}, key = seed.
+  auto const zero = tinyTools::rng{0}.block(0);
+  EXPECT_EQ(zero, (std::array<std::uint32_t, 4>{0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}));
+
+  auto const ones = tinyTools::rng{~std::uint64_t{}, ~std::uint64_t{}}.block(~std::uint64_t{});
+  EXPECT_EQ(ones, (std::array<std::uint32_t, 4>{0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}));
+
+  auto const pi = tinyTools::rng{0x299f31d0a4093822ULL, 0x0370734413198a2eULL}.block(0x85a308d3243f6a88ULL);
+  EXPECT_EQ(pi, (std::array<std::uint32_t, 4>{0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U}));
+}
+
+TEST_F(TestMatrix, Random_reproducible)
+{
+  tinyTools::rng gen{2024};
+  auto const seq = tinyTools::matrix<float>::random(301, 257, -1.F, 1.F, gen);
+  EXPECT_EQ(gen.offset(), (301 * 257 + 3) / 4);
+
+  // Same values on any amount of threads and chunks.
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  for(std::size_t const threads : {1U, 2U, 3U})
+  {
+    tinyTools::setThreadCount(threads);
+    tinyTools::rng parGen{2024};
+    compare2Matrixes(tinyTools::matrix<float>::random(301, 257, -1.F, 1.F, parGen), seq);
+  }
+  tinyTools::setThreadCount(0);
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+
+  // Consecutive fills continue the sequence, seek jumps to any block, streams differ.
+  tinyTools::rng whole{7};
+  auto const both = tinyTools::matrix<int>::random(2, 8, 0, 1000, whole);
+  tinyTools::rng parts{7};
+  auto const first = tinyTools::matrix<int>::random(1, 8, 0, 1000, parts);
+  auto const second = tinyTools::matrix<int>::random(1, 8, 0, 1000, parts);
+  EXPECT_TRUE(tinyTools::matrix<int>{both.getRow(0)} == first);
+  EXPECT_TRUE(tinyTools::matrix<int>{both.getRow(1)} == second);
+  tinyTools::rng seeker{7};
+  seeker.seek(2);
+  EXPECT_TRUE(tinyTools::matrix<int>::random(1, 8, 0, 1000, seeker) == second);
+
+  tinyTools::rng other = tinyTools::rng{7}.split(1);
+  EXPECT_FALSE(tinyTools::matrix<int>::random(2, 8, 0, 1000, other) == both);
+}
+
+TEST_F(TestMatrix, Random_uniform_ranges)
+{
+  tinyTools::rng gen{1};
+  auto const small = tinyTools::matrix<std::int8_t>::random(100, 100, -3, 3, gen);
+  std::set<std::int8_t> seen(small.begin(), small.end());
+  EXPECT_EQ(seen.size(), 7);
+  EXPECT_EQ(*seen.begin(), -3);
+  EXPECT_EQ(*seen.rbegin(), 3);
+
+  auto const full = tinyTools::matrix<std::int64_t>::random(100, 100, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), gen);
+  EXPECT_LT(full.min(), std::numeric_limits<std::int64_t>::min() / 2);
+  EXPECT_GT(full.max(), std::numeric_limits<std::int64_t>::max() / 2);
+
+  auto const unit = tinyTools::matrix<double>::random(300, 300, 2., 5., gen);
+  EXPECT_GE(unit.min(), 2.);
+  EXPECT_LT(unit.max(), 5.);
+  EXPECT_NEAR(unit.mean(), 3.5, 0.01);
+
+  // hi stays excluded when lo + (hi - lo) * u would round up to it, and the full range does not overflow to inf.
+  auto const oneUlp = tinyTools::matrix<float>::random(100, 100, 1.F, std::nextafter(1.F, 2.F), gen);
+  EXPECT_EQ(oneUlp.max(), 1.F);
+  EXPECT_EQ(oneUlp.min(), 1.F);
+  auto const widest = tinyTools::matrix<float>::random(100, 100, std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max(), gen);
+  EXPECT_TRUE(std::isfinite(widest.min()) && std::isfinite(widest.max()));
+  EXPECT_LT(widest.max(), std::numeric_limits<float>::max());
+
+  // Portable 64 x 64 -> 128 high half.
+  EXPECT_EQ(tinyTools::detail::mulHi64(~std::uint64_t{}, ~std::uint64_t{}), ~std::uint64_t{} - 1);
+  EXPECT_EQ(tinyTools::detail::mulHi64(std::uint64_t{1} << 32U, std::uint64_t{1} << 32U), 1U);
+  EXPECT_EQ(tinyTools::detail::mulHi64(0x123456789abcdef0ULL, 0x0fedcba987654321ULL), 0x0121fa00ad77d742ULL);
+
+  EXPECT_THROW((void)tinyTools::matrix<int>::random(2, 2, 5, 1, gen), std::invalid_argument);
+
+  // Legacy generator, floating point values are scaled instead of taken modulo.
+  auto const legacy = tinyTools::matrix<float>::random(10, 10, 1.F);
+  EXPECT_GE(legacy.min(), 0.F);
+  EXPECT_LE(legacy.max(), 1.F);
+}
+
+TEST_F(TestMatrix, Random_normal)
+{
+  tinyTools::rng gen{99};
+  for(std::size_t const cols : {400U, 401U})
+  {
+    auto const values = tinyTools::matrix<double>::randn(500, cols, gen, 10., 2.);
+    auto const mean = values.mean();
+    auto const centered = values - tinyTools::matrix<double>{500, cols, mean};
+    tinyTools::matrix<double> squares{centered};
+    squares.multiply(centered);
+    EXPECT_NEAR(mean, 10., 0.02);
+    EXPECT_NEAR(std::sqrt(squares.mean()), 2., 0.02);
+    EXPECT_TRUE(std::isfinite(values.min()) && std::isfinite(values.max()));
+  }
+
+  auto const floats = tinyTools::matrix<float>::randn(300, 300, gen);
+  EXPECT_NEAR(floats.mean(), 0.F, 0.02F);
+}
+
+#endif /* RANDOM_TEST_HPP */
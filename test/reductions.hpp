@@ -0,0 +1,125 @@
+#ifndef REDUCTIONS_TEST_HPP
+#define REDUCTIONS_TEST_HPP
+
+#include "common.hpp"
+
+TEST_F(TestMatrix, Reduce_ops)
+{
+  tinyTools::matrix<int> const mat{2, 3, {1, -2, 3, 4, 5, 0}};
+  using tinyTools::Direction;
+
+  compareMatrix(mat.sum(Direction::COLUMNS), {5, 3, 3});
+  compareMatrix(mat.sum(Direction::ROWS), {2, 9});
+  compareMatrix(mat.prod(Direction::COLUMNS), {4, -10, 0});
+  compareMatrix(mat.prod(Direction::ROWS), {-6, 0});
+  compareMatrix(mat.min(Direction::COLUMNS), {1, -2, 0});
+  compareMatrix(mat.max(Direction::ROWS), {3, 5});
+  compareMatrix(mat.mean(Direction::COLUMNS), {2.5, 1.5, 1.5});
+  compareMatrix(mat.mean(Direction::ROWS), {2. / 3., 3.});
+  // Divided once, 5 * (1 / 3.) would round twice.
+  compareMatrix(tinyTools::matrix<int>{1, 3, {1, 2, 2}}.mean(Direction::ROWS), {5. / 3.});
+  compareMatrix(mat.any(Direction::COLUMNS), {true, true, true});
+  compareMatrix(mat.all(Direction::COLUMNS), {true, true, false});
+  compareMatrix(mat.all(Direction::ROWS), {true, false});
+
+  EXPECT_EQ(mat.sum(), 11);
+  EXPECT_EQ(mat.prod(), 0);
+  EXPECT_EQ(mat.min(), -2);
+  EXPECT_EQ(mat.max(), 5);
+  EXPECT_DOUBLE_EQ(mat.mean(), 11. / 6.);
+  EXPECT_TRUE(mat.any());
+  EXPECT_FALSE(mat.all());
+  EXPECT_ANY_THROW(static_cast<void>(mat.max(Direction::NONE)));
+
+  tinyTools::matrix<float> const matF{1, 3, {-1.F, -4.F, -2.F}};
+  EXPECT_EQ(matF.max(), -1.F);
+  EXPECT_EQ(matF.min(), -4.F);
+}
+
+TEST_F(TestMatrix, Reduce_bool)
+{
+  tinyTools::matrix<int> const matA{2, 2, {1, 5, 3, 4}};
+  tinyTools::matrix<int> const matB{2, 2, {2, 2, 4, 4}};
+  auto const less = matA < matB;
+
+  compareMatrix(less.any(tinyTools::Direction::COLUMNS), {true, false});
+  compareMatrix(less.all(tinyTools::Direction::ROWS), {false, false});
+  compareMatrix(less.all(tinyTools::Direction::COLUMNS), {true, false});
+  EXPECT_TRUE(less.any());
+  EXPECT_FALSE(less.all());
+}
+
+TEST_F(TestMatrix, Reduce_compensated)
+{
+  // Naive float accumulation of a million 0.1F drifts by about 1%, the compensated sums stay within a few ulps.
+  constexpr std::size_t count{1'000'000};
+  constexpr double exact{static_cast<double>(0.1F) * count};
+
+  tinyTools::matrix<float> const column{count, 2, 0.1F};
+  auto const sumC = column.sum(tinyTools::Direction::COLUMNS);
+  EXPECT_NEAR(sumC(0, 0), exact, exact * 1e-6);
+  EXPECT_NEAR(sumC(0, 1), exact, exact * 1e-6);
+
+  tinyTools::matrix<float> const row{2, count, 0.1F};
+  auto const sumR = row.sum(tinyTools::Direction::ROWS);
+  EXPECT_NEAR(sumR(0, 0), exact, exact * 1e-6);
+  EXPECT_NEAR(row.sum(), 2 * exact, exact * 1e-6);
+  EXPECT_NEAR(row.mean(), 0.1F, 1e-7);
+
+  // Integer means do not wrap in the element type.
+  tinyTools::matrix<char> const chars{1, 100, char{100}};
+  EXPECT_DOUBLE_EQ(chars.mean(), 100.);
+}
+
+TEST_F(TestMatrix, Reduce_strided_and_parallel)
+{
+  constexpr std::size_t rows{301};
+  constexpr std::size_t cols{517};
+  std::vector<double> data(rows * cols);
+  for(std::size_t i{}; i < data.size(); ++i)
+  {
+    data[ i ] = static_cast<double>((i * 7919) % 1009) / 7.;
+  }
+  tinyTools::matrix<double> const mat{rows, cols, data};
+
+  // The transposed view reads the same storage with swapped strides.
+  tinyTools::matrix_view<double const> const transposed{mat.ptr(), cols, rows, 1, cols};
+  auto const sumC = mat.sum(tinyTools::Direction::COLUMNS);
+  auto const sumTR = transposed.sum(tinyTools::Direction::ROWS);
+  auto const maxR = mat.max(tinyTools::Direction::ROWS);
+  auto const maxTC = transposed.max(tinyTools::Direction::COLUMNS);
+  for(std::size_t c{}; c < cols; ++c)
+  {
+    EXPECT_NEAR(sumC(0, c), sumTR(c, 0), 1e-9);
+  }
+  for(std::size_t r{}; r < rows; ++r)
+  {
+    EXPECT_EQ(maxR(r, 0), maxTC(0, r));
+  }
+  EXPECT_NEAR(mat.sum(), transposed.sum(), 1e-6);
+
+  auto run = [&]() { return std::tuple{mat.sum(tinyTools::Direction::COLUMNS), mat.min(tinyTools::Direction::ROWS), mat.sum(), transposed.sum()}; };
+  auto const [seqC, seqR, seqAll, seqT] = run();
+
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  auto const [parC, parR, parAll, parT] = run();
+  auto const [parC2, parR2, parAll2, parT2] = run();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+
+  compare2Matrixes(seqR, parR);
+  for(std::size_t c{}; c < cols; ++c)
+  {
+    EXPECT_NEAR(seqC(0, c), parC(0, c), 1e-9);
+  }
+  EXPECT_NEAR(seqAll, parAll, 1e-6);
+  EXPECT_NEAR(seqT, parT, 1e-6);
+
+  // Partials are combined in chunk order, parallel runs are reproducible.
+  compare2Matrixes(parC, parC2);
+  EXPECT_EQ(parAll, parAll2);
+  EXPECT_EQ(parT, parT2);
+}
+
+#endif /* REDUCTIONS_TEST_HPP */
@@ -0,0 +1,116 @@
+#ifndef SPARSE_TEST_HPP
+#define SPARSE_TEST_HPP
+
+#include "../include/sparse_matrix.hpp"
+#include "common.hpp"
+
+TEST_F(TestMatrix, Sparse_dense_round_trip)
+{
+  tinyTools::matrix<int> const dense{3, 4, {0, 2, 0, 0, 1, 0, 0, 3, 0, 0, 0, 0}};
+
+  tinyTools::sparse_matrix<int> const csr{dense};
+  EXPECT_EQ(csr.nonZeros(), 3);
+  compareVectors(std::vector<std::size_t>{csr.offsets().begin(), csr.offsets().end()}, {0, 1, 3, 3});
+  compareVectors(std::vector<std::uint32_t>{csr.indices().begin(), csr.indices().end()}, {1, 0, 3});
+  compareVectors(std::vector<int>{csr.values().begin(), csr.values().end()}, {2, 1, 3});
+  EXPECT_EQ(csr(1, 3), 3);
+  EXPECT_EQ(csr(2, 2), 0);
+  compare2Matrixes(csr.toMatrix(), dense);
+
+  tinyTools::sparse_matrix<int> const csc{dense, tinyTools::SparseFormat::CSC};
+  compareVectors(std::vector<std::size_t>{csc.offsets().begin(), csc.offsets().end()}, {0, 1, 2, 2, 3});
+  compare2Matrixes(csc.toMatrix(), dense);
+  EXPECT_TRUE(csc == csr);
+  EXPECT_TRUE(csr.convert(tinyTools::SparseFormat::CSC) == csc);
+  compare2Matrixes(csr.t().toMatrix(), tinyTools::matrix<int>{dense.t()});
+
+  EXPECT_THROW(tinyTools::sparse_matrix<int>(0, 3), std::length_error);
+  EXPECT_THROW((tinyTools::sparse_matrix<int>{2, 2, tinyTools::SparseFormat::CSR, {0, 2, 1}, {0, 1}, {1, 1}}), std::invalid_argument);
+  EXPECT_THROW((tinyTools::sparse_matrix<int>{2, 2, tinyTools::SparseFormat::CSR, {0, 2, 2}, {1, 0}, {1, 1}}), std::invalid_argument);
+}
+
+TEST_F(TestMatrix, Sparse_triplets)
+{
+  std::vector<tinyTools::sparse_entry<float>> const entries{{2, 1, 1.F}, {0, 0, 4.F}, {2, 1, 2.F}, {1, 2, 5.F}, {1, 2, -5.F}};
+  auto const mat = tinyTools::sparse_matrix<float>::fromTriplets(3, 3, entries);
+  EXPECT_EQ(mat.nonZeros(), 2); // Duplicates summed, the cancelled one dropped.
+  compareMatrix(mat.toMatrix(), {4.F, 0.F, 0.F, 0.F, 0.F, 0.F, 0.F, 3.F, 0.F});
+  EXPECT_TRUE(tinyTools::sparse_matrix<float>::fromTriplets(3, 3, entries, tinyTools::SparseFormat::CSC) == mat);
+
+  std::vector<tinyTools::sparse_entry<float>> const outside{{3, 0, 1.F}};
+  EXPECT_THROW(static_cast<void>(tinyTools::sparse_matrix<float>::fromTriplets(3, 3, outside)), std::out_of_range);
+}
+
+TEST_F(TestMatrix, Sparse_elementwise)
+{
+  tinyTools::matrix<int> const denseA{2, 3, {1, 0, 2, 0, 3, 0}};
+  tinyTools::matrix<int> const denseB{2, 3, {-1, 4, 0, 0, 2, 5}};
+  tinyTools::sparse_matrix<int> const matA{denseA};
+  tinyTools::sparse_matrix<int> const matB{denseB, tinyTools::SparseFormat::CSC};
+
+  auto const sum = matA + matB;
+  EXPECT_EQ(sum.nonZeros(), 4);
+  compareMatrix(sum.toMatrix(), {0, 4, 2, 0, 5, 5});
+  compareMatrix((matA - matB).toMatrix(), {2, -4, 2, 0, 1, -5});
+  compareMatrix(tinyTools::multiply(matA, matB).toMatrix(), {-1, 0, 0, 0, 6, 0});
+  compareMatrix((2 * matA).toMatrix(), {2, 0, 4, 0, 6, 0});
+  compareMatrix((-matA).toMatrix(), {-1, 0, -2, 0, -3, 0});
+
+  compareMatrix(matA + denseB, {0, 4, 2, 0, 5, 5});
+  compareMatrix(denseB - matA, {-2, 4, -2, 0, -1, 5});
+  compareMatrix(matA - denseB, {2, -4, 2, 0, 1, -5});
+
+  auto masked = matA;
+  masked.multiply(denseB);
+  EXPECT_EQ(masked.nonZeros(), 2);
+  compareMatrix(masked.toMatrix(), {-1, 0, 0, 0, 6, 0});
+
+  EXPECT_THROW(static_cast<void>(matA + tinyTools::sparse_matrix<int>{3, 2}), std::invalid_argument);
+}
+
+TEST_F(TestMatrix, Sparse_products)
+{
+  // Skewed rows (one dense row) so the nonzero-balanced split is uneven in rows.
+  std::size_t const m{400};
+  std::size_t const k{700};
+  std::vector<int> data(m * k, 0);
+  for(std::size_t i{}; i < data.size(); ++i)
+  {
+    data[ i ] = (i % 7 == 0 || i / k == 5) ? static_cast<int>(i % 11) - 5 : 0;
+  }
+  tinyTools::matrix<int> const dense{m, k, data};
+  tinyTools::sparse_matrix<int> const csr{dense};
+  tinyTools::sparse_matrix<int> const csc{dense, tinyTools::SparseFormat::CSC};
+  auto const rhs = tinyTools::matrix<int>::random(k, 130, 10);
+  auto const vec = tinyTools::matrix<int>::random(k, 1, 10);
+  auto const lhs = tinyTools::matrix<int>::random(20, m, 10);
+
+  auto const expected = dense * rhs;
+  auto const expectedVec = dense * vec;
+  auto const expectedLhs = lhs * dense;
+
+  auto check = [&]()
+  {
+    compare2Matrixes(csr * rhs, expected);
+    compare2Matrixes(csc * rhs, expected);
+    compare2Matrixes(csr * vec, expectedVec);
+    compare2Matrixes(csc * vec, expectedVec);
+    compare2Matrixes(lhs * csr, expectedLhs);
+    compare2Matrixes(lhs * csc, expectedLhs);
+
+    std::vector<int> y(m, 7);
+    csc.multiply(vec.span(), y);
+    compareMatrix(tinyTools::matrix<int>{m, 1, y}, expectedVec.data());
+  };
+
+  check();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  check();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+
+  EXPECT_THROW(static_cast<void>(csr * lhs), std::invalid_argument);
+}
+
+#endif /* SPARSE_TEST_HPP */
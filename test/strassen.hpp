@@ -0,0 +1,89 @@
+#ifndef STRASSEN_TEST_HPP
+#define STRASSEN_TEST_HPP
+
+#include "../include/random.hpp"
+#include "common.hpp"
+
+template <typename M> auto maxDifference(M const& lhm, M const& rhm) -> double
+{
+  double ret{};
+  for(std::size_t i{}; i < lhm.totalSize(); ++i)
+  {
+    ret = std::max(ret, std::abs(static_cast<double>(lhm.data()[ i ] - rhm.data()[ i ])));
+  }
+  return ret;
+}
+
+// Small cutoff so the tests recurse a few levels, odd shapes for the peeling.
+TEST_F(TestMatrix, Strassen_shapes)
+{
+  tinyTools::rng gen{13};
+  for(auto const& [ m, n, k ] : std::vector<std::array<std::size_t, 3>>{{64, 64, 64}, {67, 53, 71}, {131, 97, 200}, {33, 17, 40}})
+  {
+    auto const lhm = tinyTools::matrix<double>::randn(m, k, gen);
+    auto const rhm = tinyTools::matrix<double>::randn(k, n, gen);
+    auto const reference = lhm * rhm;
+
+    tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::STRASSEN);
+    tinyTools::setStrassenCutoff(16);
+    EXPECT_LT(maxDifference(lhm * rhm, reference), 1e-11);
+    EXPECT_LT(maxDifference(lhm * rhm.view(), reference), 1e-11);
+
+    // Column-major operands and the parallel top level.
+    tinyTools::matrix<double, std::allocator<double>, tinyTools::Layout::COL_MAJOR> const lhc{lhm.view()};
+    tinyTools::matrix<double, std::allocator<double>, tinyTools::Layout::COL_MAJOR> const rhc{rhm.view()};
+    tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+    tinyTools::setParallelThreshold(1);
+    tinyTools::setThreadCount(3);
+    EXPECT_LT(maxDifference(lhm * rhm, reference), 1e-11);
+    EXPECT_LT(maxDifference(tinyTools::matrix<double>{(lhc * rhc).view()}, reference), 1e-11);
+    tinyTools::setThreadCount(0);
+    tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+    tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+    tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::CLASSIC);
+  }
+}
+
+// View products take the same path as the matrix ones, bit for bit.
+TEST_F(TestMatrix, Strassen_views)
+{
+  tinyTools::rng gen{19};
+  auto const lhm = tinyTools::matrix<double>::randn(96, 80, gen);
+  auto const rhm = tinyTools::matrix<double>::randn(80, 72, gen);
+  auto const reference = lhm * rhm;
+
+  tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::STRASSEN);
+  tinyTools::setStrassenCutoff(16);
+  auto const strassen = lhm * rhm;
+  EXPECT_GT(maxDifference(strassen, reference), 0.);
+  compare2Matrixes(lhm.view() * rhm.view(), strassen);
+  compare2Matrixes(lhm.view() * rhm, strassen);
+  compare2Matrixes(lhm.view() * (rhm * 1.), strassen);
+  tinyTools::setStrassenCutoff(256);
+  tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::CLASSIC);
+}
+
+TEST_F(TestMatrix, Strassen_types)
+{
+  tinyTools::rng gen{17};
+  auto const lhm = tinyTools::matrix<float>::randn(150, 150, gen);
+  auto const reference = lhm * lhm;
+  tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::STRASSEN);
+  tinyTools::setStrassenCutoff(20);
+  EXPECT_LT(maxDifference(lhm * lhm, reference), 1e-3);
+
+  // Integers keep the classic product.
+  tinyTools::matrix<int> const ints{2, 2, {1, 2, 3, 4}};
+  compareMatrix(ints * ints, {7, 10, 15, 22});
+
+  // Below the cutoff the GEMM runs as is.
+  tinyTools::setStrassenCutoff(256);
+  EXPECT_EQ(tinyTools::strassenCutoff(), 256);
+  compare2Matrixes(lhm * lhm, reference);
+  tinyTools::setStrassenCutoff(1);
+  EXPECT_EQ(tinyTools::strassenCutoff(), 16);
+  tinyTools::setStrassenCutoff(256);
+  tinyTools::setMultiplyAlgorithm(tinyTools::MultiplyAlgorithm::CLASSIC);
+}
+
+#endif /* STRASSEN_TEST_HPP */
@@ -26,4 +26,71 @@ class TestMatrix : public ::testing::Test
 
 // -----------------------------------------------------------------------------------------------------------------------------------------------------
 // Methods.
-#include "methods.hpp"
\ No newline at end of file
+#include "methods.hpp"
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Views.
+#include "views.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Expressions.
+#include "expressions.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Fixed size.
+#include "fixed.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Allocators.
+#include "allocators.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Reductions.
+#include "reductions.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Transposes.
+#include "transpose.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Binary I/O.
+#include "binary_io.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Text I/O.
+#include "text_io.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Bit masks.
+#include "bit_mask.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Random numbers.
+#include "random.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Sparse matrices.
+#include "sparse.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Linear algebra.
+#include "linalg.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Storage order.
+#include "layout.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Asynchronous operations.
+#include "async.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Batched small matrices.
+#include "batch.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Strassen-Winograd products.
+#include "strassen.hpp"
+
+// -----------------------------------------------------------------------------------------------------------------------------------------------------
+// Instrumentation.
+#include "instrument.hpp"
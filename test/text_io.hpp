@@ -0,0 +1,135 @@
+#ifndef TEXT_IO_TEST_HPP
+#define TEXT_IO_TEST_HPP
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "../include/text_io.hpp"
+#include "common.hpp"
+
+TEST_F(TestMatrix, Text_ostream_format)
+{
+  // The buffered operator<< prints what the stream would print value by value.
+  tinyTools::matrix<double> const mat{2, 3, {1. / 3., -2.5, 1e-5, 123456789., 0., -0.125}};
+  std::ostringstream reference{};
+  for(std::size_t r{}; r < mat.rows(); ++r)
+  {
+    for(std::size_t c{}; c < mat.cols(); ++c)
+    {
+      reference << mat(r, c) << (c + 1 == mat.cols() ? '\n' : ' ');
+    }
+  }
+  std::ostringstream os{};
+  os << mat;
+  EXPECT_EQ(os.str(), reference.str());
+
+  reference.str("");
+  reference << std::fixed << std::setprecision(3);
+  os.str("");
+  os << std::fixed << std::setprecision(3) << mat;
+  for(std::size_t r{}; r < mat.rows(); ++r)
+  {
+    for(std::size_t c{}; c < mat.cols(); ++c)
+    {
+      reference << mat(r, c) << (c + 1 == mat.cols() ? '\n' : ' ');
+    }
+  }
+  EXPECT_EQ(os.str(), reference.str());
+
+  // Characters still print as characters.
+  tinyTools::matrix<char> const chars{1, 2, {'a', 'b'}};
+  os.str("");
+  os << chars;
+  EXPECT_EQ(os.str(), "a b\n");
+}
+
+TEST_F(TestMatrix, Text_round_trip)
+{
+  tinyTools::matrix<double> const mat{2, 3, {0.1, 1. / 3., -1e300, 5e-324, 42., -0.}};
+  std::stringstream ss{};
+  tinyTools::writeText(ss, mat);
+
+  auto const read = tinyTools::readText<double>(ss);
+  EXPECT_EQ(read.rows(), 2);
+  EXPECT_EQ(read.cols(), 3);
+  EXPECT_TRUE(read == mat);
+
+  tinyTools::matrix<std::int8_t> const small{1, 3, {-128, 0, 127}};
+  ss = std::stringstream{};
+  tinyTools::writeText(ss, small, ',');
+  EXPECT_EQ(ss.str(), "-128,0,127\n");
+  EXPECT_TRUE(tinyTools::readText<std::int8_t>(ss) == small);
+
+  tinyTools::matrix<bool> const mask{2, 2, {true, false, false, true}};
+  ss = std::stringstream{};
+  tinyTools::writeText(ss, mask);
+  EXPECT_EQ(ss.str(), "1 0\n0 1\n");
+  EXPECT_TRUE(tinyTools::readText<bool>(ss) == mask);
+}
+
+TEST_F(TestMatrix, Text_parse_csv)
+{
+  std::istringstream is{"1.5, +2,-3e2\r\n\n  4;5\t6 \n7,8,9"};
+  auto const mat = tinyTools::readText<float>(is);
+  compareMatrix(mat, {1.5F, 2.F, -300.F, 4.F, 5.F, 6.F, 7.F, 8.F, 9.F});
+
+  std::istringstream special{"inf -inf nan"};
+  auto const values = tinyTools::readText<double>(special);
+  EXPECT_TRUE(std::isinf(values(0, 0)) && values(0, 0) > 0.);
+  EXPECT_TRUE(std::isinf(values(0, 1)) && values(0, 1) < 0.);
+  EXPECT_TRUE(std::isnan(values(0, 2)));
+}
+
+TEST_F(TestMatrix, Text_parse_errors)
+{
+  std::istringstream ragged{"1 2\n3\n"};
+  EXPECT_THROW((void)tinyTools::readText<int>(ragged), std::invalid_argument);
+
+  std::istringstream garbage{"1 x2\n"};
+  EXPECT_THROW((void)tinyTools::readText<int>(garbage), std::invalid_argument);
+
+  std::istringstream tooBig{"300\n"};
+  EXPECT_THROW((void)tinyTools::readText<std::uint8_t>(tooBig), std::out_of_range);
+
+  std::istringstream negative{"-1\n"};
+  EXPECT_THROW((void)tinyTools::readText<unsigned>(negative), std::invalid_argument);
+
+  std::istringstream empty{"\n \n"};
+  EXPECT_THROW((void)tinyTools::readText<int>(empty), std::invalid_argument);
+}
+
+TEST_F(TestMatrix, Text_row_blocks)
+{
+  // More rows than the read buffer holds, in blocks of 1000 rows.
+  std::size_t const rows{20000};
+  std::size_t const cols{7};
+  std::vector<int> data(rows * cols);
+  for(std::size_t i{}; i < data.size(); ++i)
+  {
+    data[ i ] = static_cast<int>(i) - 1000;
+  }
+  tinyTools::matrix<int> const mat{rows, cols, std::move(data)};
+
+  std::stringstream ss{};
+  for(std::size_t r{}; r < rows; r += 5000)
+  {
+    tinyTools::writeText(ss, mat(r, 0, 5000, cols));
+  }
+  ASSERT_GT(ss.str().size(), 2 * tinyTools::detail::textBufferSize);
+
+  tinyTools::text_reader<int> reader{ss};
+  std::size_t row{};
+  while(auto const block = reader.next(1000))
+  {
+    EXPECT_EQ(block->rows(), 1000);
+    EXPECT_EQ(block->cols(), cols);
+    EXPECT_TRUE(tinyTools::matrix<int>{mat(row, 0, 1000, cols)} == *block);
+    row += block->rows();
+  }
+  EXPECT_EQ(row, rows);
+  EXPECT_EQ(reader.rowsRead(), rows);
+  EXPECT_FALSE(reader.next(1000));
+}
+
+#endif /* TEXT_IO_TEST_HPP */
@@ -0,0 +1,110 @@
+#ifndef TRANSPOSE_TEST_HPP
+#define TRANSPOSE_TEST_HPP
+
+#include "../include/fixed_matrix.hpp"
+#include "common.hpp"
+
+template <typename T> auto makeSequence(std::size_t rows, std::size_t cols) -> tinyTools::matrix<T>
+{
+  std::vector<T> data(rows * cols);
+  for(std::size_t i{}; i < data.size(); ++i)
+  {
+    data[ i ] = static_cast<T>(i);
+  }
+  return tinyTools::matrix<T>{rows, cols, std::move(data)};
+}
+
+template <typename T> auto isTransposeOf(tinyTools::matrix<T> const& lhm, tinyTools::matrix<T> const& rhm) -> bool
+{
+  if(lhm.rows() != rhm.cols() || lhm.cols() != rhm.rows())
+  {
+    return false;
+  }
+  for(std::size_t r{}; r < rhm.rows(); ++r)
+  {
+    for(std::size_t c{}; c < rhm.cols(); ++c)
+    {
+      if(lhm(c, r) != rhm(r, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TEST_F(TestMatrix, Transpose_view)
+{
+  tinyTools::matrix<int> mat{2, 3, {1, 2, 3, 4, 5, 6}};
+  auto const matT = mat.t();
+
+  EXPECT_EQ(matT.rows(), 3);
+  EXPECT_EQ(matT.cols(), 2);
+  EXPECT_EQ(matT.ptr(), mat.ptr());
+  compareVectors(matT.data(), {1, 4, 2, 5, 3, 6});
+  EXPECT_TRUE(matT.t() == mat.view());
+
+  // The lazy view feeds the GEMM directly.
+  compareMatrix(mat * mat.t(), {14, 32, 32, 77});
+  compareMatrix(mat.t() * mat, {17, 22, 27, 22, 29, 36, 27, 36, 45});
+
+  // Writes go through to the storage.
+  mat.t()(2, 0) = 30;
+  EXPECT_EQ(mat(0, 2), 30);
+
+  // Element-wise expressions read it strided.
+  tinyTools::matrix<int> const square{2, 2, {1, 2, 3, 4}};
+  tinyTools::matrix<int> const sum = square + square.t();
+  compareMatrix(sum, {2, 5, 5, 8});
+}
+
+TEST_F(TestMatrix, Transpose_copy)
+{
+  for(auto const &[rows, cols] : {std::pair<std::size_t, std::size_t>{1, 1}, {1, 7}, {7, 1}, {31, 33}, {64, 64}, {100, 37}})
+  {
+    auto const mat = makeSequence<float>(rows, cols);
+    EXPECT_TRUE(isTransposeOf(mat.transpose(), mat));
+    EXPECT_TRUE(isTransposeOf(tinyTools::matrix<float>{mat.t()}, mat));
+    compare2Matrixes(mat.transpose().transpose(), mat);
+  }
+
+  auto const mat = makeSequence<double>(301, 129);
+  auto const seq = mat.transpose();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  auto const par = mat.transpose();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+  compare2Matrixes(seq, par);
+}
+
+TEST_F(TestMatrix, Transpose_inplace)
+{
+  for(auto const &[rows, cols] : {std::pair<std::size_t, std::size_t>{1, 5}, {5, 1}, {2, 3}, {3, 2}, {33, 33}, {70, 70}, {17, 64}, {100, 3}})
+  {
+    auto const original = makeSequence<int>(rows, cols);
+    auto mat = original;
+    mat.transposeInPlace();
+    EXPECT_EQ(mat.rows(), cols);
+    EXPECT_EQ(mat.cols(), rows);
+    EXPECT_TRUE(isTransposeOf(mat, original));
+  }
+
+  auto const original = makeSequence<int>(130, 130);
+  auto mat = original;
+  tinyTools::setExecutionPolicy(tinyTools::Execution::PARALLEL);
+  tinyTools::setParallelThreshold(1);
+  mat.transposeInPlace();
+  tinyTools::setExecutionPolicy(tinyTools::Execution::SEQUENTIAL);
+  tinyTools::setParallelThreshold(std::size_t{1} << 16U);
+  EXPECT_TRUE(isTransposeOf(mat, original));
+}
+
+TEST_F(TestMatrix, Transpose_fixed)
+{
+  constexpr tinyTools::fixed_matrix<int, 2, 3> mat{1, 2, 3, 4, 5, 6};
+  static_assert(mat.transpose() == tinyTools::fixed_matrix<int, 3, 2>{1, 4, 2, 5, 3, 6});
+  static_assert(mat.transpose().transpose() == mat);
+}
+
+#endif /* TRANSPOSE_TEST_HPP */
@@ -0,0 +1,126 @@
+#ifndef VIEWS_TEST_HPP
+#define VIEWS_TEST_HPP
+
+#include <algorithm>
+#include <sstream>
+
+#include "common.hpp"
+TEST_F(TestMatrix, View_submatrix_no_copy)
+{
+  tinyTools::matrix<int> mat{3, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8}};
+
+  auto sub = mat(1, 1, 2, 2);
+  EXPECT_EQ(sub.ptr(), &mat(1, 1));
+  EXPECT_EQ(sub.rowStride(), 3);
+  EXPECT_FALSE(sub.isContiguous());
+
+  sub(0, 0) = 40;
+  EXPECT_EQ(mat(1, 1), 40);
+  compareVectors(sub.data(), {40, 5, 7, 8});
+}
+
+TEST_F(TestMatrix, View_getRow_getCol)
+{
+  tinyTools::matrix<int> const mat{2, 3, {1, 2, 3, 4, 5, 6}};
+
+  auto const col = mat.getCol(2);
+  EXPECT_EQ(col.rows(), 2);
+  EXPECT_EQ(col.cols(), 1);
+  EXPECT_EQ(col[ 1 ], 6);
+
+  auto const row = mat.getRow(1);
+  EXPECT_TRUE(row.isContiguous());
+  compareVectors(row.data(), {4, 5, 6});
+
+  // Views of views.
+  compareVectors(mat(0, 1, 2, 2).getCol(1).data(), {3, 6});
+
+  EXPECT_ANY_THROW(static_cast<void>(mat.getRow(2)));
+  EXPECT_ANY_THROW(static_cast<void>(col(2, 0)));
+}
+
+TEST_F(TestMatrix, View_iterators_spans)
+{
+  tinyTools::matrix<int> mat{3, 4, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}};
+
+  auto const sub = mat(1, 1, 2, 2);
+  EXPECT_TRUE(std::ranges::equal(sub, std::vector<int>{6, 7, 10, 11}));
+  EXPECT_TRUE(std::ranges::equal(mat.getCol(3), std::vector<int>{4, 8, 12}));
+  EXPECT_EQ(sub.ld(), 4);
+  EXPECT_EQ(sub.ptr()[sub.ld() + 1], 11);
+
+  auto const row = sub.rowSpan(1);
+  EXPECT_EQ(row.size(), 2);
+  EXPECT_EQ(row.data(), &mat(2, 1));
+  tinyTools::matrix_view<int> const transposed{mat.ptr(), 4, 3, 1, 4};
+  EXPECT_TRUE(std::ranges::equal(transposed.getRow(1), std::vector<int>{2, 6, 10}));
+  EXPECT_ANY_THROW(static_cast<void>(transposed.rowSpan(0)));
+  EXPECT_ANY_THROW(static_cast<void>(sub.rowSpan(2)));
+
+  EXPECT_EQ(mat.getRow(2).span().data(), &mat(2, 0));
+  EXPECT_EQ(mat.view().span().size(), 12);
+  EXPECT_ANY_THROW(static_cast<void>(sub.span()));
+
+  for(auto &v : mat.getCol(0))
+  {
+    v = 0;
+  }
+  EXPECT_TRUE(std::ranges::equal(mat.getCol(0), std::vector<int>{0, 0, 0}));
+  static_assert(std::forward_iterator<tinyTools::matrix_view<int>::iterator>);
+}
+
+TEST_F(TestMatrix, View_to_matrix)
+{
+  tinyTools::matrix<int> const mat{3, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8}};
+  tinyTools::matrix<int> const col = mat.getCol(1);
+  compareMatrix(col, {1, 4, 7});
+
+  tinyTools::matrix<int> const sub = mat(0, 1, 2, 2);
+  compareMatrix(sub, {1, 2, 4, 5});
+}
+
+TEST_F(TestMatrix, View_arithmetic)
+{
+  tinyTools::matrix<int> const mat{3, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8}};
+
+  tinyTools::matrix<int> acc{2, 2, 1};
+  acc += mat(1, 1, 2, 2);
+  compareMatrix(acc, {5, 6, 8, 9});
+
+  acc -= mat(0, 0, 2, 2);
+  compareMatrix(acc, {5, 5, 5, 5});
+
+  acc.multiply(mat(0, 1, 2, 2));
+  compareMatrix(acc, {5, 10, 20, 25});
+
+  compareMatrix(tinyTools::eval(acc + mat(0, 0, 2, 2)), {5, 11, 23, 29});
+  EXPECT_ANY_THROW(acc += mat.getRow(0));
+
+  // Product of strided views: first two cols times the last col.
+  auto const product = mat(0, 0, 3, 2) * mat(0, 2, 2, 1);
+  compareMatrix(product, {5, 26, 47});
+}
+
+TEST_F(TestMatrix, View_sum)
+{
+  tinyTools::matrix<int> const mat{3, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8}};
+  auto const sub = mat(1, 1, 2, 2);
+
+  compareMatrix(sub.sum(tinyTools::Direction::COLUMNS), {11, 13});
+  compareMatrix(sub.sum(tinyTools::Direction::ROWS), {9, 15});
+}
+
+TEST_F(TestMatrix, View_ostream)
+{
+  tinyTools::matrix<int> const mat{3, 3, {0, 1, 2, 3, 4, 5, 6, 7, 8}};
+
+  std::ostringstream os{};
+  os << mat.getCol(2);
+  EXPECT_EQ(os.str(), "2\n5\n8\n");
+
+  os.str("");
+  os << mat;
+  EXPECT_EQ(os.str(), "0 1 2\n3 4 5\n6 7 8\n");
+}
+
+#endif /* VIEWS_TEST_HPP */